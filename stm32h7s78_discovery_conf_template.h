@@ -43,6 +43,38 @@ extern "C" {
 /* LCD defines */
 #define LCD_LAYER_0_ADDRESS                 0x90000000U
 #define LCD_LAYER_1_ADDRESS                 0x90200000U
+#define USE_BSP_LCD_DMA2D_ASYNC             0U
+#define LCD_DMA2D_QUEUE_SIZE                16U
+#define USE_BSP_LCD_CPU_RENDERING           0U
+#define USE_BSP_LCD_DMA2D_ROTATION          0U
+#define LCD_FB_MAX_BUFFERS                  3U
+#define LCD_FRAME_BUFFER_SIZE               0x200000U
+#define LCD_DIRTY_RECTS_NBR                 8U
+#define USE_BSP_LCD_RLE                     0U
+#define LCD_RLE_MAX_WIDTH                   800U
+#define LCD_RLE_LINE_BUFFERS                2U
+#define USE_BSP_LCD_TEXT_CACHE              0U
+#define LCD_TEXT_CACHE_NBR                  4U
+#define LCD_TEXT_RUN_SIZE                   4096U
+#define USE_BSP_LCD_STATS                   0U
+
+/* XSPI NOR erase suspend defines */
+#define BSP_XSPI_NOR_ERASE_SUSPEND_MAX      8U
+#define BSP_XSPI_NOR_ERASE_RESUME_TIME      1U
+
+/* XSPI NOR read cache defines */
+#define USE_BSP_XSPI_NOR_READ_CACHE         0U
+#define BSP_XSPI_NOR_READ_CACHE_LINE_SIZE   256U
+#define BSP_XSPI_NOR_READ_CACHE_LINES       4U
+
+/* XSPI NOR DMA defines */
+#define USE_BSP_XSPI_NOR_DMA                0U
+
+/* XSPI NOR FTL defines */
+#define BSP_XSPI_FTL_ADDRESS                0x07F00000U
+#define BSP_XSPI_FTL_SIZE                   0x00100000U
+#define BSP_XSPI_FTL_MAX_KEYS               256U
+#define BSP_XSPI_FTL_GC_FREE_SECTORS        4U
 
 /* Default Audio IN internal buffer size */
 #define DEFAULT_AUDIO_IN_BUFFER_SIZE        2048U
@@ -58,6 +90,10 @@ extern "C" {
 #define BSP_TS_IT_PRIORITY                  15U
 #define BSP_XSPI_RAM_IT_PRIORITY            15U
 #define BSP_XSPI_RAM_DMA_IT_PRIORITY        15U
+#define BSP_XSPI_NOR_IT_PRIORITY            15U
+#define BSP_XSPI_NOR_DMA_IT_PRIORITY        15U
+#define BSP_LCD_DMA2D_IT_PRIORITY           15U
+#define BSP_LCD_LTDC_IT_PRIORITY            15U
 
 #ifdef __cplusplus
 }
@@ -45,6 +45,8 @@ extern "C" {
 #define BSP_ERROR_XSPI_SETUP_FAILURE      -25
 #define BSP_ERROR_XSPI_MMP_LOCK_FAILURE   -26
 #define BSP_ERROR_XSPI_MMP_UNLOCK_FAILURE -27
+#define BSP_ERROR_XSPI_FTL_FULL           -28
+#define BSP_ERROR_XSPI_FTL_NOT_FOUND      -29
 
 /* BSP TS error code */
 #define BSP_ERROR_TS_TOUCH_NOT_DETECTED   -30
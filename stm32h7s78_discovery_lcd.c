@@ -49,7 +49,8 @@
 
    + Options
      o Configure the LTDC reload mode by calling BSP_LCD_Reload(). By default, the
-       reload mode is set to BSP_LCD_RELOAD_IMMEDIATE then LTDC is reloaded immediately.
+       reload mode is set to BSP_LCD_RELOAD_IMMEDIATE then LTDC is reloaded immediately,
+       or at the next vertical blanking while a BSP_LCD_SwapBuffers() flip is pending.
        To control the reload mode:
          - Call BSP_LCD_Reload() with ReloadType parameter set to BSP_LCD_RELOAD_NONE
          - Configure LTDC (color keying, transparency ..)
@@ -58,6 +59,13 @@
            in the next vertical blanking
      o Configure LTDC layers using BSP_LCD_ConfigLayer()
      o Control layer visibility using BSP_LCD_SetLayerVisible()
+     o Sprite overlay: BSP_LCD_ConfigSprite() parks a small image (cursor, drag
+       feedback) in the LCD_SPRITE_LAYER layer without copying it.
+       BSP_LCD_MoveSprite(), BSP_LCD_ShowSprite() and BSP_LCD_HideSprite() only
+       reprogram the layer window and start address, applied at the next
+       vertical blanking, so moving the sprite writes no frame buffer pixel.
+       Positions are in panel coordinates, the hot spot may go off screen.
+       The layer must not be used for drawing or by the frame buffer manager.
      o Configure and enable the color keying functionality using the
        BSP_LCD_SetColorKeying() function.
      o Disable the color keying functionality using the BSP_LCD_ResetColorKeying() function.
@@ -65,6 +73,96 @@
        using the following functions:
        - BSP_LCD_SetTransparency()
        - BSP_LCD_SetLayerAddress()
+     o CPU rendering: when USE_BSP_LCD_CPU_RENDERING is set to 1, the draw APIs
+       do not use DMA2D, their transfers are executed by the CPU with line
+       oriented fill, copy and color conversion kernels. This is useful when
+       DMA2D is owned by another client. When USE_DMA2D_TO_FILL_RGB_RECT is 0,
+       BSP_LCD_FillRGBRect() uses the same CPU copy kernel.
+     o Asynchronous DMA2D operations: when USE_BSP_LCD_DMA2D_ASYNC is set to 1,
+       BSP_LCD_DrawBitmap(), BSP_LCD_FillRGBRect(), BSP_LCD_DrawHLine(),
+       BSP_LCD_DrawVLine() and BSP_LCD_FillRect() only queue DMA2D jobs and return.
+       The queue is drained from the DMA2D transfer complete interrupt, so
+       BSP_LCD_DMA2D_IRQHandler() must be called from DMA2D_IRQHandler().
+       - BSP_LCD_GetFence() returns a fence for the last queued job
+       - BSP_LCD_WaitFence() waits until the jobs up to a fence are completed
+       Source buffers passed to the draw APIs must stay valid until their fence
+       is reached. BSP_LCD_ReadPixel() and BSP_LCD_WritePixel() wait for the
+       queue to be drained before accessing the frame buffer.
+     o Blending: BSP_LCD_BlendRGBRect() blends ARGB8888, RGB888, RGB565 or L8
+       pixels over the active layer with a constant alpha combined with the
+       per-pixel alpha. BSP_LCD_DrawAlphaBitmap() blends a color through an A8
+       or A4 mask (anti-aliased glyphs, icons). Both use DMA2D M2M_BLEND with
+       the frame buffer as background. L8 pixels use the CLUT loaded by
+       BSP_LCD_SetCLUT(). The blended rectangle must fit in the display.
+     o Fast pixel access: BSP_LCD_ReadPixelFast() and BSP_LCD_WritePixelFast()
+       are inline, bounds checked accessors using the draw address and stride
+       cached in Lcd_Ctx. The address is only cached in landscape orientation,
+       for 16-bit and 32-bit layers, while no DMA2D job is in flight and when
+       the active layer is not driven by the frame buffer manager. It is
+       refreshed by the draw APIs and dropped when a DMA2D job is queued or
+       the layer, its address or its window change, the accessors then fall
+       back to BSP_LCD_ReadPixel()/BSP_LCD_WritePixel(), which wait for the
+       DMA2D queue and update the dirty rectangles.
+       BSP_LCD_ReadSpan() and BSP_LCD_WriteSpan() transfer a line of pixels
+       in one call.
+     o Frame buffer manager: BSP_LCD_ConfigFrameBuffers() sets 2 or 3 frame
+       buffers on a layer, extra buffers are taken in PSRAM from
+       LCD_FRAME_BUFFER_POOL_ADDRESS. The draw APIs render into the back buffer
+       (BSP_LCD_GetBackBuffer()) and BSP_LCD_SwapBuffers() displays it at the next
+       vertical blanking without waiting for it. BSP_LCD_FrameCompleteCallback()
+       is called from the LTDC reload interrupt once the flip is done, so
+       BSP_LCD_LTDC_IRQHandler() must be called from LTDC_IRQHandler(). When
+       USE_HAL_LTDC_REGISTER_CALLBACKS is set to 0, the application
+       HAL_LTDC_ReloadEventCallback() must call BSP_LCD_ReloadEventCallback().
+       With 2 buffers, drawing after a swap waits for the pending flip, the
+       draw APIs return BSP_ERROR_BUSY if it is not done within
+       LCD_FB_SWAP_TIMEOUT.
+       The areas written by the draw APIs are tracked as dirty rectangles
+       (LCD_DIRTY_RECTS_NBR per buffer, overlapping ones are merged). Before the
+       first draw after a swap, only the areas the new back buffer lacks are
+       copied from the last displayed frame. Areas written directly in the
+       back buffer must be declared with BSP_LCD_InvalidateRect().
+     o Statistics: when USE_BSP_LCD_STATS is set to 1, the draw APIs, layer
+       reloads and buffer swaps record their latency in DWT cycles with a log2
+       histogram per primitive. BSP_LCD_ResetStats() starts the measurement,
+       BSP_LCD_GetStats() returns counts, cycles and pixels (for megapixels/s)
+       and BSP_LCD_GetLatencyPercentile() returns p50/p90/p99 estimates.
+     o Text: BSP_LCD_SetFont() selects a BSP_LCD_Font_t, an A8 glyph atlas
+       typically kept in memory-mapped XSPI NOR. BSP_LCD_DrawString() blends
+       the glyphs one by one from the atlas, clipped to the display. When
+       USE_BSP_LCD_TEXT_CACHE is set to 1, the string glyphs are composed in an
+       A8 glyph run blended by one DMA2D job, the LCD_TEXT_CACHE_NBR most
+       recently drawn strings are kept in internal SRAM (LCD_TEXT_RUN_SIZE
+       bytes each) and are blended again without reading the atlas.
+     o Compressed images: when USE_BSP_LCD_RLE is set to 1,
+       BSP_LCD_DrawRLEBitmap() draws RLE images (format described with
+       BSP_LCD_RLE_MAGIC), typically stored in XSPI NOR flash. Lines are
+       decoded in a ring of LCD_RLE_LINE_BUFFERS line buffers of
+       LCD_RLE_MAX_WIDTH 32-bit pixels and converted by DMA2D PFC, so the flash
+       is read once in compressed form. The line buffers must be in a DMA2D
+       accessible memory.
+     o Pixel formats: BSP_LCD_InitEx() accepts LCD_PIXEL_FORMAT_RGB565,
+       LCD_PIXEL_FORMAT_RGB888 (ARGB8888 layer), LCD_PIXEL_FORMAT_RGB888_PACKED
+       (3 bytes per pixel), LCD_PIXEL_FORMAT_ARGB4444, LCD_PIXEL_FORMAT_L8 and
+       LCD_PIXEL_FORMAT_AL44. Colors passed to the draw APIs are in the layer
+       pixel format (CLUT index for L8 and AL44 layers, whose CLUT is loaded
+       with BSP_LCD_SetLayerCLUT()). DMA2D cannot write 8-bit pixels: fills,
+       copies and buffer syncs of L8 and AL44 layers are executed by the CPU
+       with word stores, and BSP_LCD_DrawBitmap(), BSP_LCD_BlendRGBRect() and
+       BSP_LCD_DrawAlphaBitmap() return BSP_ERROR_FEATURE_NOT_SUPPORTED.
+     o Orientation: BSP_LCD_InitEx() accepts LCD_ORIENTATION_PORTRAIT,
+       LCD_ORIENTATION_PORTRAIT_ROT180 and LCD_ORIENTATION_LANDSCAPE_ROT180 in
+       addition to LCD_ORIENTATION_LANDSCAPE. Width and Height stay the panel
+       sizes, the draw APIs take coordinates in the selected orientation and
+       BSP_LCD_GetXSize()/BSP_LCD_GetYSize() return the rotated sizes. Fills are
+       transformed and remain DMA2D fills. Images are rotated by the CPU in
+       32x32 tiles. When USE_BSP_LCD_DMA2D_ROTATION is set to 1, the CPU only
+       rotates 16x16 tiles in the source format in 2 internal tile buffers
+       (2 KB), each tile being converted or blended in the panel by one DMA2D
+       transfer (A4 masks are still rotated by the CPU). Rotated rectangles must fit in the
+       display, BSP_ERROR_WRONG_PARAM is returned otherwise. The fast pixel
+       accessors fall back to BSP_LCD_ReadPixel()/BSP_LCD_WritePixel() in the
+       rotated orientations.
 
    + Display on LCD
      o To draw and fill a basic shapes (dot, line, rectangle, circle, ellipse, .. bitmap)
@@ -98,19 +196,169 @@
   * @{
   */
 
-/** @defgroup STM32H7S78_DK_LCD_Private_Variables STM32H7S78_DK LCD Private Variables
+/** @defgroup STM32H7S78_DK_LCD_Private_TypesDefinitions STM32H7S78_DK LCD Private TypesDefinitions
   * @{
   */
+/* DMA2D job descriptor */
+typedef struct
+{
+  uint32_t Mode;            /* DMA2D_R2M, DMA2D_M2M, DMA2D_M2M_PFC or
+                               DMA2D_M2M_BLEND (background is Dst)         */
+  uint32_t OutputColorMode; /* DMA2D output color mode                     */
+  uint32_t OutputOffset;    /* Output line offset in pixels                */
+  uint32_t InputColorMode;  /* Foreground color mode (not DMA2D_R2M)       */
+  uint32_t InputOffset;     /* Foreground line offset in pixels            */
+  uint32_t AlphaMode;       /* Foreground alpha mode                       */
+  uint32_t InputAlpha;      /* Foreground alpha, with color for A4 and A8  */
+  uint32_t Src;             /* Color (DMA2D_R2M) or source address         */
+  uint32_t Dst;             /* Destination address                         */
+  uint32_t Width;           /* Transfer width in pixels                    */
+  uint32_t Height;          /* Transfer height in lines                    */
+  int32_t  SrcPitch;        /* When not 0, lines are transferred one by one
+                               and Src moves by SrcPitch bytes per line    */
+  uint32_t DstPitch;        /* Dst step in bytes per line (line by line)   */
+} LCD_DMA2D_Job_t;
+
+/* DMA2D shadow configuration: hlcd_dma2d.Init and hlcd_dma2d.LayerCfg[]
+   hold the last programmed values, the flags tell which ones are in the
+   registers */
+#define LCD_DMA2D_CONFIG_OUTPUT   0x01U  /* Mode, output color mode and offset */
+#define LCD_DMA2D_CONFIG_FG       0x02U  /* Foreground color mode and offset   */
+#define LCD_DMA2D_CONFIG_BG       0x04U  /* Background color mode and offset   */
+
+/* Tile size of the CPU rotation, in pixels */
+#define LCD_ROTATION_TILE_SIZE    32U
+
+/* Tiles of the DMA2D rotation, rotated by the CPU while DMA2D transfers the
+   previous ones */
+#define LCD_ROTATION_DMA2D_TILE     16U
+#define LCD_ROTATION_DMA2D_BUFFERS  2U
+
+/* Output color mode of the 8-bit layers (L8, AL44): DMA2D cannot write them,
+   their jobs are executed by the CPU kernels */
+#define LCD_OUTPUT_8BPP           0x100U
+
+/* Input color mode without layer equivalent */
+#define LCD_OUTPUT_NONE           0xFFFFFFFFU
+
+#if (USE_BSP_LCD_DMA2D_ASYNC == 1) && (USE_BSP_LCD_CPU_RENDERING == 1)
+#error "USE_BSP_LCD_DMA2D_ASYNC and USE_BSP_LCD_CPU_RENDERING cannot be both enabled"
+#endif /* USE_BSP_LCD_DMA2D_ASYNC && USE_BSP_LCD_CPU_RENDERING */
+
+#if (USE_BSP_LCD_DMA2D_ROTATION == 1) && (USE_BSP_LCD_CPU_RENDERING == 1)
+#error "USE_BSP_LCD_DMA2D_ROTATION and USE_BSP_LCD_CPU_RENDERING cannot be both enabled"
+#endif /* USE_BSP_LCD_DMA2D_ROTATION && USE_BSP_LCD_CPU_RENDERING */
+
+#if (USE_BSP_LCD_DMA2D_ASYNC == 1)
+#if ((LCD_DMA2D_QUEUE_SIZE & (LCD_DMA2D_QUEUE_SIZE - 1U)) != 0U)
+#error "LCD_DMA2D_QUEUE_SIZE must be a power of 2"
+#endif /* LCD_DMA2D_QUEUE_SIZE */
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
+
+/* Dirty rectangle, X1 and Y1 are excluded */
+typedef struct
+{
+  uint32_t X0;
+  uint32_t Y0;
+  uint32_t X1;
+  uint32_t Y1;
+} LCD_Rect_t;
+
+/* Frame buffer manager context */
+typedef struct
+{
+  uint32_t LayerIndex;                       /* Layer using the frame buffers        */
+  uint32_t NbBuffers;                        /* 0 when frame buffer manager unused   */
+  uint32_t Address[LCD_FB_MAX_BUFFERS];      /* Frame buffer addresses               */
+  uint32_t FrontIndex;                       /* Buffer scanned out by LTDC           */
+  uint32_t BackIndex;                        /* Buffer written by the draw APIs      */
+  volatile uint32_t PendingIndex;            /* Buffer waiting for vertical blanking */
+  uint32_t SyncIndex;                        /* Buffer holding the last frame, to be
+                                                copied in the back buffer            */
+  LCD_Rect_t Dirty[LCD_FB_MAX_BUFFERS][LCD_DIRTY_RECTS_NBR]; /* Areas a buffer lacks */
+  uint32_t DirtyNbr[LCD_FB_MAX_BUFFERS];
+} LCD_FB_Ctx_t;
+
+#define LCD_FB_NONE                          0xFFFFFFFFU
+
+#if (USE_BSP_LCD_TEXT_CACHE == 1)
+/* A8 glyph run: a string composed once, blended by a single DMA2D job */
+typedef struct
+{
+  uint8_t  Run[LCD_TEXT_RUN_SIZE];           /* A8 pixels, read by DMA2D            */
+  const BSP_LCD_Font_t *pFont;               /* NULL when the entry is free         */
+  char     Text[LCD_TEXT_MAX_LENGTH];        /* Composed string, not NUL terminated */
+  uint32_t Length;
+  uint32_t Width;
+  uint32_t Height;
+  uint32_t LastUse;                          /* LRU stamp                           */
+  uint32_t Fence;                            /* Last DMA2D job reading the run      */
+} LCD_TextRun_t;
+#endif /* USE_BSP_LCD_TEXT_CACHE */
+
+/* Sprite overlay context */
+typedef struct
+{
+  BSP_LCD_Sprite_t Sprite;                   /* pImage is NULL when not configured */
+  uint32_t Bpp;                              /* Sprite bytes per pixel             */
+  int32_t  Xpos;                             /* Hot spot position, panel coordinates */
+  int32_t  Ypos;
+  uint32_t Shown;
+} LCD_Sprite_Ctx_t;
+
 /**
   * @}
   */
 
-/** @defgroup STM32H7S78_DK_LCD_Private_TypesDefinitions STM32H7S78_DK LCD Private TypesDefinitions
+/** @defgroup STM32H7S78_DK_LCD_Private_Variables STM32H7S78_DK LCD Private Variables
   * @{
   */
 /* LPTimer handler declaration */
 static LPTIM_HandleTypeDef hlcd_lptim;
 static LPTIM_OC_ConfigTypeDef  hlcd_lptim_config = {0};
+
+/* DMA2D shadow configuration flags (LCD_DMA2D_CONFIG_xxx) */
+static uint32_t Lcd_Dma2dConfig;
+
+/* DMA2D fences: number of submitted and completed jobs */
+static volatile uint32_t Lcd_Dma2dSubmitted;
+static volatile uint32_t Lcd_Dma2dCompleted;
+
+/* Foreground CLUT used by the CPU to convert L8 pixels */
+static const uint32_t *Lcd_Clut;
+
+#if (USE_BSP_LCD_DMA2D_ASYNC == 1)
+/* DMA2D command queue: filled by the draw APIs, drained by the DMA2D interrupt */
+static LCD_DMA2D_Job_t   Lcd_Dma2dQueue[LCD_DMA2D_QUEUE_SIZE];
+static volatile uint32_t Lcd_Dma2dHead;
+static volatile uint32_t Lcd_Dma2dTail;
+static volatile uint32_t Lcd_Dma2dRunning;
+static volatile uint32_t Lcd_Dma2dLine;
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
+
+static LCD_FB_Ctx_t Lcd_Fb[LCD_INSTANCES_NBR];
+
+#if (USE_BSP_LCD_RLE == 1)
+/* RLE decoded lines, read by DMA2D: must be in a DMA2D accessible memory */
+static uint8_t Lcd_RleLines[LCD_RLE_LINE_BUFFERS][4U * LCD_RLE_MAX_WIDTH] __ALIGNED(32);
+#endif /* USE_BSP_LCD_RLE */
+
+#if (USE_BSP_LCD_DMA2D_ROTATION == 1)
+/* Rotated tiles, read by DMA2D: must be in a DMA2D accessible memory */
+static uint8_t Lcd_RotationTiles[LCD_ROTATION_DMA2D_BUFFERS][4U * LCD_ROTATION_DMA2D_TILE * LCD_ROTATION_DMA2D_TILE] __ALIGNED(32);
+#endif /* USE_BSP_LCD_DMA2D_ROTATION */
+
+static const BSP_LCD_Font_t *Lcd_Font[LCD_INSTANCES_NBR];
+#if (USE_BSP_LCD_TEXT_CACHE == 1)
+static LCD_TextRun_t Lcd_TextRuns[LCD_TEXT_CACHE_NBR] __ALIGNED(32);
+static uint32_t Lcd_TextClock;
+#endif /* USE_BSP_LCD_TEXT_CACHE */
+
+#if (USE_BSP_LCD_STATS == 1)
+static BSP_LCD_Stats_t Lcd_Stats[BSP_LCD_STATS_NBR];
+#endif /* USE_BSP_LCD_STATS */
+
+static LCD_Sprite_Ctx_t Lcd_Sprite[LCD_INSTANCES_NBR];
 /** @defgroup STM32H573I_DK_LCD_Private_Types LCD Private Types
   * @{
   */
@@ -154,8 +402,65 @@ static void LTDC_MspInit(LTDC_HandleTypeDef *hltdc);
 static void LTDC_MspDeInit(LTDC_HandleTypeDef *hltdc);
 static void DMA2D_MspInit(DMA2D_HandleTypeDef *hdma2d);
 static void DMA2D_MspDeInit(DMA2D_HandleTypeDef *hdma2d);
-static void LL_FillBuffer(uint32_t Instance, uint32_t *pDst, uint32_t xSize, uint32_t ySize, uint32_t OffLine, uint32_t Color);
-static void LL_ConvertLineToRGB(uint32_t Instance, uint32_t *pSrc, uint32_t *pDst, uint32_t xSize, uint32_t ColorMode);
+static int32_t LL_FillBuffer(uint32_t Instance, uint32_t *pDst, uint32_t xSize, uint32_t ySize, uint32_t OffLine, uint32_t Color);
+static int32_t LL_ConvertRectToRGB(uint32_t Instance, uint8_t *pSrc, uint32_t Xpos, uint32_t Ypos, uint32_t xSize, uint32_t ySize, int32_t SrcPitch, uint32_t ColorMode);
+static int32_t LL_FillRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Color);
+static int32_t LL_SubmitRect(uint32_t Instance, const LCD_DMA2D_Job_t *Job, uint32_t Xpos, uint32_t Ypos);
+#if (USE_BSP_LCD_DMA2D_ROTATION == 1)
+static int32_t LL_DMA2D_DrawTiles(uint32_t Instance, const LCD_DMA2D_Job_t *Job, uint32_t Xpos, uint32_t Ypos);
+#endif /* USE_BSP_LCD_DMA2D_ROTATION */
+static int32_t LL_CPU_DrawRotated(uint32_t Instance, const LCD_DMA2D_Job_t *Job, uint32_t Xpos, uint32_t Ypos);
+static int32_t LL_GetSrcPitch(const LCD_DMA2D_Job_t *Job);
+static uint32_t LL_GetWidth(uint32_t Instance);
+static uint32_t LL_GetHeight(uint32_t Instance);
+static void LL_TransformRect(uint32_t Instance, uint32_t *Xpos, uint32_t *Ypos, uint32_t *Width, uint32_t *Height);
+static int32_t LL_GetPixelAddress(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t *Address, int32_t *XStep,
+                                  int32_t *YStep);
+static int32_t LL_DMA2D_Submit(uint32_t Instance, const LCD_DMA2D_Job_t *Job);
+#if (USE_BSP_LCD_CPU_RENDERING == 0)
+static HAL_StatusTypeDef LL_DMA2D_Program(const LCD_DMA2D_Job_t *Job);
+static HAL_StatusTypeDef LL_DMA2D_Start(const LCD_DMA2D_Job_t *Job, uint32_t Src, uint32_t Dst, uint32_t Height);
+#endif /* USE_BSP_LCD_CPU_RENDERING */
+static uint32_t LL_GetInputBits(uint32_t ColorMode);
+static uint32_t LL_GetOutputBpp(uint32_t ColorMode);
+static uint32_t LL_GetOutputColorMode(uint32_t Instance);
+static uint32_t LL_GetLayerInputColorMode(uint32_t Instance);
+static uint32_t LL_GetInputAsOutputColorMode(uint32_t InputColorMode);
+static uint32_t LL_ConvertToARGB8888(uint32_t Instance, uint32_t Color);
+static uint32_t LL_ReadRawPixel(uint32_t Address, uint32_t Bpp);
+static void LL_WriteRawPixel(uint32_t Address, uint32_t Bpp, uint32_t Color);
+#if (USE_BSP_LCD_DMA2D_ASYNC == 1)
+static void LL_DMA2D_StartNext(void);
+static void LL_DMA2D_XferCpltCallback(DMA2D_HandleTypeDef *hdma2d);
+static HAL_StatusTypeDef LL_DMA2D_StartLine(const LCD_DMA2D_Job_t *Job);
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
+static void LL_CPU_Execute(const LCD_DMA2D_Job_t *Job);
+static void LL_CPU_FillLine(uint32_t Address, uint32_t Length, uint32_t Color, uint32_t Bpp);
+static void LL_CPU_ConvertLine(uint32_t Address, const uint8_t *pSrc, uint32_t Length, uint32_t InputColorMode, uint32_t OutputColorMode);
+static uint32_t LL_CPU_ReadARGB8888(const uint8_t *pSrc, uint32_t ColorMode);
+static uint32_t LL_CPU_ReadFgPixel(const uint8_t *pSrc, uint32_t Index, const LCD_DMA2D_Job_t *Job);
+static uint32_t LL_CPU_LoadPixel(uint32_t Address, uint32_t ColorMode);
+static void LL_CPU_StorePixel(uint32_t Address, uint32_t Color, uint32_t ColorMode);
+static void LL_CPU_WriteLine(uint32_t Address, int32_t Step, const uint8_t *pSrc, uint32_t Length, const LCD_DMA2D_Job_t *Job);
+static void LL_CPU_CopyLine(uint32_t Address, const uint8_t *pSrc, uint32_t Size);
+static int32_t LL_CPU_CopyRect(uint32_t Instance, const uint8_t *pSrc, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height);
+static int32_t LL_GetDrawAddress(uint32_t Instance, uint32_t *Address);
+static void LL_MarkDirty(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height);
+static void LL_AddDirtyRect(LCD_FB_Ctx_t *Fb, uint32_t Index, LCD_Rect_t *Rect);
+static int32_t LL_SyncBackBuffer(uint32_t Instance);
+static int32_t LL_UpdateSprite(uint32_t Instance);
+static int32_t LL_ReloadLayers(uint32_t Instance);
+#if (USE_BSP_LCD_STATS == 1)
+static void LL_StatsRecord(uint32_t Primitive, uint32_t Start, uint32_t Pixels);
+#endif /* USE_BSP_LCD_STATS */
+static int32_t LL_BlendTextMask(uint32_t Instance, int32_t Xpos, int32_t Ypos, const uint8_t *pMask, uint32_t Width,
+                                uint32_t Height, uint32_t Color);
+static const BSP_LCD_Glyph_t *LL_GetGlyph(const BSP_LCD_Font_t *pFont, uint8_t Char);
+static uint32_t LL_GetRunWidth(const BSP_LCD_Font_t *pFont, const char *pText, uint32_t Length);
+#if (USE_BSP_LCD_TEXT_CACHE == 1)
+static void LL_ComposeRun(LCD_TextRun_t *pRun, const char *pText);
+static LCD_TextRun_t *LL_GetTextRun(uint32_t Instance, const BSP_LCD_Font_t *pFont, const char *pText, uint32_t Length, uint32_t Width);
+#endif /* USE_BSP_LCD_TEXT_CACHE */
 static void LPTIMx_PWM_MspInit(LPTIM_HandleTypeDef *hlptim);
 static void LPTIMx_PWM_MspDeInit(LPTIM_HandleTypeDef *hlptim);
 static void LPTIMx_PWM_DeInit(LPTIM_HandleTypeDef *hlptim);
@@ -169,6 +474,33 @@ static void LPTIMx_PWM_Init(LPTIM_HandleTypeDef *hlptim);
 #define CONVERTRGB5652ARGB8888(Color)((((((((Color) >> (11U)) & 0x1FU) * 527U) + 23U) >> (6U)) << (16U)) |\
                                      (((((((Color) >> (5U)) & 0x3FU) * 259U) + 33U) >> (6U)) << (8U)) |\
                                      (((((Color) & 0x1FU) * 527U) + 23U) >> (6U)) | (0xFF000000U))
+
+#define CONVERTARGB88882RGB565(Color)((((Color) >> 8U) & 0xF800U) | (((Color) >> 5U) & 0x07E0U) | (((Color) >> 3U) & 0x001FU))
+
+#define CONVERTARGB44442ARGB8888(Color)((((Color) & 0xF000U) * 0x11000U) | (((Color) & 0x0F00U) * 0x1100U) |\
+                                       (((Color) & 0x00F0U) * 0x110U) | (((Color) & 0x000FU) * 0x11U))
+
+#define CONVERTARGB88882ARGB4444(Color)((((Color) >> 16U) & 0xF000U) | (((Color) >> 12U) & 0x0F00U) |\
+                                       (((Color) >> 8U) & 0x00F0U) | (((Color) >> 4U) & 0x000FU))
+
+/* Packs two RGB565 pixels in a word, Lo is the pixel at the lowest address */
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#define PACKRGB565(Lo, Hi)           __PKHBT((Lo), (Hi), 16)
+#else
+#define PACKRGB565(Lo, Hi)           (((Lo) & 0xFFFFU) | ((Hi) << 16U))
+#endif /* __ARM_FEATURE_DSP */
+
+#define LCD_MIN(a, b)                ((a) < (b) ? (a) : (b))
+#define LCD_MAX(a, b)                ((a) > (b) ? (a) : (b))
+
+/* Latency recording of the draw APIs, only successful calls are recorded */
+#if (USE_BSP_LCD_STATS == 1)
+#define LCD_STATS_START(Start)                    ((Start) = DWT->CYCCNT)
+#define LCD_STATS_STOP(Primitive, Start, Pixels)  LL_StatsRecord((Primitive), (Start), (Pixels))
+#else
+#define LCD_STATS_START(Start)                    ((Start) = 0U)
+#define LCD_STATS_STOP(Primitive, Start, Pixels)  ((void)(Start), (void)(Pixels))
+#endif /* USE_BSP_LCD_STATS */
 /**
   * @}
   */
@@ -179,7 +511,8 @@ static void LPTIMx_PWM_Init(LPTIM_HandleTypeDef *hlptim);
 /**
   * @brief  Initializes the LCD in default mode.
   * @param  Instance    LCD Instance
-  * @param  Orientation LCD_ORIENTATION_LANDSCAPE
+  * @param  Orientation LCD_ORIENTATION_PORTRAIT, LCD_ORIENTATION_LANDSCAPE,
+  *         LCD_ORIENTATION_PORTRAIT_ROT180 or LCD_ORIENTATION_LANDSCAPE_ROT180
   * @retval BSP status
   */
 
@@ -191,10 +524,13 @@ int32_t BSP_LCD_Init(uint32_t Instance, uint32_t Orientation)
 /**
   * @brief  Initializes the LCD.
   * @param  Instance    LCD Instance
-  * @param  Orientation LCD_ORIENTATION_LANDSCAPE
-  * @param  PixelFormat LCD_PIXEL_FORMAT_RGB565 or LCD_PIXEL_FORMAT_RGB888
-  * @param  Width       Display width
-  * @param  Height      Display height
+  * @param  Orientation LCD_ORIENTATION_PORTRAIT, LCD_ORIENTATION_LANDSCAPE,
+  *         LCD_ORIENTATION_PORTRAIT_ROT180 or LCD_ORIENTATION_LANDSCAPE_ROT180
+  * @param  PixelFormat LCD_PIXEL_FORMAT_RGB565, LCD_PIXEL_FORMAT_RGB888 (ARGB8888 layer),
+  *         LCD_PIXEL_FORMAT_RGB888_PACKED, LCD_PIXEL_FORMAT_ARGB4444,
+  *         LCD_PIXEL_FORMAT_L8 or LCD_PIXEL_FORMAT_AL44 (CLUT set with BSP_LCD_SetLayerCLUT())
+  * @param  Width       Display width in landscape (panel native) orientation
+  * @param  Height      Display height in landscape (panel native) orientation
   * @retval BSP status
   */
 int32_t BSP_LCD_InitEx(uint32_t Instance, uint32_t Orientation, uint32_t PixelFormat, uint32_t Width, uint32_t Height)
@@ -211,28 +547,46 @@ int32_t BSP_LCD_InitEx(uint32_t Instance, uint32_t Orientation, uint32_t PixelFo
   };
 #endif /* DATA_IN_ExtRAM */
 
-  if ((Orientation > LCD_ORIENTATION_LANDSCAPE) || (Instance >= LCD_INSTANCES_NBR) || \
-    ((PixelFormat != LCD_PIXEL_FORMAT_RGB565) && (PixelFormat != LTDC_PIXEL_FORMAT_RGB888)))
+  switch(PixelFormat)
+  {
+  case LCD_PIXEL_FORMAT_RGB565:
+    ltdc_pixel_format = LTDC_PIXEL_FORMAT_RGB565;
+    break;
+  case LCD_PIXEL_FORMAT_RGB888:
+    ltdc_pixel_format = LTDC_PIXEL_FORMAT_ARGB8888;
+    break;
+  case LCD_PIXEL_FORMAT_RGB888_PACKED:
+    ltdc_pixel_format = LTDC_PIXEL_FORMAT_RGB888;
+    break;
+  case LCD_PIXEL_FORMAT_ARGB4444:
+    ltdc_pixel_format = LTDC_PIXEL_FORMAT_ARGB4444;
+    break;
+  case LCD_PIXEL_FORMAT_L8:
+    ltdc_pixel_format = LTDC_PIXEL_FORMAT_L8;
+    break;
+  case LCD_PIXEL_FORMAT_AL44:
+    ltdc_pixel_format = LTDC_PIXEL_FORMAT_AL44;
+    break;
+  default:
+    ret = BSP_ERROR_WRONG_PARAM;
+    break;
+  }
+
+  if ((Orientation > LCD_ORIENTATION_LANDSCAPE_ROT180) || (Instance >= LCD_INSTANCES_NBR) || (ret != BSP_ERROR_NONE))
   {
     ret = BSP_ERROR_WRONG_PARAM;
   }
   else
   {
-    if (PixelFormat == LCD_PIXEL_FORMAT_RGB565)
-    {
-      ltdc_pixel_format = LTDC_PIXEL_FORMAT_RGB565;
-      Lcd_Ctx[Instance].BppFactor = 2U;
-    }
-    else /* LCD_PIXEL_FORMAT_RGB888 */
-    {
-      ltdc_pixel_format = LTDC_PIXEL_FORMAT_ARGB8888;
-      Lcd_Ctx[Instance].BppFactor = 4U;
-    }
-
-    /* Store pixel format, xsize and ysize information */
+    /* Store pixel format, the helpers below use it */
     Lcd_Ctx[Instance].PixelFormat = PixelFormat;
+    Lcd_Ctx[Instance].BppFactor   = LL_GetOutputBpp(LL_GetOutputColorMode(Instance));
+
+    /* Store xsize and ysize information */
     Lcd_Ctx[Instance].XSize  = Width;
     Lcd_Ctx[Instance].YSize  = Height;
+    Lcd_Ctx[Instance].FbAddress = 0U;
+    Lcd_Ctx[Instance].Orientation = Orientation;
 
     /* Initializes peripherals instance value */
     hlcd_ltdc.Instance = LTDC;
@@ -256,6 +610,7 @@ int32_t BSP_LCD_InitEx(uint32_t Instance, uint32_t Orientation, uint32_t PixelFo
     HAL_GPIO_WritePin(LCD_DISP_EN_GPIO_PORT, LCD_DISP_EN_PIN, GPIO_PIN_SET);
 
     DMA2D_MspInit(&hlcd_dma2d);
+    Lcd_Dma2dConfig = 0U;
 
     if (MX_LTDC_ClockConfig(&hlcd_ltdc) != HAL_OK)
     {
@@ -327,6 +682,13 @@ int32_t BSP_LCD_DeInit(uint32_t Instance)
   {
     ret = BSP_ERROR_WRONG_PARAM;
   }
+#if (USE_BSP_LCD_DMA2D_ASYNC == 1)
+  /* Let the pending DMA2D jobs complete before disabling LTDC and DMA2D */
+  else if (BSP_LCD_WaitFence(Instance, Lcd_Dma2dSubmitted, LCD_DMA2D_TIMEOUT) != BSP_ERROR_NONE)
+  {
+    ret = BSP_ERROR_BUSY;
+  }
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
   else
   {
 #if (USE_HAL_LTDC_REGISTER_CALLBACKS == 0)
@@ -334,6 +696,14 @@ int32_t BSP_LCD_DeInit(uint32_t Instance)
 #endif /* (USE_HAL_LTDC_REGISTER_CALLBACKS == 0) */
 
     DMA2D_MspDeInit(&hlcd_dma2d);
+    Lcd_Dma2dConfig = 0U;
+
+    /* Release the frame buffer manager */
+    Lcd_Fb[Instance].NbBuffers    = 0U;
+    Lcd_Fb[Instance].PendingIndex = LCD_FB_NONE;
+    Lcd_Ctx[Instance].FbAddress   = 0U;
+    Lcd_Sprite[Instance].Sprite.pImage = NULL;
+    Lcd_Sprite[Instance].Shown         = 0U;
 
     (void)HAL_LTDC_DeInit(&hlcd_ltdc);
     if (HAL_DMA2D_DeInit(&hlcd_dma2d) != HAL_OK)
@@ -565,6 +935,7 @@ int32_t BSP_LCD_ConfigLayer(uint32_t Instance, uint32_t LayerIndex, BSP_LCD_Laye
     {
       ret = BSP_ERROR_PERIPH_FAILURE;
     }
+    Lcd_Ctx[Instance].FbAddress = 0U;
   }
   return ret;
 }
@@ -608,6 +979,7 @@ int32_t BSP_LCD_SetActiveLayer(uint32_t Instance, uint32_t LayerIndex)
   else
   {
     Lcd_Ctx[Instance].ActiveLayer = LayerIndex;
+    Lcd_Ctx[Instance].FbAddress   = 0U;
   }
 
   return ret;
@@ -625,6 +997,9 @@ int32_t BSP_LCD_SetActiveLayer(uint32_t Instance, uint32_t LayerIndex)
 int32_t BSP_LCD_Reload(uint32_t Instance, uint32_t ReloadType)
 {
   int32_t ret = BSP_ERROR_NONE;
+  uint32_t stats_start;
+
+  LCD_STATS_START(stats_start);
 
   if (Instance >= LCD_INSTANCES_NBR)
   {
@@ -641,6 +1016,7 @@ int32_t BSP_LCD_Reload(uint32_t Instance, uint32_t ReloadType)
   else
   {
     Lcd_Ctx[Instance].ReloadEnable = 1U;
+    LCD_STATS_STOP(BSP_LCD_STATS_RELOAD, stats_start, 0U);
   }
 
   return ret;
@@ -675,10 +1051,7 @@ int32_t BSP_LCD_SetLayerVisible(uint32_t Instance, uint32_t LayerIndex, Function
       __HAL_LTDC_LAYER_DISABLE(&hlcd_ltdc, LayerIndex);
     }
 
-    if (Lcd_Ctx[Instance].ReloadEnable == 1U)
-    {
-      __HAL_LTDC_RELOAD_IMMEDIATE_CONFIG(&hlcd_ltdc);
-    }
+    ret = LL_ReloadLayers(Instance);
   }
 
   return ret;
@@ -702,14 +1075,8 @@ int32_t BSP_LCD_SetTransparency(uint32_t Instance, uint32_t LayerIndex, uint8_t
   }
   else
   {
-    if (Lcd_Ctx[Instance].ReloadEnable == 1U)
-    {
-      (void)HAL_LTDC_SetAlpha(&hlcd_ltdc, Transparency, LayerIndex);
-    }
-    else
-    {
-      (void)HAL_LTDC_SetAlpha_NoReload(&hlcd_ltdc, Transparency, LayerIndex);
-    }
+    (void)HAL_LTDC_SetAlpha_NoReload(&hlcd_ltdc, Transparency, LayerIndex);
+    ret = LL_ReloadLayers(Instance);
   }
 
   return ret;
@@ -732,14 +1099,9 @@ int32_t BSP_LCD_SetLayerAddress(uint32_t Instance, uint32_t LayerIndex, uint32_t
   }
   else
   {
-    if (Lcd_Ctx[Instance].ReloadEnable == 1U)
-    {
-      (void)HAL_LTDC_SetAddress(&hlcd_ltdc, Address, LayerIndex);
-    }
-    else
-    {
-      (void)HAL_LTDC_SetAddress_NoReload(&hlcd_ltdc, Address, LayerIndex);
-    }
+    (void)HAL_LTDC_SetAddress_NoReload(&hlcd_ltdc, Address, LayerIndex);
+    Lcd_Ctx[Instance].FbAddress = 0U;
+    ret = LL_ReloadLayers(Instance);
   }
 
   return ret;
@@ -765,21 +1127,14 @@ int32_t BSP_LCD_SetLayerWindow(uint32_t Instance, uint16_t LayerIndex, uint16_t
   }
   else
   {
-    if (Lcd_Ctx[Instance].ReloadEnable == 1U)
-    {
-      /* Reconfigure the layer size  and position */
-      (void)HAL_LTDC_SetWindowSize(&hlcd_ltdc, Width, Height, LayerIndex);
-      (void)HAL_LTDC_SetWindowPosition(&hlcd_ltdc, Xpos, Ypos, LayerIndex);
-    }
-    else
-    {
-      /* Reconfigure the layer size and position */
-      (void)HAL_LTDC_SetWindowSize_NoReload(&hlcd_ltdc, Width, Height, LayerIndex);
-      (void)HAL_LTDC_SetWindowPosition_NoReload(&hlcd_ltdc, Xpos, Ypos, LayerIndex);
-    }
+    /* Reconfigure the layer size and position */
+    (void)HAL_LTDC_SetWindowSize_NoReload(&hlcd_ltdc, Width, Height, LayerIndex);
+    (void)HAL_LTDC_SetWindowPosition_NoReload(&hlcd_ltdc, Xpos, Ypos, LayerIndex);
 
     Lcd_Ctx[Instance].XSize = Width;
     Lcd_Ctx[Instance].YSize = Height;
+    Lcd_Ctx[Instance].FbAddress = 0U;
+    ret = LL_ReloadLayers(Instance);
   }
 
   return ret;
@@ -802,18 +1157,10 @@ int32_t BSP_LCD_SetColorKeying(uint32_t Instance, uint32_t LayerIndex, uint32_t
   }
   else
   {
-    if (Lcd_Ctx[Instance].ReloadEnable == 1U)
-    {
-      /* Configure and Enable the color Keying for LCD Layer */
-      (void)HAL_LTDC_ConfigColorKeying(&hlcd_ltdc, Color, LayerIndex);
-      (void)HAL_LTDC_EnableColorKeying(&hlcd_ltdc, LayerIndex);
-    }
-    else
-    {
-      /* Configure and Enable the color Keying for LCD Layer */
-      (void)HAL_LTDC_ConfigColorKeying_NoReload(&hlcd_ltdc, Color, LayerIndex);
-      (void)HAL_LTDC_EnableColorKeying_NoReload(&hlcd_ltdc, LayerIndex);
-    }
+    /* Configure and Enable the color Keying for LCD Layer */
+    (void)HAL_LTDC_ConfigColorKeying_NoReload(&hlcd_ltdc, Color, LayerIndex);
+    (void)HAL_LTDC_EnableColorKeying_NoReload(&hlcd_ltdc, LayerIndex);
+    ret = LL_ReloadLayers(Instance);
   }
 
   return ret;
@@ -835,17 +1182,236 @@ int32_t BSP_LCD_ResetColorKeying(uint32_t Instance, uint32_t LayerIndex)
   }
   else
   {
-    if (Lcd_Ctx[Instance].ReloadEnable == 1U)
+    /* Disable the color Keying for LCD Layer */
+    (void)HAL_LTDC_DisableColorKeying_NoReload(&hlcd_ltdc, LayerIndex);
+    ret = LL_ReloadLayers(Instance);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Loads and enables the color lookup table of a L8 or AL44 layer.
+  * @param  Instance    LCD Instance
+  * @param  LayerIndex  Layer 0 or 1
+  * @param  pCLUT       Pointer to the CLUT, one RGB888 color per word
+  * @param  Size        Number of CLUT entries (1 to 256, 16 for AL44 layers)
+  * @retval BSP status
+  */
+int32_t BSP_LCD_SetLayerCLUT(uint32_t Instance, uint32_t LayerIndex, const uint32_t *pCLUT, uint32_t Size)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  if ((Instance >= LCD_INSTANCES_NBR) || (LayerIndex >= MAX_LAYER) || (pCLUT == NULL) || (Size == 0U) || (Size > 256U))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if (HAL_LTDC_ConfigCLUT(&hlcd_ltdc, (uint32_t *)pCLUT, Size, LayerIndex) != HAL_OK)
+  {
+    ret = BSP_ERROR_PERIPH_FAILURE;
+  }
+  else if (HAL_LTDC_EnableCLUT(&hlcd_ltdc, LayerIndex) != HAL_OK)
+  {
+    ret = BSP_ERROR_PERIPH_FAILURE;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Configures the sprite overlay: the LCD_SPRITE_LAYER layer scans out
+  *         the sprite image in place, moving it only reprograms the layer
+  *         window. The sprite is hidden and its hot spot placed at (0, 0).
+  *         The layer is reloaded at the next vertical blanking, unless the
+  *         reload is disabled.
+  * @param  Instance LCD Instance
+  * @param  pSprite  Pointer to the sprite description
+  * @retval BSP status
+  */
+int32_t BSP_LCD_ConfigSprite(uint32_t Instance, const BSP_LCD_Sprite_t *pSprite)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  uint32_t bpp;
+  LTDC_LayerCfgTypeDef *layer = &hlcd_ltdc.LayerCfg[LCD_SPRITE_LAYER];
+
+  if ((Instance >= LCD_INSTANCES_NBR) || (pSprite == NULL))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    switch (pSprite->PixelFormat)
+    {
+      case LTDC_PIXEL_FORMAT_ARGB8888:
+        bpp = 4U;
+        break;
+      case LTDC_PIXEL_FORMAT_RGB888:
+        bpp = 3U;
+        break;
+      case LTDC_PIXEL_FORMAT_RGB565:
+      case LTDC_PIXEL_FORMAT_ARGB1555:
+      case LTDC_PIXEL_FORMAT_ARGB4444:
+      case LTDC_PIXEL_FORMAT_AL88:
+        bpp = 2U;
+        break;
+      case LTDC_PIXEL_FORMAT_L8:
+      case LTDC_PIXEL_FORMAT_AL44:
+        bpp = 1U;
+        break;
+      default:
+        bpp = 0U;
+        break;
+    }
+
+    if ((bpp == 0U) || (pSprite->pImage == NULL) || (pSprite->Width == 0U) || (pSprite->Height == 0U) ||
+        (pSprite->Width > Lcd_Ctx[Instance].XSize) || (pSprite->Height > Lcd_Ctx[Instance].YSize) ||
+        (pSprite->HotSpotX >= pSprite->Width) || (pSprite->HotSpotY >= pSprite->Height))
     {
-      /* Disable the color Keying for LCD Layer */
-      (void)HAL_LTDC_DisableColorKeying(&hlcd_ltdc, LayerIndex);
+      ret = BSP_ERROR_WRONG_PARAM;
     }
     else
     {
-      /* Disable the color Keying for LCD Layer */
-      (void)HAL_LTDC_DisableColorKeying_NoReload(&hlcd_ltdc, LayerIndex);
+      layer->WindowX0        = 0U;
+      layer->WindowX1        = pSprite->Width;
+      layer->WindowY0        = 0U;
+      layer->WindowY1        = pSprite->Height;
+      layer->Alpha           = 255U;
+      layer->Alpha0          = 0U;
+      layer->BlendingFactor1 = LTDC_BLENDING_FACTOR1_PAxCA;
+      layer->BlendingFactor2 = LTDC_BLENDING_FACTOR2_PAxCA;
+      layer->FBStartAdress   = (uint32_t)pSprite->pImage;
+      layer->ImageWidth      = pSprite->Width;
+      layer->ImageHeight     = pSprite->Height;
+      layer->Backcolor.Blue  = 0U;
+      layer->Backcolor.Green = 0U;
+      layer->Backcolor.Red   = 0U;
+
+      /* Writes the whole layer configuration in the shadow registers: an
+         immediate reload would also apply a pending buffer flip */
+      if (HAL_LTDC_SetPixelFormat_NoReload(&hlcd_ltdc, pSprite->PixelFormat, LCD_SPRITE_LAYER) != HAL_OK)
+      {
+        ret = BSP_ERROR_PERIPH_FAILURE;
+      }
+      else
+      {
+        /* Keep the layer off until the sprite is shown */
+        __HAL_LTDC_LAYER_DISABLE(&hlcd_ltdc, LCD_SPRITE_LAYER);
+
+        if (Lcd_Ctx[Instance].ReloadEnable == 1U)
+        {
+          if (HAL_LTDC_Reload(&hlcd_ltdc, LTDC_RELOAD_VERTICAL_BLANKING) != HAL_OK)
+          {
+            ret = BSP_ERROR_PERIPH_FAILURE;
+          }
+        }
+
+        Lcd_Sprite[Instance].Sprite = *pSprite;
+        Lcd_Sprite[Instance].Bpp    = bpp;
+        Lcd_Sprite[Instance].Xpos   = 0;
+        Lcd_Sprite[Instance].Ypos   = 0;
+        Lcd_Sprite[Instance].Shown  = 0U;
+      }
+
+      if (Lcd_Ctx[Instance].ActiveLayer == LCD_SPRITE_LAYER)
+      {
+        Lcd_Ctx[Instance].FbAddress = 0U;
+      }
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Moves the sprite hot spot. The new position is applied at the next
+  *         vertical blanking, successive moves within a frame are coalesced.
+  * @param  Instance LCD Instance
+  * @param  Xpos     X position in panel coordinates, may be off screen
+  * @param  Ypos     Y position in panel coordinates, may be off screen
+  * @retval BSP status
+  */
+int32_t BSP_LCD_MoveSprite(uint32_t Instance, int32_t Xpos, int32_t Ypos)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  if (Instance >= LCD_INSTANCES_NBR)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if (Lcd_Sprite[Instance].Sprite.pImage == NULL)
+  {
+    ret = BSP_ERROR_NO_INIT;
+  }
+  else if ((Xpos != Lcd_Sprite[Instance].Xpos) || (Ypos != Lcd_Sprite[Instance].Ypos))
+  {
+    Lcd_Sprite[Instance].Xpos = Xpos;
+    Lcd_Sprite[Instance].Ypos = Ypos;
+
+    if (Lcd_Sprite[Instance].Shown == 1U)
+    {
+      ret = LL_UpdateSprite(Instance);
     }
   }
+  else
+  {
+    /* Nothing to do */
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Shows the sprite at the next vertical blanking.
+  * @param  Instance LCD Instance
+  * @retval BSP status
+  */
+int32_t BSP_LCD_ShowSprite(uint32_t Instance)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  if (Instance >= LCD_INSTANCES_NBR)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if (Lcd_Sprite[Instance].Sprite.pImage == NULL)
+  {
+    ret = BSP_ERROR_NO_INIT;
+  }
+  else
+  {
+    Lcd_Sprite[Instance].Shown = 1U;
+    ret = LL_UpdateSprite(Instance);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Hides the sprite at the next vertical blanking.
+  * @param  Instance LCD Instance
+  * @retval BSP status
+  */
+int32_t BSP_LCD_HideSprite(uint32_t Instance)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  if (Instance >= LCD_INSTANCES_NBR)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if (Lcd_Sprite[Instance].Sprite.pImage == NULL)
+  {
+    ret = BSP_ERROR_NO_INIT;
+  }
+  else
+  {
+    Lcd_Sprite[Instance].Shown = 0U;
+    ret = LL_UpdateSprite(Instance);
+  }
 
   return ret;
 }
@@ -866,7 +1432,7 @@ int32_t BSP_LCD_GetXSize(uint32_t Instance, uint32_t *XSize)
   }
   else
   {
-    *XSize = Lcd_Ctx[Instance].XSize;
+    *XSize = LL_GetWidth(Instance);
   }
 
   return ret;
@@ -888,7 +1454,7 @@ int32_t BSP_LCD_GetYSize(uint32_t Instance, uint32_t *YSize)
   }
   else
   {
-    *YSize = Lcd_Ctx[Instance].YSize;
+    *YSize = LL_GetHeight(Instance);
   }
 
   return ret;
@@ -1019,323 +1585,3617 @@ int32_t BSP_LCD_DrawBitmap(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint
 {
   int32_t ret = BSP_ERROR_NONE;
   uint32_t index, width, height, bit_pixel;
-  uint32_t Address;
   uint32_t input_color_mode;
+  uint32_t line_size;
+  int32_t  src_pitch;
   uint8_t *pbmp;
+  uint32_t stats_start;
 
-  /* Get bitmap data address offset */
-  index = (uint32_t)pBmp[10] + ((uint32_t)pBmp[11] << 8) + ((uint32_t)pBmp[12] << 16)  + ((uint32_t)pBmp[13] << 24);
-
-  /* Read bitmap width */
-  width = (uint32_t)pBmp[18] + ((uint32_t)pBmp[19] << 8) + ((uint32_t)pBmp[20] << 16)  + ((uint32_t)pBmp[21] << 24);
+  LCD_STATS_START(stats_start);
 
-  /* Read bitmap height */
-  height = (uint32_t)pBmp[22] + ((uint32_t)pBmp[23] << 8) + ((uint32_t)pBmp[24] << 16)  + ((uint32_t)pBmp[25] << 24);
-
-  /* Read bit/pixel */
-  bit_pixel = (uint32_t)pBmp[28] + ((uint32_t)pBmp[29] << 8);
-
-  /* Set the address */
-  Address = hlcd_ltdc.LayerCfg[Lcd_Ctx[Instance].ActiveLayer].FBStartAdress + (((Lcd_Ctx[Instance].XSize*Ypos) + Xpos)*Lcd_Ctx[Instance].BppFactor);
-
-  /* Get the layer pixel format */
-  if ((bit_pixel/8U) == 4U)
-  {
-    input_color_mode = DMA2D_INPUT_ARGB8888;
-  }
-  else if ((bit_pixel/8U) == 2U)
+  if (Lcd_Ctx[Instance].BppFactor == 1U)
   {
-    input_color_mode = DMA2D_INPUT_RGB565;
+    /* RGB pixels cannot be converted to 8-bit layer formats */
+    ret = BSP_ERROR_FEATURE_NOT_SUPPORTED;
   }
   else
   {
-    input_color_mode = DMA2D_INPUT_RGB888;
-  }
-
-  /* Bypass the bitmap header */
-  pbmp = pBmp + (index + (width * (height - 1U) * (bit_pixel/8U)));
-
-  /* Convert picture to ARGB8888 pixel format */
-  for(index=0; index < height; index++)
-  {
-    /* Pixel format conversion */
-    LL_ConvertLineToRGB(Instance, (uint32_t *)pbmp, (uint32_t *)Address, width, input_color_mode);
+    /* Get bitmap data address offset */
+    index = (uint32_t)pBmp[10] + ((uint32_t)pBmp[11] << 8) + ((uint32_t)pBmp[12] << 16)  + ((uint32_t)pBmp[13] << 24);
 
-    /* Increment the source and destination buffers */
-    Address+=  (Lcd_Ctx[Instance].XSize * Lcd_Ctx[Instance].BppFactor);
-    pbmp -= width*(bit_pixel/8U);
-  }
+    /* Read bitmap width */
+    width = (uint32_t)pBmp[18] + ((uint32_t)pBmp[19] << 8) + ((uint32_t)pBmp[20] << 16)  + ((uint32_t)pBmp[21] << 24);
 
-  return ret;
-}
+    /* Read bitmap height */
+    height = (uint32_t)pBmp[22] + ((uint32_t)pBmp[23] << 8) + ((uint32_t)pBmp[24] << 16)  + ((uint32_t)pBmp[25] << 24);
 
-/**
-  * @brief  Draw a horizontal line on LCD.
-  * @param  Instance LCD Instance.
-  * @param  Xpos X position.
-  * @param  Ypos Y position.
-  * @param  pData Pointer to RGB line data
-  * @param  Width Rectangle width.
-  * @param  Height Rectangle Height.
-  * @retval BSP status.
-  */
-int32_t BSP_LCD_FillRGBRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t Width, uint32_t Height)
-{
-  uint32_t i;
-  uint8_t *pdata = pData;
+    /* Read bit/pixel */
+    bit_pixel = (uint32_t)pBmp[28] + ((uint32_t)pBmp[29] << 8);
 
-#if (USE_DMA2D_TO_FILL_RGB_RECT == 1)
-  uint32_t  Xaddress;
-  for(i = 0; i < Height; i++)
-  {
-    /* Get the line address */
-    Xaddress = hlcd_ltdc.LayerCfg[Lcd_Ctx[Instance].ActiveLayer].FBStartAdress + (Lcd_Ctx[Instance].BppFactor*((Lcd_Ctx[Instance].XSize*(Ypos + i)) + Xpos));
+    /* Get the layer pixel format */
+    if ((bit_pixel/8U) == 4U)
+    {
+      input_color_mode = DMA2D_INPUT_ARGB8888;
+    }
+    else if ((bit_pixel/8U) == 2U)
+    {
+      input_color_mode = DMA2D_INPUT_RGB565;
+    }
+    else
+    {
+      input_color_mode = DMA2D_INPUT_RGB888;
+    }
 
-#if (USE_BSP_CPU_CACHE_MAINTENANCE == 1)
-    SCB_CleanDCache_by_Addr((uint32_t *)pdata, Lcd_Ctx[Instance].BppFactor*Lcd_Ctx[Instance].XSize);
-#endif /* USE_BSP_CPU_CACHE_MAINTENANCE */
+    /* BMP lines are padded to a multiple of 4 bytes */
+    line_size = (((width * bit_pixel) + 31U) / 32U) * 4U;
 
-    /* Write line */
-    if (Lcd_Ctx[Instance].PixelFormat == LCD_PIXEL_FORMAT_RGB565)
+    if ((int32_t)height < 0)
     {
-      LL_ConvertLineToRGB(Instance, (uint32_t *)pdata, (uint32_t *)Xaddress, Width, DMA2D_INPUT_RGB565);
+      /* Top-down bitmap: first line is stored first */
+      height    = (uint32_t)(-(int32_t)height);
+      pbmp      = pBmp + index;
+      src_pitch = (int32_t)line_size;
     }
     else
     {
-      LL_ConvertLineToRGB(Instance, (uint32_t *)pdata, (uint32_t *)Xaddress, Width, DMA2D_INPUT_ARGB8888);
+      /* Bottom-up bitmap: bypass the bitmap header and start from the last line */
+      pbmp      = pBmp + (index + (line_size * (height - 1U)));
+      src_pitch = -(int32_t)line_size;
     }
-    pdata += Lcd_Ctx[Instance].BppFactor*Width;
-  }
-#else
-  uint32_t color, j;
-  for(i = 0; i < Height; i++)
-  {
-    for(j = 0; j < Width; j++)
+
+    /* Convert picture to the layer pixel format, DMA2D is configured once */
+    ret = LL_ConvertRectToRGB(Instance, pbmp, Xpos, Ypos, width, height, src_pitch, input_color_mode);
+    LL_MarkDirty(Instance, Xpos, Ypos, width, height);
+
+    if (ret == BSP_ERROR_NONE)
     {
-      color = (uint32_t)((uint32_t)*pdata | ((uint32_t)(*(pdata + 1U)) << 8U) | ((uint32_t)(*(pdata + 2U)) << 16U) | ((uint32_t)(*(pdata + 3U)) << 24U));
-      (void)BSP_LCD_WritePixel(Instance, Xpos + j, Ypos + i, color);
-      pdata += Lcd_Ctx[Instance].BppFactor;
+      LCD_STATS_STOP(BSP_LCD_STATS_BITMAP, stats_start, width * height);
     }
   }
-#endif
 
-  return BSP_ERROR_NONE;
+  return ret;
 }
 
+#if (USE_BSP_LCD_RLE == 1)
 /**
-  * @brief  Draws an horizontal line in currently active layer.
-  * @param  Instance   LCD Instance
-  * @param  Xpos  X position
-  * @param  Ypos  Y position
-  * @param  Length  Line length
-  * @param  Color RGB color
-  * @retval BSP status
+  * @brief  Draws a RLE compressed image (see BSP_LCD_RLE_MAGIC for the format).
+  *         Lines are decoded in a ring of LCD_RLE_LINE_BUFFERS line buffers and
+  *         converted to the layer pixel format by DMA2D, so that the image is
+  *         read once in its compressed form. With USE_BSP_LCD_DMA2D_ASYNC, a
+  *         line is decoded while DMA2D converts the previous ones.
+  * @param  Instance LCD Instance
+  * @param  Xpos X position
+  * @param  Ypos Y position
+  * @param  pData Pointer to the image, header included
+  * @param  Size Image size in bytes
+  * @retval BSP status, BSP_ERROR_WRONG_PARAM for an image that does not fit in
+  *         the layer, or for a truncated or corrupted image (the lines decoded
+  *         before the error are drawn)
   */
-int32_t BSP_LCD_DrawHLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+int32_t BSP_LCD_DrawRLEBitmap(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, const uint8_t *pData, uint32_t Size)
 {
-  uint32_t  Xaddress;
-
-  /* Get the line address */
-  Xaddress = hlcd_ltdc.LayerCfg[Lcd_Ctx[Instance].ActiveLayer].FBStartAdress + (Lcd_Ctx[Instance].BppFactor*((Lcd_Ctx[Instance].XSize*Ypos) + Xpos));
-
-  /* Write line */
-  LL_FillBuffer(Instance, (uint32_t *)Xaddress, Length, 1, 0, Color);
-
-  return BSP_ERROR_NONE;
-}
+  int32_t ret = BSP_ERROR_NONE;
+  uint32_t width, height, color_mode, bpp;
+  uint32_t line, x, i, count, pixel = 0U;
+  uint32_t index = BSP_LCD_RLE_HEADER_SIZE;
+  uint32_t run = 0U;     /* Pixels left in the current packet */
+  uint32_t repeat = 0U;  /* Current packet repeats one pixel */
+  uint8_t *pline;
+  uint32_t stats_start;
+#if (USE_BSP_LCD_DMA2D_ASYNC == 1)
+  uint32_t fence[LCD_RLE_LINE_BUFFERS] = {0};
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
+
+  LCD_STATS_START(stats_start);
+
+  if ((Instance >= LCD_INSTANCES_NBR) || (pData == NULL) || (Size < BSP_LCD_RLE_HEADER_SIZE))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if (((uint32_t)pData[0] | ((uint32_t)pData[1] << 8) | ((uint32_t)pData[2] << 16) | ((uint32_t)pData[3] << 24)) != BSP_LCD_RLE_MAGIC)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if (Lcd_Ctx[Instance].BppFactor == 1U)
+  {
+    /* RGB pixels cannot be converted to 8-bit layer formats */
+    ret = BSP_ERROR_FEATURE_NOT_SUPPORTED;
+  }
+  else
+  {
+    width      = (uint32_t)pData[4] | ((uint32_t)pData[5] << 8);
+    height     = (uint32_t)pData[6] | ((uint32_t)pData[7] << 8);
+    color_mode = pData[8];
+    bpp        = LL_GetInputBits(color_mode) / 8U;
+
+    if ((width == 0U) || (width > LCD_RLE_MAX_WIDTH) ||
+        ((color_mode != DMA2D_INPUT_ARGB8888) && (color_mode != DMA2D_INPUT_RGB888) &&
+         (color_mode != DMA2D_INPUT_RGB565) && (color_mode != DMA2D_INPUT_L8)))
+    {
+      ret = BSP_ERROR_WRONG_PARAM;
+      height = 0U;
+    }
+    /* Decoded lines must fit in the line buffers */
+    else if ((width * bpp) > sizeof(Lcd_RleLines[0]))
+    {
+      ret = BSP_ERROR_WRONG_PARAM;
+      height = 0U;
+    }
+    /* The image must fit in the layer, in the drawing orientation */
+    else if ((Xpos >= LL_GetWidth(Instance)) || (width > (LL_GetWidth(Instance) - Xpos)) ||
+             (Ypos >= LL_GetHeight(Instance)) || (height > (LL_GetHeight(Instance) - Ypos)))
+    {
+      ret = BSP_ERROR_WRONG_PARAM;
+      height = 0U;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+
+    for (line = 0U; (line < height) && (ret == BSP_ERROR_NONE); line++)
+    {
+      pline = Lcd_RleLines[line % LCD_RLE_LINE_BUFFERS];
+
+#if (USE_BSP_LCD_DMA2D_ASYNC == 1)
+      /* The line buffer is free once DMA2D converted the line it held */
+      ret = BSP_LCD_WaitFence(Instance, fence[line % LCD_RLE_LINE_BUFFERS], LCD_DMA2D_TIMEOUT);
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
+
+      x = 0U;
+      while ((x < width) && (ret == BSP_ERROR_NONE))
+      {
+        if (run == 0U)
+        {
+          /* Next packet: control byte, then the repeated pixel if any */
+          if ((index >= Size) || (((pData[index] & 0x80U) != 0U) && ((Size - index - 1U) < bpp)))
+          {
+            ret = BSP_ERROR_WRONG_PARAM;
+          }
+          else
+          {
+            repeat = (uint32_t)pData[index] & 0x80U;
+            run    = ((uint32_t)pData[index] & 0x7FU) + 1U;
+            index++;
+
+            if (repeat != 0U)
+            {
+              pixel = 0U;
+              for (i = 0U; i < bpp; i++)
+              {
+                pixel |= (uint32_t)pData[index + i] << (8U * i);
+              }
+              index += bpp;
+            }
+          }
+        }
+        else
+        {
+          count = LCD_MIN(run, width - x);
+
+          if (repeat != 0U)
+          {
+            LL_CPU_FillLine((uint32_t)&pline[x * bpp], count, pixel, bpp);
+          }
+          else if ((Size - index) < (count * bpp))
+          {
+            ret = BSP_ERROR_WRONG_PARAM;
+          }
+          else
+          {
+            LL_CPU_CopyLine((uint32_t)&pline[x * bpp], &pData[index], count * bpp);
+            index += count * bpp;
+          }
+
+          x   += count;
+          run -= count;
+        }
+      }
+
+      if (ret == BSP_ERROR_NONE)
+      {
+#if (USE_BSP_CPU_CACHE_MAINTENANCE == 1)
+        SCB_CleanDCache_by_Addr((uint32_t *)pline, width * bpp);
+#endif /* USE_BSP_CPU_CACHE_MAINTENANCE */
+
+        ret = LL_ConvertRectToRGB(Instance, pline, Xpos, Ypos + line, width, 1U, (int32_t)(width * bpp), color_mode);
+
+#if (USE_BSP_LCD_DMA2D_ASYNC == 1)
+        fence[line % LCD_RLE_LINE_BUFFERS] = Lcd_Dma2dSubmitted;
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
+      }
+    }
+
+    if (height != 0U)
+    {
+      LL_MarkDirty(Instance, Xpos, Ypos, width, (ret == BSP_ERROR_NONE) ? line : (line - 1U));
+    }
+  }
+
+  if (ret == BSP_ERROR_NONE)
+  {
+    LCD_STATS_STOP(BSP_LCD_STATS_BITMAP, stats_start, width * height);
+  }
+
+  return ret;
+}
+#endif /* USE_BSP_LCD_RLE */
+
+/**
+  * @brief  Draw a horizontal line on LCD.
+  * @param  Instance LCD Instance.
+  * @param  Xpos X position.
+  * @param  Ypos Y position.
+  * @param  pData Pointer to RGB line data
+  * @param  Width Rectangle width.
+  * @param  Height Rectangle Height.
+  * @retval BSP status.
+  */
+int32_t BSP_LCD_FillRGBRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t Width, uint32_t Height)
+{
+  int32_t ret;
+  uint32_t stats_start;
+
+  LCD_STATS_START(stats_start);
+
+#if (USE_DMA2D_TO_FILL_RGB_RECT == 1)
+  if (Lcd_Ctx[Instance].BppFactor == 1U)
+  {
+    /* DMA2D cannot write 8-bit pixels */
+    ret = LL_CPU_CopyRect(Instance, pData, Xpos, Ypos, Width, Height);
+  }
+  else
+  {
+#if (USE_BSP_CPU_CACHE_MAINTENANCE == 1)
+    /* Source pixels are contiguous: clean exactly the region read by DMA2D */
+    SCB_CleanDCache_by_Addr((uint32_t *)pData, Lcd_Ctx[Instance].BppFactor*Width*Height);
+#endif /* USE_BSP_CPU_CACHE_MAINTENANCE */
+
+    /* Write the rectangle with one 2D transfer */
+    ret = LL_ConvertRectToRGB(Instance, pData, Xpos, Ypos, Width, Height, (int32_t)(Lcd_Ctx[Instance].BppFactor*Width),
+                              LL_GetLayerInputColorMode(Instance));
+  }
+#else
+  /* Source and layer share the same pixel format: CPU copy */
+  ret = LL_CPU_CopyRect(Instance, pData, Xpos, Ypos, Width, Height);
+#endif /* USE_DMA2D_TO_FILL_RGB_RECT */
+  LL_MarkDirty(Instance, Xpos, Ypos, Width, Height);
+
+  if (ret == BSP_ERROR_NONE)
+  {
+    LCD_STATS_STOP(BSP_LCD_STATS_RGB_RECT, stats_start, Width * Height);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Draws an horizontal line in currently active layer.
+  * @param  Instance   LCD Instance
+  * @param  Xpos  X position
+  * @param  Ypos  Y position
+  * @param  Length  Line length
+  * @param  Color RGB color
+  * @retval BSP status
+  */
+int32_t BSP_LCD_DrawHLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  int32_t ret;
+  uint32_t stats_start;
+
+  LCD_STATS_START(stats_start);
+
+  /* Write line */
+  ret = LL_FillRect(Instance, Xpos, Ypos, Length, 1U, Color);
+  LL_MarkDirty(Instance, Xpos, Ypos, Length, 1U);
+
+  if (ret == BSP_ERROR_NONE)
+  {
+    LCD_STATS_STOP(BSP_LCD_STATS_FILL, stats_start, Length);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Draws a vertical line in currently active layer.
+  * @param  Instance   LCD Instance
+  * @param  Xpos  X position
+  * @param  Ypos  Y position
+  * @param  Length  Line length
+  * @param  Color RGB color
+  * @retval BSP status
+  */
+int32_t BSP_LCD_DrawVLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  int32_t ret;
+  uint32_t stats_start;
+
+  LCD_STATS_START(stats_start);
+
+  /* Write line */
+  ret = LL_FillRect(Instance, Xpos, Ypos, 1U, Length, Color);
+  LL_MarkDirty(Instance, Xpos, Ypos, 1U, Length);
+
+  if (ret == BSP_ERROR_NONE)
+  {
+    LCD_STATS_STOP(BSP_LCD_STATS_FILL, stats_start, Length);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Draws a full rectangle in currently active layer.
+  * @param  Instance   LCD Instance
+  * @param  Xpos X position
+  * @param  Ypos Y position
+  * @param  Width Rectangle width
+  * @param  Height Rectangle height
+  * @param  Color RGB color
+  * @retval BSP status
+  */
+int32_t BSP_LCD_FillRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Color)
+{
+  int32_t ret;
+  uint32_t stats_start;
+
+  LCD_STATS_START(stats_start);
+
+  /* Fill the rectangle */
+  ret = LL_FillRect(Instance, Xpos, Ypos, Width, Height, Color);
+  LL_MarkDirty(Instance, Xpos, Ypos, Width, Height);
+
+  if (ret == BSP_ERROR_NONE)
+  {
+    LCD_STATS_STOP(BSP_LCD_STATS_FILL, stats_start, Width * Height);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Reads a LCD pixel.
+  * @param  Instance    LCD Instance
+  * @param  Xpos X position
+  * @param  Ypos Y position
+  * @param  Color RGB pixel color
+  * @retval BSP status
+  */
+int32_t BSP_LCD_ReadPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t *Color)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  uint32_t address;
+
+  if ((Instance >= LCD_INSTANCES_NBR) || (Color == NULL) ||
+      (Xpos >= LL_GetWidth(Instance)) || (Ypos >= LL_GetHeight(Instance)))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    /* Refreshes the cached frame buffer address */
+    ret = LL_GetPixelAddress(Instance, Xpos, Ypos, &address, NULL, NULL);
+
+#if (USE_BSP_LCD_DMA2D_ASYNC == 1)
+    if (ret == BSP_ERROR_NONE)
+    {
+      /* Frame buffer is accessed by CPU: wait for the queued DMA2D jobs,
+         including the back buffer refresh queued by the address lookup */
+      ret = BSP_LCD_WaitFence(Instance, Lcd_Dma2dSubmitted, LCD_DMA2D_TIMEOUT);
+    }
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
+
+    if (ret == BSP_ERROR_NONE)
+    {
+      /* Read data value from RAM memory */
+      *Color = LL_ReadRawPixel(address, Lcd_Ctx[Instance].BppFactor);
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Draws a pixel on LCD.
+  * @param  Instance    LCD Instance
+  * @param  Xpos X position
+  * @param  Ypos Y position
+  * @param  Color Pixel color
+  * @retval BSP status
+  */
+int32_t BSP_LCD_WritePixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Color)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  uint32_t address;
+
+  if ((Instance >= LCD_INSTANCES_NBR) || (Xpos >= LL_GetWidth(Instance)) || (Ypos >= LL_GetHeight(Instance)))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    /* Refreshes the cached frame buffer address */
+    ret = LL_GetPixelAddress(Instance, Xpos, Ypos, &address, NULL, NULL);
+
+#if (USE_BSP_LCD_DMA2D_ASYNC == 1)
+    if (ret == BSP_ERROR_NONE)
+    {
+      /* Frame buffer is accessed by CPU: wait for the queued DMA2D jobs,
+         including the back buffer refresh queued by the address lookup */
+      ret = BSP_LCD_WaitFence(Instance, Lcd_Dma2dSubmitted, LCD_DMA2D_TIMEOUT);
+    }
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
+
+    if (ret == BSP_ERROR_NONE)
+    {
+      /* Write data value to RAM memory */
+      LL_WriteRawPixel(address, Lcd_Ctx[Instance].BppFactor, Color);
+      LL_MarkDirty(Instance, Xpos, Ypos, 1U, 1U);
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Reads a horizontal span of pixels from the active layer.
+  * @param  Instance LCD Instance
+  * @param  Xpos X position of the first pixel
+  * @param  Ypos Y position
+  * @param  pColors Pointer to the pixel colors, one word per pixel in the
+  *         layer pixel format (CLUT index for L8 and AL44 layers)
+  * @param  Length Number of pixels, the span must fit in the layer line
+  * @retval BSP status
+  */
+int32_t BSP_LCD_ReadSpan(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t *pColors, uint32_t Length)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  uint32_t i;
+  uint32_t address;
+  int32_t  step;
+
+  if ((Instance >= LCD_INSTANCES_NBR) || (pColors == NULL) || (Ypos >= LL_GetHeight(Instance)) ||
+      (Xpos > LL_GetWidth(Instance)) || (Length > (LL_GetWidth(Instance) - Xpos)))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    ret = LL_GetPixelAddress(Instance, Xpos, Ypos, &address, &step, NULL);
+
+#if (USE_BSP_LCD_DMA2D_ASYNC == 1)
+    if (ret == BSP_ERROR_NONE)
+    {
+      /* Frame buffer is accessed by CPU: wait for the queued DMA2D jobs,
+         including the back buffer refresh queued by the address lookup */
+      ret = BSP_LCD_WaitFence(Instance, Lcd_Dma2dSubmitted, LCD_DMA2D_TIMEOUT);
+    }
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
+
+    if (ret == BSP_ERROR_NONE)
+    {
+      if (step == 4)
+      {
+        LL_CPU_CopyLine((uint32_t)pColors, (const uint8_t *)address, 4U * Length);
+      }
+      else
+      {
+        /* Layer pixels narrower than a word or rotated span */
+        for (i = 0U; i < Length; i++)
+        {
+          pColors[i] = LL_ReadRawPixel(address, Lcd_Ctx[Instance].BppFactor);
+          address += (uint32_t)step;
+        }
+      }
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Writes a horizontal span of pixels in the active layer.
+  * @param  Instance LCD Instance
+  * @param  Xpos X position of the first pixel
+  * @param  Ypos Y position
+  * @param  pColors Pointer to the pixel colors, one word per pixel in the
+  *         layer pixel format (CLUT index for L8 and AL44 layers)
+  * @param  Length Number of pixels, the span must fit in the layer line
+  * @retval BSP status
+  */
+int32_t BSP_LCD_WriteSpan(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, const uint32_t *pColors, uint32_t Length)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  uint32_t i = 0U;
+  uint32_t address;
+  int32_t  step;
+  uint16_t *pfb16;
+
+  if ((Instance >= LCD_INSTANCES_NBR) || (pColors == NULL) || (Ypos >= LL_GetHeight(Instance)) ||
+      (Xpos > LL_GetWidth(Instance)) || (Length > (LL_GetWidth(Instance) - Xpos)))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    ret = LL_GetPixelAddress(Instance, Xpos, Ypos, &address, &step, NULL);
+
+#if (USE_BSP_LCD_DMA2D_ASYNC == 1)
+    if (ret == BSP_ERROR_NONE)
+    {
+      /* Frame buffer is accessed by CPU: wait for the queued DMA2D jobs,
+         including the back buffer refresh queued by the address lookup */
+      ret = BSP_LCD_WaitFence(Instance, Lcd_Dma2dSubmitted, LCD_DMA2D_TIMEOUT);
+    }
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
+
+    if (ret == BSP_ERROR_NONE)
+    {
+      if (step == 4)
+      {
+        LL_CPU_CopyLine(address, (const uint8_t *)pColors, 4U * Length);
+      }
+      else if (step != 2)
+      {
+        /* 8-bit or 24-bit layer, or rotated span */
+        for (i = 0U; i < Length; i++)
+        {
+          LL_WriteRawPixel(address, Lcd_Ctx[Instance].BppFactor, pColors[i]);
+          address += (uint32_t)step;
+        }
+      }
+      else
+      {
+        pfb16 = (uint16_t *)address;
+
+        /* Align on a word, then store two pixels per word */
+        if (((address & 3U) != 0U) && (Length != 0U))
+        {
+          pfb16[0] = (uint16_t)pColors[0];
+          i = 1U;
+        }
+        for (; (i + 1U) < Length; i += 2U)
+        {
+          *(uint32_t *)&pfb16[i] = PACKRGB565(pColors[i] & 0xFFFFU, pColors[i + 1U]);
+        }
+        if (i < Length)
+        {
+          pfb16[i] = (uint16_t)pColors[i];
+        }
+      }
+      LL_MarkDirty(Instance, Xpos, Ypos, Length, 1U);
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Blends a rectangle of pixels over the active layer with DMA2D.
+  * @param  Instance LCD Instance
+  * @param  Xpos X position
+  * @param  Ypos Y position
+  * @param  pData Pointer to the foreground pixels, lines are contiguous
+  * @param  Width Rectangle width
+  * @param  Height Rectangle height
+  * @param  InputColorMode Foreground format: BSP_LCD_INPUT_ARGB8888,
+  *         BSP_LCD_INPUT_RGB888, BSP_LCD_INPUT_RGB565 or BSP_LCD_INPUT_L8
+  *         (CLUT set with BSP_LCD_SetCLUT())
+  * @param  Alpha Constant alpha (0 to 255), combined with the per-pixel alpha
+  * @retval BSP status
+  */
+int32_t BSP_LCD_BlendRGBRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t Width,
+                             uint32_t Height, uint32_t InputColorMode, uint32_t Alpha)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  uint32_t address;
+  uint32_t stats_start;
+  LCD_DMA2D_Job_t job;
+
+  LCD_STATS_START(stats_start);
+
+  if ((Instance >= LCD_INSTANCES_NBR) || (pData == NULL) || (Alpha > 0xFFU))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if ((InputColorMode != DMA2D_INPUT_ARGB8888) && (InputColorMode != DMA2D_INPUT_RGB888) &&
+           (InputColorMode != DMA2D_INPUT_RGB565) && (InputColorMode != DMA2D_INPUT_L8))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }/* The rectangle must fit in the display */
+  else if ((Width > LL_GetWidth(Instance)) || (Xpos > (LL_GetWidth(Instance) - Width)) ||
+           (Height > LL_GetHeight(Instance)) || (Ypos > (LL_GetHeight(Instance) - Height)))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if (Lcd_Ctx[Instance].BppFactor == 1U)
+  {
+    /* 8-bit layers cannot be blended */
+    ret = BSP_ERROR_FEATURE_NOT_SUPPORTED;
+  }
+  else
+  {
+#if (USE_BSP_CPU_CACHE_MAINTENANCE == 1)
+    SCB_CleanDCache_by_Addr((uint32_t *)pData, (LL_GetInputBits(InputColorMode) * Width * Height) / 8U);
+#endif /* USE_BSP_CPU_CACHE_MAINTENANCE */
+
+    ret = LL_GetDrawAddress(Instance, &address);
+
+    job.Mode            = DMA2D_M2M_BLEND;
+    job.OutputColorMode = LL_GetOutputColorMode(Instance);
+    job.OutputOffset    = Lcd_Ctx[Instance].XSize - Width;
+    job.InputColorMode  = InputColorMode;
+    job.InputOffset     = 0;
+    job.AlphaMode       = DMA2D_COMBINE_ALPHA;
+    job.InputAlpha      = Alpha;
+    job.Src             = (uint32_t)pData;
+    job.Dst             = address + (Lcd_Ctx[Instance].BppFactor*((Lcd_Ctx[Instance].XSize*Ypos) + Xpos));
+    job.Width           = Width;
+    job.Height          = Height;
+    job.SrcPitch        = 0;
+    job.DstPitch        = 0;
+
+    if (ret == BSP_ERROR_NONE)
+    {
+      ret = LL_SubmitRect(Instance, &job, Xpos, Ypos);
+    }
+
+    if (ret == BSP_ERROR_NONE)
+    {
+      LL_MarkDirty(Instance, Xpos, Ypos, Width, Height);
+      LCD_STATS_STOP(BSP_LCD_STATS_BLEND, stats_start, Width * Height);
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Draws an alpha bitmap (anti-aliased glyph, icon mask) with a color
+  *         blended over the active layer with DMA2D.
+  * @param  Instance LCD Instance
+  * @param  Xpos X position
+  * @param  Ypos Y position
+  * @param  pMask Pointer to the alpha values, each line starts on a byte
+  * @param  Width Bitmap width
+  * @param  Height Bitmap height
+  * @param  MaskFormat BSP_LCD_INPUT_A8 or BSP_LCD_INPUT_A4 (first pixel in the
+  *         low nibble)
+  * @param  Color Color in the layer pixel format. For ARGB8888 and ARGB4444
+  *         layers, the color alpha is combined with the mask.
+  * @retval BSP status
+  */
+int32_t BSP_LCD_DrawAlphaBitmap(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pMask, uint32_t Width,
+                                uint32_t Height, uint32_t MaskFormat, uint32_t Color)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  uint32_t line_size;
+  uint32_t address;
+  uint32_t stats_start;
+  LCD_DMA2D_Job_t job;
+
+  LCD_STATS_START(stats_start);
+
+  if ((Instance >= LCD_INSTANCES_NBR) || (pMask == NULL) ||
+      ((MaskFormat != DMA2D_INPUT_A8) && (MaskFormat != DMA2D_INPUT_A4)))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }/* The bitmap must fit in the display */
+  else if ((Width > LL_GetWidth(Instance)) || (Xpos > (LL_GetWidth(Instance) - Width)) ||
+           (Height > LL_GetHeight(Instance)) || (Ypos > (LL_GetHeight(Instance) - Height)))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if (Lcd_Ctx[Instance].BppFactor == 1U)
+  {
+    /* 8-bit layers cannot be blended */
+    ret = BSP_ERROR_FEATURE_NOT_SUPPORTED;
+  }
+  else
+  {
+    line_size = (MaskFormat == DMA2D_INPUT_A8) ? Width : ((Width + 1U) / 2U);
+
+#if (USE_BSP_CPU_CACHE_MAINTENANCE == 1)
+    SCB_CleanDCache_by_Addr((uint32_t *)pMask, line_size * Height);
+#endif /* USE_BSP_CPU_CACHE_MAINTENANCE */
+
+    ret = LL_GetDrawAddress(Instance, &address);
+
+    job.Mode            = DMA2D_M2M_BLEND;
+    job.InputColorMode  = MaskFormat;
+    job.InputOffset     = 0;
+    job.AlphaMode       = DMA2D_COMBINE_ALPHA;
+    job.Src             = (uint32_t)pMask;
+    job.Dst             = address + (Lcd_Ctx[Instance].BppFactor*((Lcd_Ctx[Instance].XSize*Ypos) + Xpos));
+    job.Width           = Width;
+    job.Height          = Height;
+
+    /* Foreground color and constant alpha are given in ARGB8888 */
+    job.OutputColorMode = LL_GetOutputColorMode(Instance);
+    job.InputAlpha      = LL_ConvertToARGB8888(Instance, Color);
+
+    if ((MaskFormat == DMA2D_INPUT_A4) && ((Width & 1U) != 0U))
+    {
+      /* Odd A4 lines start on a byte: lines are blended one by one */
+      job.OutputOffset = 0;
+      job.SrcPitch     = (int32_t)line_size;
+      job.DstPitch     = Lcd_Ctx[Instance].XSize * Lcd_Ctx[Instance].BppFactor;
+    }
+    else
+    {
+      job.OutputOffset = Lcd_Ctx[Instance].XSize - Width;
+      job.SrcPitch     = 0;
+      job.DstPitch     = 0;
+    }
+
+    if (ret == BSP_ERROR_NONE)
+    {
+      ret = LL_SubmitRect(Instance, &job, Xpos, Ypos);
+    }
+
+    if (ret == BSP_ERROR_NONE)
+    {
+      LL_MarkDirty(Instance, Xpos, Ypos, Width, Height);
+      LCD_STATS_STOP(BSP_LCD_STATS_BLEND, stats_start, Width * Height);
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Loads the color lookup table used to convert L8 pixels.
+  * @param  Instance LCD Instance
+  * @param  pCLUT Pointer to the ARGB8888 CLUT, it must stay valid while L8
+  *         pixels are drawn
+  * @param  Size Number of CLUT entries (1 to 256)
+  * @retval BSP status
+  */
+int32_t BSP_LCD_SetCLUT(uint32_t Instance, const uint32_t *pCLUT, uint32_t Size)
+{
+  int32_t ret = BSP_ERROR_NONE;
+#if (USE_BSP_LCD_CPU_RENDERING == 0)
+  DMA2D_CLUTCfgTypeDef clut_cfg;
+#endif /* USE_BSP_LCD_CPU_RENDERING */
+
+  if ((Instance >= LCD_INSTANCES_NBR) || (pCLUT == NULL) || (Size == 0U) || (Size > 256U))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    /* Also used by the CPU for rotated drawing */
+    Lcd_Clut = pCLUT;
+
+#if (USE_BSP_LCD_CPU_RENDERING == 0)
+#if (USE_BSP_LCD_DMA2D_ASYNC == 1)
+    /* CLUT cannot be loaded while queued jobs use it */
+    (void)BSP_LCD_WaitFence(Instance, Lcd_Dma2dSubmitted, LCD_DMA2D_TIMEOUT);
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
+
+#if (USE_BSP_CPU_CACHE_MAINTENANCE == 1)
+    SCB_CleanDCache_by_Addr((uint32_t *)pCLUT, 4U * Size);
+#endif /* USE_BSP_CPU_CACHE_MAINTENANCE */
+
+    clut_cfg.pCLUT         = (uint32_t *)pCLUT;
+    clut_cfg.CLUTColorMode = DMA2D_CCM_ARGB8888;
+    clut_cfg.Size          = Size - 1U;
+
+    hlcd_dma2d.Instance = DMA2D;
+    if (HAL_DMA2D_CLUTStartLoad(&hlcd_dma2d, &clut_cfg, 1) != HAL_OK)
+    {
+      ret = BSP_ERROR_PERIPH_FAILURE;
+    }
+    else if (HAL_DMA2D_PollForTransfer(&hlcd_dma2d, 50) != HAL_OK)
+    {
+      ret = BSP_ERROR_PERIPH_FAILURE;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+#endif /* USE_BSP_LCD_CPU_RENDERING */
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Selects the font used by the text APIs.
+  * @param  Instance LCD Instance
+  * @param  pFont Pointer to the font, it must stay valid while it is selected
+  * @retval BSP status
+  */
+int32_t BSP_LCD_SetFont(uint32_t Instance, const BSP_LCD_Font_t *pFont)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  if ((Instance >= LCD_INSTANCES_NBR) || (pFont == NULL) || (pFont->pAtlas == NULL) ||
+      (pFont->pGlyphs == NULL) || (pFont->LineHeight == 0U))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    Lcd_Font[Instance] = pFont;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Gets the width of a string drawn with the selected font.
+  * @param  Instance LCD Instance
+  * @param  pText Pointer to the NUL terminated string
+  * @param  Width Pointer to the width in pixels
+  * @retval BSP status
+  */
+int32_t BSP_LCD_GetStringWidth(uint32_t Instance, const char *pText, uint32_t *Width)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  uint32_t length = 0U;
+
+  if ((Instance >= LCD_INSTANCES_NBR) || (pText == NULL) || (Width == NULL))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if (Lcd_Font[Instance] == NULL)
+  {
+    ret = BSP_ERROR_NO_INIT;
+  }
+  else
+  {
+    while (pText[length] != '\0')
+    {
+      length++;
+    }
+    *Width = LL_GetRunWidth(Lcd_Font[Instance], pText, length);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Draws a string with the selected font. The glyphs are blended one
+  *         by one from the atlas. When USE_BSP_LCD_TEXT_CACHE is set to 1, they
+  *         are composed in an A8 glyph run blended by a single DMA2D job and
+  *         recently drawn strings are kept in a LRU cache of LCD_TEXT_CACHE_NBR
+  *         runs so that the atlas is not read again (strings longer than
+  *         LCD_TEXT_MAX_LENGTH or larger than LCD_TEXT_RUN_SIZE are still
+  *         blended glyph by glyph). Glyphs are clipped to the display.
+  * @param  Instance LCD Instance
+  * @param  Xpos X position of the string left side
+  * @param  Ypos Y position of the line top
+  * @param  pText Pointer to the NUL terminated string, characters missing
+  *         in the font are skipped
+  * @param  Color Text color in the layer pixel format
+  * @retval BSP status
+  */
+int32_t BSP_LCD_DrawString(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, const char *pText, uint32_t Color)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  uint32_t length = 0U, width, i, pen;
+  const BSP_LCD_Font_t *font;
+  const BSP_LCD_Glyph_t *glyph;
+#if (USE_BSP_LCD_TEXT_CACHE == 1)
+  LCD_TextRun_t *run;
+#endif /* USE_BSP_LCD_TEXT_CACHE */
+  uint32_t stats_start;
+
+  LCD_STATS_START(stats_start);
+
+  if ((Instance >= LCD_INSTANCES_NBR) || (pText == NULL))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if (Lcd_Font[Instance] == NULL)
+  {
+    ret = BSP_ERROR_NO_INIT;
+  }
+  else
+  {
+    font = Lcd_Font[Instance];
+    while (pText[length] != '\0')
+    {
+      length++;
+    }
+    width = LL_GetRunWidth(font, pText, length);
+
+#if (USE_BSP_LCD_TEXT_CACHE == 1)
+    if ((length <= LCD_TEXT_MAX_LENGTH) && ((width * font->LineHeight) <= LCD_TEXT_RUN_SIZE))
+    {
+      if (width != 0U)
+      {
+        run = LL_GetTextRun(Instance, font, pText, length, width);
+
+        ret = LL_BlendTextMask(Instance, (int32_t)Xpos, (int32_t)Ypos, run->Run, run->Width, run->Height, Color);
+        run->Fence = Lcd_Dma2dSubmitted;
+      }
+    }
+    else
+#endif /* USE_BSP_LCD_TEXT_CACHE */
+    {
+      /* Glyph by glyph, bitmaps are read from the atlas */
+      pen = Xpos;
+      for (i = 0U; (i < length) && (ret == BSP_ERROR_NONE); i++)
+      {
+        glyph = LL_GetGlyph(font, (uint8_t)pText[i]);
+        if (glyph != NULL)
+        {
+          ret = LL_BlendTextMask(Instance, (int32_t)pen + glyph->XOffset, (int32_t)Ypos + glyph->YOffset,
+                                 &font->pAtlas[glyph->Offset], glyph->Width, glyph->Height, Color);
+          pen += glyph->Advance;
+        }
+      }
+    }
+
+    if (ret == BSP_ERROR_NONE)
+    {
+      LCD_STATS_STOP(BSP_LCD_STATS_TEXT, stats_start, width * font->LineHeight);
+    }
+  }
+
+  return ret;
+}
+
+#if (USE_BSP_LCD_STATS == 1)
+/**
+  * @brief  Clears the rendering statistics and starts the DWT cycle counter.
+  * @param  Instance LCD Instance
+  * @retval BSP status
+  */
+int32_t BSP_LCD_ResetStats(uint32_t Instance)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  uint32_t i, bin;
+
+  if (Instance >= LCD_INSTANCES_NBR)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    for (i = 0U; i < BSP_LCD_STATS_NBR; i++)
+    {
+      Lcd_Stats[i].Count       = 0U;
+      Lcd_Stats[i].MinCycles   = 0xFFFFFFFFU;
+      Lcd_Stats[i].MaxCycles   = 0U;
+      Lcd_Stats[i].TotalCycles = 0U;
+      Lcd_Stats[i].Pixels      = 0U;
+      for (bin = 0U; bin < BSP_LCD_STATS_BINS; bin++)
+      {
+        Lcd_Stats[i].Histogram[bin] = 0U;
+      }
+    }
+
+    /* Enable the cycle counter */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->LAR   = 0xC5ACCE55U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Gets the rendering statistics of a primitive. The throughput in
+  *         pixels per second is Pixels * SystemCoreClock / TotalCycles. With
+  *         USE_BSP_LCD_DMA2D_ASYNC, the latencies only cover the job submission.
+  * @param  Instance LCD Instance
+  * @param  Primitive BSP_LCD_STATS_xxx
+  * @param  pStats Pointer to the statistics
+  * @retval BSP status
+  */
+int32_t BSP_LCD_GetStats(uint32_t Instance, uint32_t Primitive, BSP_LCD_Stats_t *pStats)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  if ((Instance >= LCD_INSTANCES_NBR) || (Primitive >= BSP_LCD_STATS_NBR) || (pStats == NULL))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    *pStats = Lcd_Stats[Primitive];
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Gets a latency percentile of a primitive from its histogram.
+  * @param  Instance LCD Instance
+  * @param  Primitive BSP_LCD_STATS_xxx
+  * @param  Percent Percentile (1 to 100)
+  * @param  Cycles Pointer to the latency, upper bound of the histogram bin
+  *         holding the percentile, limited to the max latency
+  * @retval BSP status
+  */
+int32_t BSP_LCD_GetLatencyPercentile(uint32_t Instance, uint32_t Primitive, uint32_t Percent, uint32_t *Cycles)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  uint32_t bin, rank, count = 0U;
+  const BSP_LCD_Stats_t *stats;
+
+  if ((Instance >= LCD_INSTANCES_NBR) || (Primitive >= BSP_LCD_STATS_NBR) || (Cycles == NULL) ||
+      (Percent == 0U) || (Percent > 100U))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if (Lcd_Stats[Primitive].Count == 0U)
+  {
+    ret = BSP_ERROR_NO_INIT;
+  }
+  else
+  {
+    stats = &Lcd_Stats[Primitive];
+    rank  = (uint32_t)((((uint64_t)stats->Count * Percent) + 99U) / 100U);
+
+    for (bin = 0U; bin < (BSP_LCD_STATS_BINS - 1U); bin++)
+    {
+      count += stats->Histogram[bin];
+      if (count >= rank)
+      {
+        break;
+      }
+    }
+
+    *Cycles = (bin < 31U) ? ((2UL << bin) - 1UL) : 0xFFFFFFFFU;
+    *Cycles = LCD_MIN(*Cycles, stats->MaxCycles);
+  }
+
+  return ret;
+}
+#endif /* USE_BSP_LCD_STATS */
+
+/**
+  * @brief  Gets the fence of the last DMA2D job submitted by the draw APIs.
+  * @param  Instance LCD Instance
+  * @param  Fence    Pointer to the fence value
+  * @retval BSP status
+  */
+int32_t BSP_LCD_GetFence(uint32_t Instance, uint32_t *Fence)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  if ((Instance >= LCD_INSTANCES_NBR) || (Fence == NULL))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    *Fence = Lcd_Dma2dSubmitted;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Waits until all the DMA2D jobs up to a fence are completed.
+  * @param  Instance LCD Instance
+  * @param  Fence    Fence value returned by BSP_LCD_GetFence()
+  * @param  Timeout  Timeout in ms
+  * @retval BSP status
+  */
+int32_t BSP_LCD_WaitFence(uint32_t Instance, uint32_t Fence, uint32_t Timeout)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  uint32_t tickstart;
+
+  if (Instance >= LCD_INSTANCES_NBR)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    tickstart = HAL_GetTick();
+
+    /* Fences are free running counters: compare them with a signed difference */
+    while ((int32_t)(Lcd_Dma2dCompleted - Fence) < 0)
+    {
+      if ((HAL_GetTick() - tickstart) > Timeout)
+      {
+        ret = BSP_ERROR_BUSY;
+        break;
+      }
+    }
+  }
+
+  return ret;
+}
+
+#if (USE_BSP_LCD_DMA2D_ASYNC == 1)
+/**
+  * @brief  This function handles DMA2D interrupt request.
+  * @param  Instance LCD Instance
+  * @retval None
+  */
+void BSP_LCD_DMA2D_IRQHandler(uint32_t Instance)
+{
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(Instance);
+
+  HAL_DMA2D_IRQHandler(&hlcd_dma2d);
+}
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
+
+/**
+  * @brief  Configures the frame buffers of a layer. The current layer address
+  *         is used as first buffer, the other ones are taken from the PSRAM
+  *         frame buffer pool. The draw APIs then render into the back buffer.
+  * @param  Instance   LCD Instance
+  * @param  LayerIndex Layer index
+  * @param  NbBuffers  Number of frame buffers: 2 (double buffering) up to
+  *                    LCD_FB_MAX_BUFFERS, 0 or 1 to disable the manager
+  * @note   LTDC interrupt is enabled: BSP_LCD_LTDC_IRQHandler() must be called
+  *         from LTDC_IRQHandler().
+  * @retval BSP status
+  */
+int32_t BSP_LCD_ConfigFrameBuffers(uint32_t Instance, uint32_t LayerIndex, uint32_t NbBuffers)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  uint32_t i;
+  LCD_Rect_t full;
+  LCD_FB_Ctx_t *fb;
+
+  if ((Instance >= LCD_INSTANCES_NBR) || (LayerIndex >= MAX_LAYER) || (NbBuffers > LCD_FB_MAX_BUFFERS))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if ((Lcd_Fb[Instance].NbBuffers > 1U) && (Lcd_Fb[Instance].PendingIndex != LCD_FB_NONE))
+  {
+    ret = BSP_ERROR_BUSY;
+  }
+  else
+  {
+    fb = &Lcd_Fb[Instance];
+
+#if (USE_BSP_LCD_DMA2D_ASYNC == 1)
+    /* Queued DMA2D jobs target the current buffers */
+    (void)BSP_LCD_WaitFence(Instance, Lcd_Dma2dSubmitted, LCD_DMA2D_TIMEOUT);
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
+
+    fb->LayerIndex   = LayerIndex;
+    fb->PendingIndex = LCD_FB_NONE;
+    fb->FrontIndex   = 0U;
+    fb->BackIndex    = (NbBuffers > 1U) ? 1U : 0U;
+    fb->Address[0]   = hlcd_ltdc.LayerCfg[LayerIndex].FBStartAdress;
+    fb->DirtyNbr[0]  = 0U;
+
+    /* The back buffers are filled from the displayed one before the first draw */
+    fb->SyncIndex    = (NbBuffers > 1U) ? 0U : LCD_FB_NONE;
+    full.X0 = 0U;
+    full.Y0 = 0U;
+    full.X1 = Lcd_Ctx[Instance].XSize;
+    full.Y1 = Lcd_Ctx[Instance].YSize;
+
+    /* Each layer owns (LCD_FB_MAX_BUFFERS - 1) slots of the pool */
+    for (i = 1U; i < NbBuffers; i++)
+    {
+      fb->Address[i] = LCD_FRAME_BUFFER_POOL_ADDRESS + \
+                       ((((LayerIndex * (LCD_FB_MAX_BUFFERS - 1U)) + i) - 1U) * LCD_FRAME_BUFFER_SIZE);
+      fb->Dirty[i][0] = full;
+      fb->DirtyNbr[i] = 1U;
+    }
+
+    if (NbBuffers > 1U)
+    {
+#if (USE_HAL_LTDC_REGISTER_CALLBACKS == 1)
+      if (HAL_LTDC_RegisterCallback(&hlcd_ltdc, HAL_LTDC_RELOAD_EVENT_CB_ID, BSP_LCD_ReloadEventCallback) != HAL_OK)
+      {
+        ret = BSP_ERROR_PERIPH_FAILURE;
+      }
+#endif /* USE_HAL_LTDC_REGISTER_CALLBACKS */
+
+      /* Flips are completed in the LTDC reload interrupt */
+      HAL_NVIC_SetPriority(LTDC_IRQn, BSP_LCD_LTDC_IT_PRIORITY, 0);
+      HAL_NVIC_EnableIRQ(LTDC_IRQn);
+    }
+
+    fb->NbBuffers = (ret == BSP_ERROR_NONE) ? NbBuffers : 0U;
+    Lcd_Ctx[Instance].FbAddress = 0U;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Gets the address of the buffer written by the draw APIs.
+  * @param  Instance LCD Instance
+  * @param  Address  Pointer to the back buffer address
+  * @retval BSP status, BSP_ERROR_BUSY when the back buffer is still displayed
+  */
+int32_t BSP_LCD_GetBackBuffer(uint32_t Instance, uint32_t *Address)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  if ((Instance >= LCD_INSTANCES_NBR) || (Address == NULL))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    ret = LL_GetDrawAddress(Instance, Address);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Declares an area of the back buffer written without the draw APIs
+  *         so that it is copied to the other buffers after the next swaps.
+  * @param  Instance LCD Instance
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  Width    Area width
+  * @param  Height   Area height
+  * @retval BSP status
+  */
+int32_t BSP_LCD_InvalidateRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  if (Instance >= LCD_INSTANCES_NBR)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    LL_MarkDirty(Instance, Xpos, Ypos, Width, Height);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Requests the display of the back buffer. The layer address is
+  *         reloaded during the next vertical blanking and
+  *         BSP_LCD_FrameCompleteCallback() is called once it is displayed.
+  *         The function does not wait for the vertical blanking.
+  * @param  Instance LCD Instance
+  * @retval BSP status, BSP_ERROR_BUSY if the previous flip is still pending
+  */
+int32_t BSP_LCD_SwapBuffers(uint32_t Instance)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  uint32_t stats_start;
+  LCD_FB_Ctx_t *fb;
+
+  LCD_STATS_START(stats_start);
+
+  if (Instance >= LCD_INSTANCES_NBR)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if (Lcd_Fb[Instance].NbBuffers < 2U)
+  {
+    ret = BSP_ERROR_NO_INIT;
+  }
+  else if (Lcd_Fb[Instance].PendingIndex != LCD_FB_NONE)
+  {
+    ret = BSP_ERROR_BUSY;
+  }
+  else
+  {
+    fb = &Lcd_Fb[Instance];
+
+    if (fb->SyncIndex != LCD_FB_NONE)
+    {
+      /* Nothing was drawn since the last swap: refresh the back buffer first */
+      ret = LL_SyncBackBuffer(Instance);
+    }
+
+#if (USE_BSP_LCD_DMA2D_ASYNC == 1)
+    if (ret == BSP_ERROR_NONE)
+    {
+      /* The back buffer must be fully rendered before being displayed */
+      ret = BSP_LCD_WaitFence(Instance, Lcd_Dma2dSubmitted, LCD_DMA2D_TIMEOUT);
+    }
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
+
+    if (ret != BSP_ERROR_NONE)
+    {
+      /* The back buffer is not ready: it is not displayed */
+    }
+    else if (HAL_LTDC_SetAddress_NoReload(&hlcd_ltdc, fb->Address[fb->BackIndex], fb->LayerIndex) != HAL_OK)
+    {
+      ret = BSP_ERROR_PERIPH_FAILURE;
+    }
+    else
+    {
+      /* Next frame is rendered in the following buffer, its dirty areas are
+         refreshed from the flipped one before the first draw */
+      fb->PendingIndex = fb->BackIndex;
+      fb->SyncIndex    = fb->BackIndex;
+      fb->BackIndex    = (fb->BackIndex + 1U) % fb->NbBuffers;
+      Lcd_Ctx[Instance].FbAddress = 0U;
+
+      if (HAL_LTDC_Reload(&hlcd_ltdc, LTDC_RELOAD_VERTICAL_BLANKING) != HAL_OK)
+      {
+        fb->PendingIndex = LCD_FB_NONE;
+        ret = BSP_ERROR_PERIPH_FAILURE;
+      }
+      else
+      {
+        LCD_STATS_STOP(BSP_LCD_STATS_RELOAD, stats_start, 0U);
+      }
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  This function handles LTDC interrupt request.
+  * @param  Instance LCD Instance
+  * @retval None
+  */
+void BSP_LCD_LTDC_IRQHandler(uint32_t Instance)
+{
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(Instance);
+
+  HAL_LTDC_IRQHandler(&hlcd_ltdc);
+}
+
+/**
+  * @brief  Frame complete callback: the buffer requested by
+  *         BSP_LCD_SwapBuffers() is now displayed.
+  * @param  Instance LCD Instance
+  * @retval None
+  */
+__weak void BSP_LCD_FrameCompleteCallback(uint32_t Instance)
+{
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(Instance);
+
+  /* This function should be implemented by the user application.
+     It is called into this driver when a buffer flip is completed. */
+}
+
+/**
+  * @brief  LTDC reload event callback: the pending buffer is now displayed.
+  *         It is registered in the LTDC handle when
+  *         USE_HAL_LTDC_REGISTER_CALLBACKS is set to 1, otherwise it must be
+  *         called from the application HAL_LTDC_ReloadEventCallback().
+  * @param  hltdc LTDC handle
+  * @retval None
+  */
+void BSP_LCD_ReloadEventCallback(LTDC_HandleTypeDef *hltdc)
+{
+  uint32_t instance;
+
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(hltdc);
+
+  for (instance = 0U; instance < LCD_INSTANCES_NBR; instance++)
+  {
+    if ((Lcd_Fb[instance].NbBuffers > 1U) && (Lcd_Fb[instance].PendingIndex != LCD_FB_NONE))
+    {
+      Lcd_Fb[instance].FrontIndex   = Lcd_Fb[instance].PendingIndex;
+      Lcd_Fb[instance].PendingIndex = LCD_FB_NONE;
+
+      BSP_LCD_FrameCompleteCallback(instance);
+    }
+  }
+}
+
+/**
+  * @}
+  */
+
+/** @defgroup STM32H7S78_DK_LCD_Private_Functions STM32H7S78_DK LCD Private Functions
+  * @{
+  */
+/**
+  * @brief  Fills a buffer.
+  * @param  Instance LCD Instance
+  * @param  pDst Pointer to destination buffer
+  * @param  xSize Buffer width
+  * @param  ySize Buffer height
+  * @param  OffLine Offset
+  * @param  Color RGB color
+  * @retval BSP status
+  */
+static int32_t LL_FillBuffer(uint32_t Instance, uint32_t *pDst, uint32_t xSize, uint32_t ySize, uint32_t OffLine, uint32_t Color)
+{
+  LCD_DMA2D_Job_t job;
+
+  /* Register to memory mode with ARGB8888 as color Mode, 8-bit layers are
+     filled by CPU with the raw index */
+  job.Mode            = DMA2D_R2M;
+  job.OutputColorMode = LL_GetOutputColorMode(Instance);
+  job.OutputOffset    = OffLine;
+  job.InputColorMode  = DMA2D_INPUT_ARGB8888;
+  job.InputOffset     = 0;
+  job.AlphaMode       = DMA2D_NO_MODIF_ALPHA;
+  job.InputAlpha      = 0xFFU;
+  job.Src             = (Lcd_Ctx[Instance].BppFactor == 1U) ? Color : LL_ConvertToARGB8888(Instance, Color);
+  job.Dst             = (uint32_t)pDst;
+  job.Width           = xSize;
+  job.Height          = ySize;
+  job.SrcPitch        = 0;
+  job.DstPitch        = 0;
+
+  return LL_DMA2D_Submit(Instance, &job);
+}
+
+/**
+  * @brief  Converts a rectangle to the layer pixel format with a single DMA2D job.
+  * @param  Instance LCD Instance
+  * @param  pSrc Pointer to the first source line
+  * @param  Xpos X position
+  * @param  Ypos Y position
+  * @param  xSize Rectangle width
+  * @param  ySize Rectangle height
+  * @param  SrcPitch Signed distance in bytes between two consecutive source lines
+  * @param  ColorMode Input color mode
+  * @retval BSP status
+  */
+static int32_t LL_ConvertRectToRGB(uint32_t Instance, uint8_t *pSrc, uint32_t Xpos, uint32_t Ypos, uint32_t xSize, uint32_t ySize, int32_t SrcPitch, uint32_t ColorMode)
+{
+  int32_t ret;
+  uint32_t input_bpp;
+  uint32_t address;
+  LCD_DMA2D_Job_t job;
+
+  input_bpp = LL_GetInputBits(ColorMode) / 8U;
+  ret = LL_GetDrawAddress(Instance, &address);
+
+  job.Mode            = DMA2D_M2M_PFC;
+  job.OutputColorMode = LL_GetOutputColorMode(Instance);
+  job.InputColorMode  = ColorMode;
+  job.AlphaMode       = DMA2D_NO_MODIF_ALPHA;
+  job.InputAlpha      = 0xFFU;
+  job.Src             = (uint32_t)pSrc;
+  job.Dst             = address + (Lcd_Ctx[Instance].BppFactor*((Lcd_Ctx[Instance].XSize*Ypos) + Xpos));
+  job.Width           = xSize;
+  job.Height          = ySize;
+
+  if ((SrcPitch > 0) && (((uint32_t)SrcPitch % input_bpp) == 0U))
+  {
+    /* Lines are stored top-down on whole pixels: single 2D transfer */
+    job.OutputOffset = Lcd_Ctx[Instance].XSize - xSize;
+    job.InputOffset  = ((uint32_t)SrcPitch / input_bpp) - xSize;
+    job.SrcPitch     = 0;
+    job.DstPitch     = 0;
+  }
+  else
+  {
+    /* DMA2D line offsets cannot be negative nor partial pixels: DMA2D is
+       configured once and restarted for each line with new addresses only */
+    job.OutputOffset = 0;
+    job.InputOffset  = 0;
+    job.SrcPitch     = SrcPitch;
+    job.DstPitch     = Lcd_Ctx[Instance].XSize * Lcd_Ctx[Instance].BppFactor;
+  }
+
+  if (ret == BSP_ERROR_NONE)
+  {
+    ret = LL_SubmitRect(Instance, &job, Xpos, Ypos);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Fills a rectangle given in drawing coordinates.
+  * @param  Instance LCD Instance
+  * @param  Xpos X position
+  * @param  Ypos Y position
+  * @param  Width Rectangle width
+  * @param  Height Rectangle height
+  * @param  Color Color in the layer pixel format
+  * @retval BSP status
+  */
+static int32_t LL_FillRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Color)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  uint32_t x = Xpos, y = Ypos, width = Width, height = Height;
+  uint32_t address;
+
+  if (Lcd_Ctx[Instance].Orientation != LCD_ORIENTATION_LANDSCAPE)
+  {
+    /* Clip the rectangle before the transformation to the panel coordinates */
+    width  = ((x < LL_GetWidth(Instance))  && (width > (LL_GetWidth(Instance) - x)))   ? (LL_GetWidth(Instance) - x)  : width;
+    height = ((y < LL_GetHeight(Instance)) && (height > (LL_GetHeight(Instance) - y))) ? (LL_GetHeight(Instance) - y) : height;
+    if ((x >= LL_GetWidth(Instance)) || (y >= LL_GetHeight(Instance)))
+    {
+      width = 0U;
+    }
+    LL_TransformRect(Instance, &x, &y, &width, &height);
+  }
+
+  if ((width != 0U) && (height != 0U))
+  {
+    ret = LL_GetDrawAddress(Instance, &address);
+    if (ret == BSP_ERROR_NONE)
+    {
+      address += Lcd_Ctx[Instance].BppFactor*((Lcd_Ctx[Instance].XSize*y) + x);
+      ret = LL_FillBuffer(Instance, (uint32_t *)address, width, height, (Lcd_Ctx[Instance].XSize - width), Color);
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Submits a rectangle job given in drawing coordinates. In rotated
+  *         orientations the source is written through the rotation paths:
+  *         DMA2D column transfers in portrait, DMA2D transfers of mirrored
+  *         lines in the 180 degrees orientations, CPU tiles for the sources
+  *         of less than 8 bits per pixel.
+  * @param  Instance LCD Instance
+  * @param  Job Pointer to the job prepared for the landscape orientation
+  * @param  Xpos X position
+  * @param  Ypos Y position
+  * @retval BSP status, BSP_ERROR_WRONG_PARAM when the rectangle does not
+  *         fit in the display
+  */
+static int32_t LL_SubmitRect(uint32_t Instance, const LCD_DMA2D_Job_t *Job, uint32_t Xpos, uint32_t Ypos)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  if ((Xpos > LL_GetWidth(Instance)) || (Job->Width > (LL_GetWidth(Instance) - Xpos)) ||
+      (Ypos > LL_GetHeight(Instance)) || (Job->Height > (LL_GetHeight(Instance) - Ypos)))
+  {
+    /* Rectangles must fit in the display */
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if (Lcd_Ctx[Instance].Orientation == LCD_ORIENTATION_LANDSCAPE)
+  {
+    ret = LL_DMA2D_Submit(Instance, Job);
+  }
+#if (USE_BSP_LCD_DMA2D_ROTATION == 1)
+  else if (LL_GetInputBits(Job->InputColorMode) >= 8U)
+  {
+    ret = LL_DMA2D_DrawTiles(Instance, Job, Xpos, Ypos);
+  }
+#endif /* USE_BSP_LCD_DMA2D_ROTATION */
+  else
+  {
+    /* Pixels narrower than a byte are only addressed by the CPU tiles */
+    ret = LL_CPU_DrawRotated(Instance, Job, Xpos, Ypos);
+  }
+
+  return ret;
+}
+
+#if (USE_BSP_LCD_DMA2D_ROTATION == 1)
+/**
+  * @brief  Rotates a rectangle with DMA2D. DMA2D cannot reverse nor transpose
+  *         pixels: the rectangle is processed by square tiles of
+  *         LCD_ROTATION_DMA2D_TILE pixels, the CPU rotates each tile in a tile
+  *         buffer in the source format, then one DMA2D transfer converts or
+  *         blends it in the panel. Tiles are rotated while DMA2D transfers
+  *         the previous ones.
+  * @param  Instance LCD Instance
+  * @param  Job Pointer to the job prepared for the landscape orientation
+  * @param  Xpos X position
+  * @param  Ypos Y position
+  * @retval BSP status
+  */
+static int32_t LL_DMA2D_DrawTiles(uint32_t Instance, const LCD_DMA2D_Job_t *Job, uint32_t Xpos, uint32_t Ypos)
+{
+  int32_t  ret;
+  uint32_t tx, ty, x, y, cw, ch, src, dst, tile;
+  uint32_t index = 0U;
+  uint32_t bpp = LL_GetInputBits(Job->InputColorMode) / 8U;
+  int32_t  src_pitch = LL_GetSrcPitch(Job);
+  int32_t  xstep, ystep, tile_xstep, tile_ystep;
+  uint8_t *ptile;
+  LCD_DMA2D_Job_t block = *Job;
+#if (USE_BSP_LCD_DMA2D_ASYNC == 1)
+  uint32_t fence[LCD_ROTATION_DMA2D_BUFFERS] = {0};
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
+
+  ret = LL_GetPixelAddress(Instance, Xpos, Ypos, &dst, &xstep, &ystep);
+
+  block.InputOffset = 0U;
+  block.SrcPitch    = 0;
+  block.DstPitch    = 0U;
+
+  for (ty = 0U; (ty < Job->Height) && (ret == BSP_ERROR_NONE); ty += LCD_ROTATION_DMA2D_TILE)
+  {
+    ch = LCD_MIN(LCD_ROTATION_DMA2D_TILE, Job->Height - ty);
+
+    for (tx = 0U; (tx < Job->Width) && (ret == BSP_ERROR_NONE); tx += LCD_ROTATION_DMA2D_TILE)
+    {
+      cw = LCD_MIN(LCD_ROTATION_DMA2D_TILE, Job->Width - tx);
+      ptile = Lcd_RotationTiles[index];
+
+#if (USE_BSP_LCD_DMA2D_ASYNC == 1)
+      /* The tile buffer is free once DMA2D transferred the tile it held */
+      ret = BSP_LCD_WaitFence(Instance, fence[index], LCD_DMA2D_TIMEOUT);
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
+
+      if (ret == BSP_ERROR_NONE)
+      {
+        /* Tile size in the panel and steps of the source pixels and lines
+           in the tile buffer, which holds the tile in panel order */
+        if (Lcd_Ctx[Instance].Orientation == LCD_ORIENTATION_LANDSCAPE_ROT180)
+        {
+          block.Width  = cw;
+          block.Height = ch;
+          tile_xstep   = (int32_t)bpp;
+          tile_ystep   = (int32_t)(cw * bpp);
+        }
+        else
+        {
+          block.Width  = ch;
+          block.Height = cw;
+          tile_xstep   = (int32_t)(ch * bpp);
+          tile_ystep   = (int32_t)bpp;
+        }
+
+        /* The first source pixel is stored after the ones moving backward */
+        tile = (uint32_t)ptile;
+        if (xstep < 0)
+        {
+          tile += (cw - 1U) * (uint32_t)tile_xstep;
+          tile_xstep = -tile_xstep;
+        }
+        if (ystep < 0)
+        {
+          tile += (ch - 1U) * (uint32_t)tile_ystep;
+          tile_ystep = -tile_ystep;
+        }
+
+        for (y = 0U; y < ch; y++)
+        {
+          src = Job->Src + (uint32_t)((int32_t)(ty + y) * src_pitch) + (tx * bpp);
+          for (x = 0U; x < cw; x++)
+          {
+            LL_WriteRawPixel(tile + (uint32_t)(((int32_t)x * tile_xstep) + ((int32_t)y * tile_ystep)), bpp,
+                             LL_ReadRawPixel(src + (x * bpp), bpp));
+          }
+        }
+
+#if (USE_BSP_CPU_CACHE_MAINTENANCE == 1)
+        SCB_CleanDCache_by_Addr((uint32_t *)ptile, (int32_t)(cw * ch * bpp));
+#endif /* USE_BSP_CPU_CACHE_MAINTENANCE */
+
+        /* Panel address of the tile top-left pixel */
+        tile = dst + (uint32_t)(((int32_t)tx * xstep) + ((int32_t)ty * ystep));
+        if (xstep < 0)
+        {
+          tile += (uint32_t)((int32_t)(cw - 1U) * xstep);
+        }
+        if (ystep < 0)
+        {
+          tile += (uint32_t)((int32_t)(ch - 1U) * ystep);
+        }
+
+        block.Src          = (uint32_t)ptile;
+        block.Dst          = tile;
+        block.OutputOffset = Lcd_Ctx[Instance].XSize - block.Width;
+        ret = LL_DMA2D_Submit(Instance, &block);
+
+#if (USE_BSP_LCD_DMA2D_ASYNC == 1)
+        fence[index] = Lcd_Dma2dSubmitted;
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
+        index = (index + 1U) % LCD_ROTATION_DMA2D_BUFFERS;
+      }
+    }
+  }
+
+  return ret;
+}
+#endif /* USE_BSP_LCD_DMA2D_ROTATION */
+
+/**
+  * @brief  Rotates a rectangle with the CPU. The rectangle is processed by
+  *         square tiles so that the source and destination lines of a tile
+  *         stay in the data cache.
+  * @param  Instance LCD Instance
+  * @param  Job Pointer to the job prepared for the landscape orientation
+  * @param  Xpos X position
+  * @param  Ypos Y position
+  * @retval BSP status
+  */
+static int32_t LL_CPU_DrawRotated(uint32_t Instance, const LCD_DMA2D_Job_t *Job, uint32_t Xpos, uint32_t Ypos)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  uint32_t tx, ty, line, count, last;
+  uint32_t dst, src;
+  int32_t  xstep, ystep;
+  int32_t  src_pitch = LL_GetSrcPitch(Job);
+  uint32_t bits = LL_GetInputBits(Job->InputColorMode);
+
+  ret = LL_GetPixelAddress(Instance, Xpos, Ypos, &dst, &xstep, &ystep);
+
+#if (USE_BSP_LCD_DMA2D_ASYNC == 1)
+  if (ret == BSP_ERROR_NONE)
+  {
+    /* Frame buffer is written by CPU: wait for the queued DMA2D jobs,
+       including the back buffer refresh queued by the address lookup */
+    ret = BSP_LCD_WaitFence(Instance, Lcd_Dma2dSubmitted, LCD_DMA2D_TIMEOUT);
+  }
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
+
+  for (ty = 0U; (ty < Job->Height) && (ret == BSP_ERROR_NONE); ty += LCD_ROTATION_TILE_SIZE)
+  {
+    last = LCD_MIN(ty + LCD_ROTATION_TILE_SIZE, Job->Height);
+
+    for (tx = 0U; tx < Job->Width; tx += LCD_ROTATION_TILE_SIZE)
+    {
+      count = LCD_MIN(LCD_ROTATION_TILE_SIZE, Job->Width - tx);
+
+      for (line = ty; line < last; line++)
+      {
+        src = Job->Src + (uint32_t)((int32_t)line * src_pitch) + ((tx * bits) / 8U);
+        LL_CPU_WriteLine(dst + (uint32_t)((int32_t)line * ystep) + (uint32_t)((int32_t)tx * xstep), xstep,
+                         (const uint8_t *)src, count, Job);
+      }
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Gets the signed distance in bytes between two source lines of a job.
+  * @param  Job Pointer to DMA2D job
+  * @retval Source pitch
+  */
+static int32_t LL_GetSrcPitch(const LCD_DMA2D_Job_t *Job)
+{
+  int32_t pitch;
+
+  if (Job->SrcPitch != 0)
+  {
+    pitch = Job->SrcPitch;
+  }
+  else
+  {
+    pitch = (int32_t)(((Job->Width + Job->InputOffset) * LL_GetInputBits(Job->InputColorMode)) / 8U);
+  }
+
+  return pitch;
+}
+
+#if (USE_BSP_LCD_CPU_RENDERING == 0)
+/**
+  * @brief  Programs DMA2D registers for a job, the transfer is not started.
+  *         HAL_DMA2D_Init() and HAL_DMA2D_ConfigLayer() are only called when
+  *         the job configuration differs from the programmed one, addresses,
+  *         size and color are written by the transfer start.
+  * @param  Job Pointer to DMA2D job
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef LL_DMA2D_Program(const LCD_DMA2D_Job_t *Job)
+{
+  HAL_StatusTypeDef status = HAL_OK;
+  uint32_t bg_color_mode;
+
+  /* Registers are unknown after an error, a timeout or a reset */
+  if (hlcd_dma2d.State != HAL_DMA2D_STATE_READY)
+  {
+    Lcd_Dma2dConfig = 0U;
+  }
+
+  if (((Lcd_Dma2dConfig & LCD_DMA2D_CONFIG_OUTPUT) == 0U)     ||
+      (hlcd_dma2d.Init.Mode         != Job->Mode)             ||
+      (hlcd_dma2d.Init.ColorMode    != Job->OutputColorMode)  ||
+      (hlcd_dma2d.Init.OutputOffset != Job->OutputOffset))
+  {
+    hlcd_dma2d.Instance          = DMA2D;
+    hlcd_dma2d.Init.Mode         = Job->Mode;
+    hlcd_dma2d.Init.ColorMode    = Job->OutputColorMode;
+    hlcd_dma2d.Init.OutputOffset = Job->OutputOffset;
+
+    /* DMA2D Initialization, foreground registers are left unchanged */
+    status = HAL_DMA2D_Init(&hlcd_dma2d);
+    Lcd_Dma2dConfig = (status == HAL_OK) ? (Lcd_Dma2dConfig | LCD_DMA2D_CONFIG_OUTPUT) : 0U;
+  }
+
+  if ((status == HAL_OK) && (Job->Mode != DMA2D_R2M) &&
+      (((Lcd_Dma2dConfig & LCD_DMA2D_CONFIG_FG) == 0U)                 ||
+       (hlcd_dma2d.LayerCfg[1].InputColorMode != Job->InputColorMode) ||
+       (hlcd_dma2d.LayerCfg[1].InputOffset    != Job->InputOffset)    ||
+       (hlcd_dma2d.LayerCfg[1].AlphaMode      != Job->AlphaMode)      ||
+       (hlcd_dma2d.LayerCfg[1].InputAlpha     != Job->InputAlpha)))
+  {
+    /* Foreground Configuration */
+    hlcd_dma2d.LayerCfg[1].AlphaMode      = Job->AlphaMode;
+    hlcd_dma2d.LayerCfg[1].InputAlpha     = Job->InputAlpha;
+    hlcd_dma2d.LayerCfg[1].InputColorMode = Job->InputColorMode;
+    hlcd_dma2d.LayerCfg[1].InputOffset    = Job->InputOffset;
+    hlcd_dma2d.LayerCfg[1].AlphaInverted  = DMA2D_REGULAR_ALPHA;
+
+    status = HAL_DMA2D_ConfigLayer(&hlcd_dma2d, 1);
+    Lcd_Dma2dConfig = (status == HAL_OK) ? (Lcd_Dma2dConfig | LCD_DMA2D_CONFIG_FG) : 0U;
+  }
+
+  if ((status == HAL_OK) && (Job->Mode == DMA2D_M2M_BLEND))
+  {
+    /* Background is the destination: same color mode and offset */
+    switch(Job->OutputColorMode)
+    {
+    case DMA2D_OUTPUT_RGB565:
+      bg_color_mode = DMA2D_INPUT_RGB565;
+      break;
+    case DMA2D_OUTPUT_RGB888:
+      bg_color_mode = DMA2D_INPUT_RGB888;
+      break;
+    case DMA2D_OUTPUT_ARGB4444:
+      bg_color_mode = DMA2D_INPUT_ARGB4444;
+      break;
+    default:
+      bg_color_mode = DMA2D_INPUT_ARGB8888;
+      break;
+    }
+
+    if (((Lcd_Dma2dConfig & LCD_DMA2D_CONFIG_BG) == 0U)          ||
+        (hlcd_dma2d.LayerCfg[0].InputColorMode != bg_color_mode) ||
+        (hlcd_dma2d.LayerCfg[0].InputOffset    != Job->OutputOffset))
+    {
+      /* Background Configuration */
+      hlcd_dma2d.LayerCfg[0].AlphaMode      = DMA2D_NO_MODIF_ALPHA;
+      hlcd_dma2d.LayerCfg[0].InputAlpha     = 0xFF;
+      hlcd_dma2d.LayerCfg[0].InputColorMode = bg_color_mode;
+      hlcd_dma2d.LayerCfg[0].InputOffset    = Job->OutputOffset;
+      hlcd_dma2d.LayerCfg[0].AlphaInverted  = DMA2D_REGULAR_ALPHA;
+
+      status = HAL_DMA2D_ConfigLayer(&hlcd_dma2d, 0);
+      Lcd_Dma2dConfig = (status == HAL_OK) ? (Lcd_Dma2dConfig | LCD_DMA2D_CONFIG_BG) : 0U;
+    }
+  }
+
+  return status;
+}
+#endif /* USE_BSP_LCD_CPU_RENDERING */
+
+/**
+  * @brief  Submits a DMA2D job. In synchronous mode the job is executed and
+  *         polled, in asynchronous mode it is queued and the function returns.
+  * @param  Instance LCD Instance
+  * @param  Job Pointer to DMA2D job, copied by the function
+  * @retval BSP status, BSP_ERROR_BUSY when the queued jobs are not completed
+  *         within LCD_DMA2D_TIMEOUT
+  */
+static int32_t LL_DMA2D_Submit(uint32_t Instance, const LCD_DMA2D_Job_t *Job)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+#if (USE_BSP_LCD_DMA2D_ASYNC == 0)
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(Instance);
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
+
+#if (USE_BSP_LCD_CPU_RENDERING == 1)
+  Lcd_Dma2dSubmitted++;
+
+  /* DMA2D is not used: the job is executed by CPU */
+  LL_CPU_Execute(Job);
+
+  Lcd_Dma2dCompleted++;
+#else
+  if (Job->OutputColorMode == LCD_OUTPUT_8BPP)
+  {
+#if (USE_BSP_LCD_DMA2D_ASYNC == 1)
+    /* Frame buffer is written by CPU: wait for the queued DMA2D jobs */
+    ret = BSP_LCD_WaitFence(Instance, Lcd_Dma2dSubmitted, LCD_DMA2D_TIMEOUT);
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
+    if (ret == BSP_ERROR_NONE)
+    {
+      Lcd_Dma2dSubmitted++;
+
+      /* DMA2D cannot write 8-bit pixels: the job is executed by CPU */
+      LL_CPU_Execute(Job);
+
+      Lcd_Dma2dCompleted++;
+    }
+  }
+  else
+  {
+#if (USE_BSP_LCD_DMA2D_ASYNC == 1)
+    /* The queue can only be full while DMA2D is running: a slot is freed
+       when the oldest queued job completes */
+    if ((Lcd_Dma2dHead - Lcd_Dma2dTail) >= LCD_DMA2D_QUEUE_SIZE)
+    {
+      ret = BSP_LCD_WaitFence(Instance, Lcd_Dma2dCompleted + 1U, LCD_DMA2D_TIMEOUT);
+    }
+
+    if (ret == BSP_ERROR_NONE)
+    {
+      /* The queue is shared with DMA2D interrupt */
+      HAL_NVIC_DisableIRQ(DMA2D_IRQn);
+
+      Lcd_Dma2dQueue[Lcd_Dma2dHead & (LCD_DMA2D_QUEUE_SIZE - 1U)] = *Job;
+      Lcd_Dma2dHead++;
+      Lcd_Dma2dSubmitted++;
+
+      /* The inline pixel accessors must not access the frame buffer while
+         the job is in flight: they fall back to the fenced accessors */
+      Lcd_Ctx[Instance].FbAddress = 0U;
+
+      /* Kick DMA2D if idle, otherwise the job is started on transfer complete */
+      if (Lcd_Dma2dRunning == 0U)
+      {
+        LL_DMA2D_StartNext();
+      }
+
+      HAL_NVIC_EnableIRQ(DMA2D_IRQn);
+    }
+#else
+    uint32_t line;
+    uint32_t src = Job->Src;
+    uint32_t dst = Job->Dst;
+
+    Lcd_Dma2dSubmitted++;
+
+    if (LL_DMA2D_Program(Job) != HAL_OK)
+    {
+      ret = BSP_ERROR_PERIPH_FAILURE;
+    }
+    else if (Job->SrcPitch == 0)
+    {
+      if (LL_DMA2D_Start(Job, src, dst, Job->Height) != HAL_OK)
+      {
+        ret = BSP_ERROR_PERIPH_FAILURE;
+      }
+      /* Polling For DMA transfer */
+      else if (HAL_DMA2D_PollForTransfer(&hlcd_dma2d, 50) != HAL_OK)
+      {
+        ret = BSP_ERROR_PERIPH_FAILURE;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+    }
+    else
+    {
+      /* Line by line transfer: only addresses are updated between lines */
+      for (line = 0; (line < Job->Height) && (ret == BSP_ERROR_NONE); line++)
+      {
+        if (LL_DMA2D_Start(Job, src, dst, 1) != HAL_OK)
+        {
+          ret = BSP_ERROR_PERIPH_FAILURE;
+        }
+        else if (HAL_DMA2D_PollForTransfer(&hlcd_dma2d, 50) != HAL_OK)
+        {
+          ret = BSP_ERROR_PERIPH_FAILURE;
+        }
+        else
+        {
+          src += (uint32_t)Job->SrcPitch;
+          dst += Job->DstPitch;
+        }
+      }
+    }
+
+    Lcd_Dma2dCompleted++;
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
+  }
+#endif /* USE_BSP_LCD_CPU_RENDERING */
+
+  return ret;
+}
+
+#if (USE_BSP_LCD_CPU_RENDERING == 0)
+/**
+  * @brief  Starts a programmed DMA2D job, in interrupt mode when the command
+  *         queue is used. Blending jobs use the destination as background.
+  * @param  Job    Pointer to DMA2D job
+  * @param  Src    Source address or color
+  * @param  Dst    Destination address
+  * @param  Height Number of lines to transfer
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef LL_DMA2D_Start(const LCD_DMA2D_Job_t *Job, uint32_t Src, uint32_t Dst, uint32_t Height)
+{
+  HAL_StatusTypeDef status;
+
+#if (USE_BSP_LCD_DMA2D_ASYNC == 1)
+  if (Job->Mode == DMA2D_M2M_BLEND)
+  {
+    status = HAL_DMA2D_BlendingStart_IT(&hlcd_dma2d, Src, Dst, Dst, Job->Width, Height);
+  }
+  else
+  {
+    status = HAL_DMA2D_Start_IT(&hlcd_dma2d, Src, Dst, Job->Width, Height);
+  }
+#else
+  if (Job->Mode == DMA2D_M2M_BLEND)
+  {
+    status = HAL_DMA2D_BlendingStart(&hlcd_dma2d, Src, Dst, Dst, Job->Width, Height);
+  }
+  else
+  {
+    status = HAL_DMA2D_Start(&hlcd_dma2d, Src, Dst, Job->Width, Height);
+  }
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
+
+  return status;
+}
+#endif /* USE_BSP_LCD_CPU_RENDERING */
+
+/**
+  * @brief  Gets the number of bits per pixel of a DMA2D input color mode.
+  * @param  ColorMode DMA2D input color mode
+  * @retval Bits per pixel
+  */
+static uint32_t LL_GetInputBits(uint32_t ColorMode)
+{
+  uint32_t bits;
+
+  switch(ColorMode)
+  {
+  case DMA2D_INPUT_RGB565:
+  case DMA2D_INPUT_ARGB4444:
+    bits = 16U;
+    break;
+  case DMA2D_INPUT_RGB888:
+    bits = 24U;
+    break;
+  case DMA2D_INPUT_L8:
+  case DMA2D_INPUT_AL44:
+  case DMA2D_INPUT_A8:
+    bits = 8U;
+    break;
+  case DMA2D_INPUT_A4:
+    bits = 4U;
+    break;
+  case DMA2D_INPUT_ARGB8888:
+  default:
+    bits = 32U;
+    break;
+  }
+
+  return bits;
+}
+
+/**
+  * @brief  Gets the number of bytes per pixel of a layer color mode.
+  * @param  ColorMode DMA2D_OUTPUT_xxx or LCD_OUTPUT_8BPP
+  * @retval Bytes per pixel
+  */
+static uint32_t LL_GetOutputBpp(uint32_t ColorMode)
+{
+  uint32_t bpp;
+
+  switch(ColorMode)
+  {
+  case DMA2D_OUTPUT_RGB565:
+  case DMA2D_OUTPUT_ARGB4444:
+    bpp = 2U;
+    break;
+  case DMA2D_OUTPUT_RGB888:
+    bpp = 3U;
+    break;
+  case LCD_OUTPUT_8BPP:
+    bpp = 1U;
+    break;
+  case DMA2D_OUTPUT_ARGB8888:
+  default:
+    bpp = 4U;
+    break;
+  }
+
+  return bpp;
+}
+
+/**
+  * @brief  Gets the color mode written by the draw jobs in the layers.
+  * @param  Instance LCD Instance
+  * @retval DMA2D_OUTPUT_xxx, LCD_OUTPUT_8BPP for L8 and AL44 layers
+  */
+static uint32_t LL_GetOutputColorMode(uint32_t Instance)
+{
+  uint32_t color_mode;
+
+  switch(Lcd_Ctx[Instance].PixelFormat)
+  {
+  case LCD_PIXEL_FORMAT_RGB565:
+    color_mode = DMA2D_OUTPUT_RGB565;
+    break;
+  case LCD_PIXEL_FORMAT_ARGB4444:
+    color_mode = DMA2D_OUTPUT_ARGB4444;
+    break;
+  case LCD_PIXEL_FORMAT_RGB888_PACKED:
+    color_mode = DMA2D_OUTPUT_RGB888;
+    break;
+  case LCD_PIXEL_FORMAT_L8:
+  case LCD_PIXEL_FORMAT_AL44:
+    color_mode = LCD_OUTPUT_8BPP;
+    break;
+  case LCD_PIXEL_FORMAT_RGB888:
+  default:
+    color_mode = DMA2D_OUTPUT_ARGB8888;
+    break;
+  }
+
+  return color_mode;
+}
+
+/**
+  * @brief  Gets the input color mode reading pixels in the layer format.
+  * @param  Instance LCD Instance
+  * @retval DMA2D_INPUT_xxx
+  */
+static uint32_t LL_GetLayerInputColorMode(uint32_t Instance)
+{
+  uint32_t color_mode;
+
+  switch(Lcd_Ctx[Instance].PixelFormat)
+  {
+  case LCD_PIXEL_FORMAT_RGB565:
+    color_mode = DMA2D_INPUT_RGB565;
+    break;
+  case LCD_PIXEL_FORMAT_ARGB4444:
+    color_mode = DMA2D_INPUT_ARGB4444;
+    break;
+  case LCD_PIXEL_FORMAT_RGB888_PACKED:
+    color_mode = DMA2D_INPUT_RGB888;
+    break;
+  case LCD_PIXEL_FORMAT_L8:
+    color_mode = DMA2D_INPUT_L8;
+    break;
+  case LCD_PIXEL_FORMAT_AL44:
+    color_mode = DMA2D_INPUT_AL44;
+    break;
+  case LCD_PIXEL_FORMAT_RGB888:
+  default:
+    color_mode = DMA2D_INPUT_ARGB8888;
+    break;
+  }
+
+  return color_mode;
+}
+
+/**
+  * @brief  Gets the layer color mode storing the pixels of an input color
+  *         mode unchanged, so that a conversion between them is a copy.
+  * @param  InputColorMode DMA2D_INPUT_xxx
+  * @retval DMA2D_OUTPUT_xxx, LCD_OUTPUT_8BPP for the L8 and AL44 indexes,
+  *         LCD_OUTPUT_NONE when the pixels must be converted
+  */
+static uint32_t LL_GetInputAsOutputColorMode(uint32_t InputColorMode)
+{
+  uint32_t color_mode;
+
+  switch(InputColorMode)
+  {
+  case DMA2D_INPUT_ARGB8888:
+    color_mode = DMA2D_OUTPUT_ARGB8888;
+    break;
+  case DMA2D_INPUT_RGB888:
+    color_mode = DMA2D_OUTPUT_RGB888;
+    break;
+  case DMA2D_INPUT_RGB565:
+    color_mode = DMA2D_OUTPUT_RGB565;
+    break;
+  case DMA2D_INPUT_ARGB1555:
+    color_mode = DMA2D_OUTPUT_ARGB1555;
+    break;
+  case DMA2D_INPUT_ARGB4444:
+    color_mode = DMA2D_OUTPUT_ARGB4444;
+    break;
+  case DMA2D_INPUT_L8:
+  case DMA2D_INPUT_AL44:
+    /* 8-bit layers are written with their CLUT indexes */
+    color_mode = LCD_OUTPUT_8BPP;
+    break;
+  default:
+    color_mode = LCD_OUTPUT_NONE;
+    break;
+  }
+
+  return color_mode;
+}
+
+/**
+  * @brief  Converts a color given in the layer pixel format to ARGB8888.
+  * @param  Instance LCD Instance
+  * @param  Color Color in the layer pixel format
+  * @retval ARGB8888 color
+  */
+static uint32_t LL_ConvertToARGB8888(uint32_t Instance, uint32_t Color)
+{
+  uint32_t color;
+
+  switch(Lcd_Ctx[Instance].PixelFormat)
+  {
+  case LCD_PIXEL_FORMAT_RGB565:
+    color = CONVERTRGB5652ARGB8888(Color);
+    break;
+  case LCD_PIXEL_FORMAT_ARGB4444:
+    color = CONVERTARGB44442ARGB8888(Color);
+    break;
+  case LCD_PIXEL_FORMAT_RGB888_PACKED:
+    color = Color | 0xFF000000U;
+    break;
+  default:
+    color = Color;
+    break;
+  }
+
+  return color;
+}
+
+/**
+  * @brief  Reads a pixel in the layer pixel format.
+  * @param  Address Pixel address
+  * @param  Bpp Bytes per pixel of the layer (1 to 4)
+  * @retval Pixel value
+  */
+static uint32_t LL_ReadRawPixel(uint32_t Address, uint32_t Bpp)
+{
+  uint32_t color;
+
+  switch(Bpp)
+  {
+  case 1U:
+    color = *(__IO uint8_t *)Address;
+    break;
+  case 2U:
+    color = *(__IO uint16_t *)Address;
+    break;
+  case 3U:
+    /* Packed RGB888: blue at the lowest address */
+    color = (uint32_t)(*(__IO uint8_t *)Address) | ((uint32_t)(*(__IO uint8_t *)(Address + 1U)) << 8U) |
+            ((uint32_t)(*(__IO uint8_t *)(Address + 2U)) << 16U);
+    break;
+  default:
+    color = *(__IO uint32_t *)Address;
+    break;
+  }
+
+  return color;
+}
+
+/**
+  * @brief  Writes a pixel in the layer pixel format.
+  * @param  Address Pixel address
+  * @param  Bpp Bytes per pixel of the layer (1 to 4)
+  * @param  Color Pixel value
+  * @retval None
+  */
+static void LL_WriteRawPixel(uint32_t Address, uint32_t Bpp, uint32_t Color)
+{
+  switch(Bpp)
+  {
+  case 1U:
+    *(__IO uint8_t *)Address = (uint8_t)Color;
+    break;
+  case 2U:
+    *(__IO uint16_t *)Address = (uint16_t)Color;
+    break;
+  case 3U:
+    *(__IO uint8_t *)Address          = (uint8_t)Color;
+    *(__IO uint8_t *)(Address + 1U)   = (uint8_t)(Color >> 8U);
+    *(__IO uint8_t *)(Address + 2U)   = (uint8_t)(Color >> 16U);
+    break;
+  default:
+    *(__IO uint32_t *)Address = Color;
+    break;
+  }
+}
+
+#if (USE_BSP_LCD_DMA2D_ASYNC == 1)
+/**
+  * @brief  Starts the next queued DMA2D job, if any. Must be called with
+  *         DMA2D interrupt disabled or from DMA2D interrupt context.
+  * @retval None
+  */
+static void LL_DMA2D_StartNext(void)
+{
+  const LCD_DMA2D_Job_t *job;
+
+  Lcd_Dma2dRunning = 0U;
+
+  while ((Lcd_Dma2dRunning == 0U) && (Lcd_Dma2dTail != Lcd_Dma2dHead))
+  {
+    job = &Lcd_Dma2dQueue[Lcd_Dma2dTail & (LCD_DMA2D_QUEUE_SIZE - 1U)];
+
+    hlcd_dma2d.XferCpltCallback  = LL_DMA2D_XferCpltCallback;
+    hlcd_dma2d.XferErrorCallback = LL_DMA2D_XferCpltCallback;
+
+    Lcd_Dma2dLine = 0U;
+
+    if ((LL_DMA2D_Program(job) == HAL_OK) && (LL_DMA2D_StartLine(job) == HAL_OK))
+    {
+      Lcd_Dma2dRunning = 1U;
+    }
+    else
+    {
+      /* Job cannot be started: drop it so that its fence is still signaled */
+      Lcd_Dma2dTail++;
+      Lcd_Dma2dCompleted++;
+    }
+  }
+}
+
+/**
+  * @brief  DMA2D transfer complete and transfer error callback.
+  * @param  hdma2d DMA2D handle
+  * @retval None
+  */
+static void LL_DMA2D_XferCpltCallback(DMA2D_HandleTypeDef *hdma2d)
+{
+  const LCD_DMA2D_Job_t *job = &Lcd_Dma2dQueue[Lcd_Dma2dTail & (LCD_DMA2D_QUEUE_SIZE - 1U)];
+
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(hdma2d);
+
+  /* Line by line job: restart DMA2D on the next line, configuration is kept */
+  if (job->SrcPitch != 0)
+  {
+    Lcd_Dma2dLine++;
+    if (Lcd_Dma2dLine < job->Height)
+    {
+      if (LL_DMA2D_StartLine(job) == HAL_OK)
+      {
+        return;
+      }
+    }
+  }
+
+  /* Retire the current job then start the next one */
+  Lcd_Dma2dTail++;
+  Lcd_Dma2dCompleted++;
+
+  LL_DMA2D_StartNext();
+}
+
+/**
+  * @brief  Starts the current DMA2D job in interrupt mode. Line by line jobs
+  *         start the line selected by Lcd_Dma2dLine.
+  * @param  Job Pointer to DMA2D job
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef LL_DMA2D_StartLine(const LCD_DMA2D_Job_t *Job)
+{
+  HAL_StatusTypeDef status;
+
+  if (Job->SrcPitch == 0)
+  {
+    status = LL_DMA2D_Start(Job, Job->Src, Job->Dst, Job->Height);
+  }
+  else
+  {
+    status = LL_DMA2D_Start(Job, Job->Src + (Lcd_Dma2dLine * (uint32_t)Job->SrcPitch),
+                            Job->Dst + (Lcd_Dma2dLine * Job->DstPitch), 1);
+  }
+
+  return status;
+}
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
+
+/**
+  * @brief  Executes a DMA2D job with the CPU kernels.
+  * @param  Job Pointer to DMA2D job
+  * @retval None
+  */
+static void LL_CPU_Execute(const LCD_DMA2D_Job_t *Job)
+{
+  uint32_t line, color;
+  uint32_t src = Job->Src;
+  uint32_t dst = Job->Dst;
+  uint32_t input_bits, output_bpp;
+  uint32_t src_pitch, dst_pitch;
+
+  output_bpp = LL_GetOutputBpp(Job->OutputColorMode);
+  input_bits = LL_GetInputBits(Job->InputColorMode);
+
+  if (Job->SrcPitch == 0)
+  {
+    src_pitch = ((Job->Width + Job->InputOffset) * input_bits) / 8U;
+    dst_pitch = (Job->Width + Job->OutputOffset) * output_bpp;
+  }
+  else
+  {
+    src_pitch = (uint32_t)Job->SrcPitch;
+    dst_pitch = Job->DstPitch;
+  }
+
+  /* Register to memory color is given in ARGB8888, or as raw index for 8-bit layers */
+  switch(Job->OutputColorMode)
+  {
+  case DMA2D_OUTPUT_RGB565:
+    color = CONVERTARGB88882RGB565(Job->Src);
+    break;
+  case DMA2D_OUTPUT_ARGB4444:
+    color = CONVERTARGB88882ARGB4444(Job->Src);
+    break;
+  case DMA2D_OUTPUT_RGB888:
+    color = Job->Src & 0x00FFFFFFU;
+    break;
+  default:
+    color = Job->Src;
+    break;
+  }
+
+  for (line = 0; line < Job->Height; line++)
+  {
+    if (Job->Mode == DMA2D_R2M)
+    {
+      LL_CPU_FillLine(dst, Job->Width, color, output_bpp);
+    }
+    else if (Job->Mode == DMA2D_M2M_BLEND)
+    {
+      LL_CPU_WriteLine(dst, (int32_t)output_bpp, (const uint8_t *)src, Job->Width, Job);
+      src += src_pitch;
+    }
+    else if ((Job->Mode == DMA2D_M2M) || (LL_GetInputAsOutputColorMode(Job->InputColorMode) == Job->OutputColorMode))
+    {
+      LL_CPU_CopyLine(dst, (const uint8_t *)src, Job->Width * output_bpp);
+      src += src_pitch;
+    }
+    else
+    {
+      LL_CPU_ConvertLine(dst, (const uint8_t *)src, Job->Width, Job->InputColorMode, Job->OutputColorMode);
+      src += src_pitch;
+    }
+    dst += dst_pitch;
+  }
+}
+
+/**
+  * @brief  Fills a line with a color using word stores.
+  * @param  Address Line start address
+  * @param  Length Line length in pixels
+  * @param  Color Color in the layer pixel format
+  * @param  Bpp Bytes per pixel of the layer (1 to 4)
+  * @retval None
+  */
+static void LL_CPU_FillLine(uint32_t Address, uint32_t Length, uint32_t Color, uint32_t Bpp)
+{
+  uint32_t count = Length;
+  uint32_t address = Address;
+  uint32_t pattern;
+  uint32_t *pdst;
+
+  if (Bpp == 3U)
+  {
+    /* Packed 24-bit pixels are not word aligned */
+    while (count != 0U)
+    {
+      LL_WriteRawPixel(address, 3U, Color);
+      address += 3U;
+      count--;
+    }
+  }
+  else
+  {
+    /* Align destination on a word, then store 4 / Bpp pixels per word */
+    while (((address & 3U) != 0U) && (count != 0U))
+    {
+      LL_WriteRawPixel(address, Bpp, Color);
+      address += Bpp;
+      count--;
+    }
+
+    if (Bpp == 1U)
+    {
+      pattern = (Color & 0xFFU) * 0x01010101U;
+    }
+    else if (Bpp == 2U)
+    {
+      pattern = PACKRGB565(Color & 0xFFFFU, Color & 0xFFFFU);
+    }
+    else
+    {
+      pattern = Color;
+    }
+
+    pdst = (uint32_t *)address;
+
+    /* Main loop: 4 words per iteration */
+    while (count >= (16U / Bpp))
+    {
+      pdst[0] = pattern;
+      pdst[1] = pattern;
+      pdst[2] = pattern;
+      pdst[3] = pattern;
+      pdst  += 4U;
+      count -= (16U / Bpp);
+    }
+
+    while (count >= (4U / Bpp))
+    {
+      *pdst = pattern;
+      pdst++;
+      count -= (4U / Bpp);
+    }
+
+    /* Last pixels of the line */
+    address = (uint32_t)pdst;
+    while (count != 0U)
+    {
+      LL_WriteRawPixel(address, Bpp, Color);
+      address += Bpp;
+      count--;
+    }
+  }
+}
+
+/**
+  * @brief  Converts a line to the layer pixel format.
+  * @param  Address Destination line start address
+  * @param  pSrc Pointer to source line
+  * @param  Length Line length in pixels
+  * @param  InputColorMode DMA2D_INPUT_RGB565, DMA2D_INPUT_RGB888, DMA2D_INPUT_ARGB4444,
+  *         DMA2D_INPUT_L8 or DMA2D_INPUT_ARGB8888
+  * @param  OutputColorMode Layer color mode
+  * @retval None
+  */
+static void LL_CPU_ConvertLine(uint32_t Address, const uint8_t *pSrc, uint32_t Length, uint32_t InputColorMode, uint32_t OutputColorMode)
+{
+  uint32_t count = Length;
+  uint32_t input_bpp = LL_GetInputBits(InputColorMode) / 8U;
+  uint32_t lo, hi;
+  const uint8_t *psrc = pSrc;
+  uint32_t address = Address;
+  uint16_t *pdst16;
+  uint32_t *pdst32;
+
+  if (OutputColorMode == DMA2D_OUTPUT_RGB565)
+  {
+    pdst16 = (uint16_t *)Address;
+
+    /* Align destination on a word, then store two pixels per word */
+    if (((Address & 3U) != 0U) && (count != 0U))
+    {
+      lo = LL_CPU_ReadARGB8888(psrc, InputColorMode);
+      *pdst16 = (uint16_t)CONVERTARGB88882RGB565(lo);
+      pdst16++;
+      psrc += input_bpp;
+      count--;
+    }
+
+    pdst32 = (uint32_t *)pdst16;
+    while (count >= 2U)
+    {
+      lo = LL_CPU_ReadARGB8888(psrc, InputColorMode);
+      hi = LL_CPU_ReadARGB8888(psrc + input_bpp, InputColorMode);
+      *pdst32 = PACKRGB565(CONVERTARGB88882RGB565(lo), CONVERTARGB88882RGB565(hi));
+      pdst32++;
+      psrc  += 2U * input_bpp;
+      count -= 2U;
+    }
+
+    if (count != 0U)
+    {
+      lo = LL_CPU_ReadARGB8888(psrc, InputColorMode);
+      *(uint16_t *)pdst32 = (uint16_t)CONVERTARGB88882RGB565(lo);
+    }
+  }
+  else if (OutputColorMode == DMA2D_OUTPUT_ARGB8888)
+  {
+    pdst32 = (uint32_t *)Address;
+    while (count != 0U)
+    {
+      *pdst32 = LL_CPU_ReadARGB8888(psrc, InputColorMode);
+      pdst32++;
+      psrc += input_bpp;
+      count--;
+    }
+  }
+  else
+  {
+    /* ARGB4444 and packed RGB888 layers */
+    while (count != 0U)
+    {
+      LL_CPU_StorePixel(address, LL_CPU_ReadARGB8888(psrc, InputColorMode), OutputColorMode);
+      address += LL_GetOutputBpp(OutputColorMode);
+      psrc    += input_bpp;
+      count--;
+    }
+  }
+}
+
+/**
+  * @brief  Reads a source pixel and converts it to ARGB8888.
+  * @param  pSrc Pointer to source pixel, no alignment required
+  * @param  ColorMode DMA2D_INPUT_RGB565, DMA2D_INPUT_RGB888, DMA2D_INPUT_ARGB4444,
+  *         DMA2D_INPUT_L8 or DMA2D_INPUT_ARGB8888
+  * @retval ARGB8888 color
+  */
+static uint32_t LL_CPU_ReadARGB8888(const uint8_t *pSrc, uint32_t ColorMode)
+{
+  uint32_t color;
+
+  switch(ColorMode)
+  {
+  case DMA2D_INPUT_RGB565:
+    color = (uint32_t)pSrc[0] | ((uint32_t)pSrc[1] << 8U);
+    color = CONVERTRGB5652ARGB8888(color);
+    break;
+  case DMA2D_INPUT_RGB888:
+    color = (uint32_t)pSrc[0] | ((uint32_t)pSrc[1] << 8U) | ((uint32_t)pSrc[2] << 16U) | 0xFF000000U;
+    break;
+  case DMA2D_INPUT_ARGB4444:
+    color = (uint32_t)pSrc[0] | ((uint32_t)pSrc[1] << 8U);
+    color = CONVERTARGB44442ARGB8888(color);
+    break;
+  case DMA2D_INPUT_L8:
+    color = (Lcd_Clut != NULL) ? Lcd_Clut[pSrc[0]] : 0xFF000000U;
+    break;
+  case DMA2D_INPUT_ARGB8888:
+  default:
+    color = (uint32_t)pSrc[0] | ((uint32_t)pSrc[1] << 8U) | ((uint32_t)pSrc[2] << 16U) | ((uint32_t)pSrc[3] << 24U);
+    break;
+  }
+
+  return color;
+}
+
+/**
+  * @brief  Reads a foreground pixel of a job and converts it to ARGB8888.
+  * @param  pSrc Pointer to the foreground line
+  * @param  Index Pixel index in the line
+  * @param  Job Pointer to the job
+  * @retval ARGB8888 color
+  */
+static uint32_t LL_CPU_ReadFgPixel(const uint8_t *pSrc, uint32_t Index, const LCD_DMA2D_Job_t *Job)
+{
+  uint32_t fg, alpha;
+
+  switch(Job->InputColorMode)
+  {
+  case DMA2D_INPUT_A8:
+    fg = (Job->InputAlpha & 0x00FFFFFFU) | ((uint32_t)pSrc[Index] << 24U);
+    break;
+  case DMA2D_INPUT_A4:
+    /* First pixel in the low nibble */
+    alpha = ((Index & 1U) == 0U) ? ((uint32_t)pSrc[Index >> 1U] & 0x0FU) : ((uint32_t)pSrc[Index >> 1U] >> 4U);
+    fg = (Job->InputAlpha & 0x00FFFFFFU) | ((alpha * 17U) << 24U);
+    break;
+  default:
+    fg = LL_CPU_ReadARGB8888(&pSrc[Index * (LL_GetInputBits(Job->InputColorMode) / 8U)], Job->InputColorMode);
+    break;
+  }
+
+  return fg;
+}
+
+/**
+  * @brief  Writes a foreground line to the layer: pixels are converted, or
+  *         blended over the destination with the DMA2D blending equations
+  *         for DMA2D_M2M_BLEND jobs.
+  * @param  Address Destination address of the first pixel, also used as background
+  * @param  Step Signed distance in bytes between two destination pixels
+  * @param  pSrc Pointer to the foreground line
+  * @param  Length Number of pixels
+  * @param  Job Pointer to the job, its output color mode is the layer one
+  * @retval None
+  */
+static void LL_CPU_WriteLine(uint32_t Address, int32_t Step, const uint8_t *pSrc, uint32_t Length, const LCD_DMA2D_Job_t *Job)
+{
+  uint32_t i, shift;
+  uint32_t fg, bg, color;
+  uint32_t alpha, bg_alpha, out_alpha, const_alpha;
+  uint32_t address = Address;
+
+  /* A4 and A8 carry the constant alpha in bits 31:24, with the color */
+  if ((Job->InputColorMode == DMA2D_INPUT_A4) || (Job->InputColorMode == DMA2D_INPUT_A8))
+  {
+    const_alpha = Job->InputAlpha >> 24U;
+  }
+  else
+  {
+    const_alpha = Job->InputAlpha & 0xFFU;
+  }
+
+  for (i = 0U; i < Length; i++)
+  {
+    fg = LL_CPU_ReadFgPixel(pSrc, i, Job);
+
+    if (Job->AlphaMode == DMA2D_COMBINE_ALPHA)
+    {
+      alpha = ((fg >> 24U) * const_alpha) / 255U;
+    }
+    else if (Job->AlphaMode == DMA2D_REPLACE_ALPHA)
+    {
+      alpha = const_alpha;
+    }
+    else
+    {
+      alpha = fg >> 24U;
+    }
+
+    if (Job->Mode != DMA2D_M2M_BLEND)
+    {
+      color = (fg & 0x00FFFFFFU) | (alpha << 24U);
+    }
+    else
+    {
+      bg = LL_CPU_LoadPixel(address, Job->OutputColorMode);
+
+      /* Aout = Afg + Abg - Afg.Abg, Cout = (Cfg.Afg + Cbg.Abg.(1 - Afg)) / Aout */
+      bg_alpha  = bg >> 24U;
+      bg_alpha  = (bg_alpha * (255U - alpha)) / 255U;
+      out_alpha = alpha + bg_alpha;
+      color     = out_alpha << 24U;
+
+      if (out_alpha != 0U)
+      {
+        for (shift = 0U; shift < 24U; shift += 8U)
+        {
+          color |= (((((fg >> shift) & 0xFFU) * alpha) + (((bg >> shift) & 0xFFU) * bg_alpha)) / out_alpha) << shift;
+        }
+      }
+    }
+
+    LL_CPU_StorePixel(address, color, Job->OutputColorMode);
+    address += (uint32_t)Step;
+  }
+}
+
+/**
+  * @brief  Loads a layer pixel and converts it to ARGB8888.
+  * @param  Address Pixel address
+  * @param  ColorMode Layer color mode (DMA2D_OUTPUT_xxx)
+  * @retval ARGB8888 color
+  */
+static uint32_t LL_CPU_LoadPixel(uint32_t Address, uint32_t ColorMode)
+{
+  uint32_t color;
+
+  switch(ColorMode)
+  {
+  case DMA2D_OUTPUT_RGB565:
+    color = *(uint16_t *)Address;
+    color = CONVERTRGB5652ARGB8888(color);
+    break;
+  case DMA2D_OUTPUT_ARGB4444:
+    color = *(uint16_t *)Address;
+    color = CONVERTARGB44442ARGB8888(color);
+    break;
+  case DMA2D_OUTPUT_RGB888:
+    color = LL_ReadRawPixel(Address, 3U) | 0xFF000000U;
+    break;
+  default:
+    color = *(uint32_t *)Address;
+    break;
+  }
+
+  return color;
+}
+
+/**
+  * @brief  Converts an ARGB8888 color and stores it in a layer pixel.
+  * @param  Address Pixel address
+  * @param  Color ARGB8888 color
+  * @param  ColorMode Layer color mode (DMA2D_OUTPUT_xxx)
+  * @retval None
+  */
+static void LL_CPU_StorePixel(uint32_t Address, uint32_t Color, uint32_t ColorMode)
+{
+  switch(ColorMode)
+  {
+  case DMA2D_OUTPUT_RGB565:
+    *(uint16_t *)Address = (uint16_t)CONVERTARGB88882RGB565(Color);
+    break;
+  case DMA2D_OUTPUT_ARGB4444:
+    *(uint16_t *)Address = (uint16_t)CONVERTARGB88882ARGB4444(Color);
+    break;
+  case DMA2D_OUTPUT_RGB888:
+    LL_WriteRawPixel(Address, 3U, Color);
+    break;
+  default:
+    *(uint32_t *)Address = Color;
+    break;
+  }
+}
+
+/**
+  * @brief  Copies a rectangle of pixels in the layer pixel format to the
+  *         active layer with the CPU. Rotated rectangles are copied by square
+  *         tiles so that the source and destination lines of a tile stay in
+  *         the data cache.
+  * @param  Instance LCD Instance
+  * @param  pSrc Pointer to the pixels, lines are contiguous
+  * @param  Xpos X position
+  * @param  Ypos Y position
+  * @param  Width Rectangle width
+  * @param  Height Rectangle height
+  * @retval BSP status, BSP_ERROR_WRONG_PARAM when the rectangle does not fit
+  *         in the display
+  */
+static int32_t LL_CPU_CopyRect(uint32_t Instance, const uint8_t *pSrc, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  uint32_t tx, ty, x, line, count, last, tile;
+  uint32_t dst, address;
+  int32_t  xstep, ystep;
+  uint32_t bpp = Lcd_Ctx[Instance].BppFactor;
+  const uint8_t *psrc;
+
+  if ((Xpos <= LL_GetWidth(Instance)) && (Width <= (LL_GetWidth(Instance) - Xpos)) &&
+      (Ypos <= LL_GetHeight(Instance)) && (Height <= (LL_GetHeight(Instance) - Ypos)))
+  {
+    ret = LL_GetPixelAddress(Instance, Xpos, Ypos, &dst, &xstep, &ystep);
+
+#if (USE_BSP_LCD_DMA2D_ASYNC == 1)
+    if (ret == BSP_ERROR_NONE)
+    {
+      /* Frame buffer is written by CPU: wait for the queued DMA2D jobs,
+         including the back buffer refresh queued by the address lookup */
+      ret = BSP_LCD_WaitFence(Instance, Lcd_Dma2dSubmitted, LCD_DMA2D_TIMEOUT);
+    }
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
+    tile = (xstep == (int32_t)bpp) ? LCD_MAX(Width, Height) : LCD_ROTATION_TILE_SIZE;
+
+    for (ty = 0U; (ty < Height) && (ret == BSP_ERROR_NONE); ty += tile)
+    {
+      last = LCD_MIN(ty + tile, Height);
+
+      for (tx = 0U; tx < Width; tx += tile)
+      {
+        count = LCD_MIN(tile, Width - tx);
+
+        for (line = ty; line < last; line++)
+        {
+          psrc    = &pSrc[((line * Width) + tx) * bpp];
+          address = dst + (uint32_t)((int32_t)line * ystep) + (uint32_t)((int32_t)tx * xstep);
+
+          if (xstep == (int32_t)bpp)
+          {
+            /* Source and destination lines are contiguous */
+            LL_CPU_CopyLine(address, psrc, count * bpp);
+          }
+          else
+          {
+            for (x = 0U; x < count; x++)
+            {
+              LL_WriteRawPixel(address, bpp, LL_ReadRawPixel((uint32_t)&psrc[x * bpp], bpp));
+              address += (uint32_t)xstep;
+            }
+          }
+        }
+      }
+    }
+  }
+  else
+  {
+    /* The rectangle must fit in the display */
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Copies a line using the widest access allowed by the alignment.
+  * @param  Address Destination line start address
+  * @param  pSrc Pointer to source line
+  * @param  Size Line size in bytes
+  * @retval None
+  */
+static void LL_CPU_CopyLine(uint32_t Address, const uint8_t *pSrc, uint32_t Size)
+{
+  uint32_t count = Size;
+  uint32_t alignment = Address | (uint32_t)pSrc | Size;
+
+  if ((alignment & 3U) == 0U)
+  {
+    const uint32_t *psrc32 = (const uint32_t *)pSrc;
+    uint32_t *pdst32 = (uint32_t *)Address;
+
+    /* Main loop: 4 words per iteration */
+    while (count >= 16U)
+    {
+      pdst32[0] = psrc32[0];
+      pdst32[1] = psrc32[1];
+      pdst32[2] = psrc32[2];
+      pdst32[3] = psrc32[3];
+      pdst32 += 4U;
+      psrc32 += 4U;
+      count  -= 16U;
+    }
+    while (count != 0U)
+    {
+      *pdst32 = *psrc32;
+      pdst32++;
+      psrc32++;
+      count -= 4U;
+    }
+  }
+  else if ((alignment & 1U) == 0U)
+  {
+    const uint16_t *psrc16 = (const uint16_t *)pSrc;
+    uint16_t *pdst16 = (uint16_t *)Address;
+
+    while (count != 0U)
+    {
+      *pdst16 = *psrc16;
+      pdst16++;
+      psrc16++;
+      count -= 2U;
+    }
+  }
+  else
+  {
+    const uint8_t *psrc8 = pSrc;
+    uint8_t *pdst8 = (uint8_t *)Address;
+
+    while (count != 0U)
+    {
+      *pdst8 = *psrc8;
+      pdst8++;
+      psrc8++;
+      count--;
+    }
+  }
+}
 
 /**
-  * @brief  Draws a vertical line in currently active layer.
-  * @param  Instance   LCD Instance
-  * @param  Xpos  X position
-  * @param  Ypos  Y position
-  * @param  Length  Line length
-  * @param  Color RGB color
-  * @retval BSP status
+  * @brief  Gets the display width in the drawing orientation.
+  * @param  Instance LCD Instance
+  * @retval Width in pixels
   */
-int32_t BSP_LCD_DrawVLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+static uint32_t LL_GetWidth(uint32_t Instance)
 {
-  uint32_t  Xaddress;
+  return ((Lcd_Ctx[Instance].Orientation == LCD_ORIENTATION_PORTRAIT) ||
+          (Lcd_Ctx[Instance].Orientation == LCD_ORIENTATION_PORTRAIT_ROT180)) ? Lcd_Ctx[Instance].YSize : Lcd_Ctx[Instance].XSize;
+}
 
-  /* Get the line address */
-  Xaddress = (hlcd_ltdc.LayerCfg[Lcd_Ctx[Instance].ActiveLayer].FBStartAdress) + (Lcd_Ctx[Instance].BppFactor*((Lcd_Ctx[Instance].XSize*Ypos) + Xpos));
+/**
+  * @brief  Gets the display height in the drawing orientation.
+  * @param  Instance LCD Instance
+  * @retval Height in pixels
+  */
+static uint32_t LL_GetHeight(uint32_t Instance)
+{
+  return ((Lcd_Ctx[Instance].Orientation == LCD_ORIENTATION_PORTRAIT) ||
+          (Lcd_Ctx[Instance].Orientation == LCD_ORIENTATION_PORTRAIT_ROT180)) ? Lcd_Ctx[Instance].XSize : Lcd_Ctx[Instance].YSize;
+}
 
-  /* Write line */
-  LL_FillBuffer(Instance, (uint32_t *)Xaddress, 1, Length, (Lcd_Ctx[Instance].XSize - 1U), Color);
+/**
+  * @brief  Transforms a rectangle from drawing coordinates to panel (landscape)
+  *         coordinates. The rectangle must fit in the display.
+  * @param  Instance LCD Instance
+  * @param  Xpos Pointer to X position
+  * @param  Ypos Pointer to Y position
+  * @param  Width Pointer to width
+  * @param  Height Pointer to height
+  * @retval None
+  */
+static void LL_TransformRect(uint32_t Instance, uint32_t *Xpos, uint32_t *Ypos, uint32_t *Width, uint32_t *Height)
+{
+  uint32_t x = *Xpos, y = *Ypos, width = *Width, height = *Height;
 
-  return BSP_ERROR_NONE;
+  switch(Lcd_Ctx[Instance].Orientation)
+  {
+  case LCD_ORIENTATION_PORTRAIT:          /* px = XSize - 1 - y, py = x */
+    *Xpos   = Lcd_Ctx[Instance].XSize - y - height;
+    *Ypos   = x;
+    *Width  = height;
+    *Height = width;
+    break;
+  case LCD_ORIENTATION_PORTRAIT_ROT180:   /* px = y, py = YSize - 1 - x */
+    *Xpos   = y;
+    *Ypos   = Lcd_Ctx[Instance].YSize - x - width;
+    *Width  = height;
+    *Height = width;
+    break;
+  case LCD_ORIENTATION_LANDSCAPE_ROT180:  /* px = XSize - 1 - x, py = YSize - 1 - y */
+    *Xpos   = Lcd_Ctx[Instance].XSize - x - width;
+    *Ypos   = Lcd_Ctx[Instance].YSize - y - height;
+    break;
+  case LCD_ORIENTATION_LANDSCAPE:
+  default:
+    break;
+  }
 }
 
 /**
-  * @brief  Draws a full rectangle in currently active layer.
-  * @param  Instance   LCD Instance
+  * @brief  Gets the frame buffer address of a pixel given in drawing
+  *         coordinates and the address steps of the drawing axes.
+  * @param  Instance LCD Instance
   * @param  Xpos X position
   * @param  Ypos Y position
-  * @param  Width Rectangle width
-  * @param  Height Rectangle height
-  * @param  Color RGB color
+  * @param  Address Pointer to the pixel address
+  * @param  XStep Pointer to the step in bytes to the next pixel on X, may be NULL
+  * @param  YStep Pointer to the step in bytes to the next pixel on Y, may be NULL
   * @retval BSP status
   */
-int32_t BSP_LCD_FillRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Color)
+static int32_t LL_GetPixelAddress(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t *Address, int32_t *XStep,
+                                  int32_t *YStep)
 {
-  uint32_t  Xaddress;
+  int32_t  ret;
+  uint32_t address;
+  uint32_t x = Xpos, y = Ypos, width = 1U, height = 1U;
+  int32_t  bpp    = (int32_t)Lcd_Ctx[Instance].BppFactor;
+  int32_t  stride = (int32_t)(Lcd_Ctx[Instance].XSize * Lcd_Ctx[Instance].BppFactor);
+  int32_t  xstep, ystep;
 
-  /* Get the rectangle start address */
-  Xaddress = (hlcd_ltdc.LayerCfg[Lcd_Ctx[Instance].ActiveLayer].FBStartAdress) + (Lcd_Ctx[Instance].BppFactor*((Lcd_Ctx[Instance].XSize*Ypos) + Xpos));
+  LL_TransformRect(Instance, &x, &y, &width, &height);
 
-  /* Fill the rectangle */
-  LL_FillBuffer(Instance, (uint32_t *)Xaddress, Width, Height, (Lcd_Ctx[Instance].XSize - Width), Color);
+  switch(Lcd_Ctx[Instance].Orientation)
+  {
+  case LCD_ORIENTATION_PORTRAIT:
+    xstep = stride;
+    ystep = -bpp;
+    break;
+  case LCD_ORIENTATION_PORTRAIT_ROT180:
+    xstep = -stride;
+    ystep = bpp;
+    break;
+  case LCD_ORIENTATION_LANDSCAPE_ROT180:
+    xstep = -bpp;
+    ystep = -stride;
+    break;
+  case LCD_ORIENTATION_LANDSCAPE:
+  default:
+    xstep = bpp;
+    ystep = stride;
+    break;
+  }
+
+  if (XStep != NULL)
+  {
+    *XStep = xstep;
+  }
+  if (YStep != NULL)
+  {
+    *YStep = ystep;
+  }
+
+  ret = LL_GetDrawAddress(Instance, &address);
+  *Address = address + (y * (uint32_t)stride) + (x * (uint32_t)bpp);
 
-  return BSP_ERROR_NONE;
+  return ret;
 }
 
 /**
-  * @brief  Reads a LCD pixel.
-  * @param  Instance    LCD Instance
-  * @param  Xpos X position
-  * @param  Ypos Y position
-  * @param  Color RGB pixel color
+  * @brief  Gets the address written by the draw APIs: the back buffer when the
+  *         frame buffer manager is used on the active layer, the layer address
+  *         otherwise.
+  * @param  Instance LCD Instance
+  * @param  Address Pointer to the frame buffer address
+  * @retval BSP status, BSP_ERROR_BUSY when the back buffer is still displayed
+  *         (pending flip not completed within LCD_FB_SWAP_TIMEOUT) or cannot
+  *         be refreshed from the last displayed frame
+  */
+static int32_t LL_GetDrawAddress(uint32_t Instance, uint32_t *Address)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  uint32_t address;
+  uint32_t tickstart;
+  LCD_FB_Ctx_t *fb = &Lcd_Fb[Instance];
+
+  if ((fb->NbBuffers > 1U) && (fb->LayerIndex == Lcd_Ctx[Instance].ActiveLayer))
+  {
+    /* Double buffering: the back buffer is still scanned out until the
+       pending flip is completed */
+    tickstart = HAL_GetTick();
+    while ((ret == BSP_ERROR_NONE) && (fb->PendingIndex != LCD_FB_NONE) && (fb->BackIndex == fb->FrontIndex))
+    {
+      if ((HAL_GetTick() - tickstart) > LCD_FB_SWAP_TIMEOUT)
+      {
+        ret = BSP_ERROR_BUSY;
+      }
+    }
+
+    if ((ret == BSP_ERROR_NONE) && (fb->SyncIndex != LCD_FB_NONE))
+    {
+      ret = LL_SyncBackBuffer(Instance);
+    }
+
+    address = fb->Address[fb->BackIndex];
+  }
+  else
+  {
+    address = hlcd_ltdc.LayerCfg[Lcd_Ctx[Instance].ActiveLayer].FBStartAdress;
+  }
+
+  if (ret == BSP_ERROR_NONE)
+  {
+    /* Cache the draw address for the inline pixel accessors. They do not
+       transform the rotated coordinates, do not wait for DMA2D and do not
+       update the dirty areas: the address is only cached in landscape, for
+       16-bit and 32-bit pixels, with no DMA2D job in flight and when the
+       frame buffer manager does not drive the active layer. Stride is
+       written first, the accessors only test the address */
+    Lcd_Ctx[Instance].FbStride  = Lcd_Ctx[Instance].XSize * Lcd_Ctx[Instance].BppFactor;
+    Lcd_Ctx[Instance].FbAddress = ((Lcd_Ctx[Instance].Orientation == LCD_ORIENTATION_LANDSCAPE) &&
+                                   ((Lcd_Ctx[Instance].BppFactor == 2U) || (Lcd_Ctx[Instance].BppFactor == 4U)) &&
+                                   (Lcd_Dma2dCompleted == Lcd_Dma2dSubmitted) &&
+                                   ((fb->NbBuffers < 2U) || (fb->LayerIndex != Lcd_Ctx[Instance].ActiveLayer))) ? address : 0U;
+  }
+  else
+  {
+    Lcd_Ctx[Instance].FbAddress = 0U;
+  }
+
+  *Address = address;
+
+  return ret;
+}
+
+/**
+  * @brief  Applies the layer shadow registers, unless the reload is disabled.
+  *         While a buffer flip is pending they are reloaded with it at the
+  *         next vertical blanking: an immediate reload would display the
+  *         pending buffer in the middle of a frame.
+  * @param  Instance LCD Instance
   * @retval BSP status
   */
-int32_t BSP_LCD_ReadPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t *Color)
+static int32_t LL_ReloadLayers(uint32_t Instance)
 {
-  if (hlcd_ltdc.LayerCfg[Lcd_Ctx[Instance].ActiveLayer].PixelFormat == LTDC_PIXEL_FORMAT_ARGB8888)
+  int32_t ret = BSP_ERROR_NONE;
+
+  if (Lcd_Ctx[Instance].ReloadEnable == 0U)
+  {
+    /* Nothing to do, the application reloads the registers */
+  }
+  else if ((Lcd_Fb[Instance].NbBuffers > 1U) && (Lcd_Fb[Instance].PendingIndex != LCD_FB_NONE))
   {
-    /* Read data value from RAM memory */
-    *Color = *(__IO uint32_t*) (hlcd_ltdc.LayerCfg[Lcd_Ctx[Instance].ActiveLayer].FBStartAdress + (4U*((Ypos*Lcd_Ctx[Instance].XSize) + Xpos)));
+    if (HAL_LTDC_Reload(&hlcd_ltdc, LTDC_RELOAD_VERTICAL_BLANKING) != HAL_OK)
+    {
+      ret = BSP_ERROR_PERIPH_FAILURE;
+    }
   }
-  else /* if ((hlcd_ltdc.LayerCfg[layer].PixelFormat == LTDC_PIXEL_FORMAT_RGB565) */
+  else
   {
-    /* Read data value from RAM memory */
-    *Color = *(__IO uint16_t*) (hlcd_ltdc.LayerCfg[Lcd_Ctx[Instance].ActiveLayer].FBStartAdress + (2U*((Ypos*Lcd_Ctx[Instance].XSize) + Xpos)));
+    __HAL_LTDC_RELOAD_IMMEDIATE_CONFIG(&hlcd_ltdc);
   }
 
-  return BSP_ERROR_NONE;
+  return ret;
 }
 
 /**
-  * @brief  Draws a pixel on LCD.
-  * @param  Instance    LCD Instance
-  * @param  Xpos X position
-  * @param  Ypos Y position
-  * @param  Color Pixel color
+  * @brief  Programs the sprite layer shadow registers: the window is clipped
+  *         to the panel, the start address skips the clipped pixels and the
+  *         pitch stays the sprite width. The registers are reloaded at the
+  *         next vertical blanking, unless the reload is disabled.
+  * @param  Instance LCD Instance
   * @retval BSP status
   */
-int32_t BSP_LCD_WritePixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Color)
+static int32_t LL_UpdateSprite(uint32_t Instance)
 {
-  if (hlcd_ltdc.LayerCfg[Lcd_Ctx[Instance].ActiveLayer].PixelFormat == LTDC_PIXEL_FORMAT_ARGB8888)
+  int32_t ret = BSP_ERROR_NONE;
+  int32_t left, top, x0, y0, x1, y1;
+  LCD_Sprite_Ctx_t *sprite = &Lcd_Sprite[Instance];
+  LTDC_LayerCfgTypeDef *layer = &hlcd_ltdc.LayerCfg[LCD_SPRITE_LAYER];
+
+  left = sprite->Xpos - (int32_t)sprite->Sprite.HotSpotX;
+  top  = sprite->Ypos - (int32_t)sprite->Sprite.HotSpotY;
+  x0   = LCD_MAX(left, 0);
+  y0   = LCD_MAX(top, 0);
+  x1   = LCD_MIN(left + (int32_t)sprite->Sprite.Width, (int32_t)Lcd_Ctx[Instance].XSize);
+  y1   = LCD_MIN(top + (int32_t)sprite->Sprite.Height, (int32_t)Lcd_Ctx[Instance].YSize);
+
+  if ((sprite->Shown == 0U) || (x0 >= x1) || (y0 >= y1))
   {
-    /* Write data value to RAM memory */
-    *(__IO uint32_t*) (hlcd_ltdc.LayerCfg[Lcd_Ctx[Instance].ActiveLayer].FBStartAdress + (4U*((Ypos*Lcd_Ctx[Instance].XSize) + Xpos))) = Color;
+    __HAL_LTDC_LAYER_DISABLE(&hlcd_ltdc, LCD_SPRITE_LAYER);
   }
   else
   {
-    /* Write data value to RAM memory */
-    *(__IO uint16_t*) (hlcd_ltdc.LayerCfg[Lcd_Ctx[Instance].ActiveLayer].FBStartAdress + (2U*((Ypos*Lcd_Ctx[Instance].XSize) + Xpos))) = (uint16_t)Color;
+    layer->WindowX0    = (uint32_t)x0;
+    layer->WindowX1    = (uint32_t)x1;
+    layer->WindowY0    = (uint32_t)y0;
+    layer->WindowY1    = (uint32_t)y1;
+    layer->ImageWidth  = sprite->Sprite.Width;
+    layer->ImageHeight = (uint32_t)(y1 - y0);
+
+    /* Writes the whole layer configuration and enables the layer */
+    (void)HAL_LTDC_SetAddress_NoReload(&hlcd_ltdc, (uint32_t)sprite->Sprite.pImage +
+                                       (((((uint32_t)(y0 - top)) * sprite->Sprite.Width) + (uint32_t)(x0 - left)) * sprite->Bpp),
+                                       LCD_SPRITE_LAYER);
+  }
+
+  if (Lcd_Ctx[Instance].ReloadEnable == 1U)
+  {
+    if (HAL_LTDC_Reload(&hlcd_ltdc, LTDC_RELOAD_VERTICAL_BLANKING) != HAL_OK)
+    {
+      ret = BSP_ERROR_PERIPH_FAILURE;
+    }
   }
 
-  return BSP_ERROR_NONE;
+  return ret;
 }
 
 /**
-  * @}
+  * @brief  Records an area written in the back buffer: it becomes stale in
+  *         all the other frame buffers.
+  * @param  Instance LCD Instance
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  Width    Area width
+  * @param  Height   Area height
+  * @retval None
   */
+static void LL_MarkDirty(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height)
+{
+  uint32_t i;
+  uint32_t x = Xpos, y = Ypos, width, height;
+  LCD_Rect_t rect;
+  LCD_FB_Ctx_t *fb = &Lcd_Fb[Instance];
 
-/** @defgroup STM32H7S78_DK_LCD_Private_Functions STM32H7S78_DK LCD Private Functions
-  * @{
+  if ((fb->NbBuffers > 1U) && (fb->LayerIndex == Lcd_Ctx[Instance].ActiveLayer) &&
+      (Xpos < LL_GetWidth(Instance)) && (Ypos < LL_GetHeight(Instance)) && (Width != 0U) && (Height != 0U))
+  {
+    /* Clip the area to the display then move it to panel coordinates */
+    width  = ((LL_GetWidth(Instance) - Xpos) > Width)   ? Width  : (LL_GetWidth(Instance) - Xpos);
+    height = ((LL_GetHeight(Instance) - Ypos) > Height) ? Height : (LL_GetHeight(Instance) - Ypos);
+    LL_TransformRect(Instance, &x, &y, &width, &height);
+
+    rect.X0 = x;
+    rect.Y0 = y;
+    rect.X1 = x + width;
+    rect.Y1 = y + height;
+
+    for (i = 0U; i < fb->NbBuffers; i++)
+    {
+      if (i != fb->BackIndex)
+      {
+        LL_AddDirtyRect(fb, i, &rect);
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Adds a rectangle to the dirty list of a buffer. Overlapping or
+  *         adjacent rectangles are merged, when the list is full the new
+  *         rectangle is merged with the one giving the smallest area.
+  * @param  Fb    Frame buffer manager context
+  * @param  Index Buffer index
+  * @param  Rect  Rectangle to add
+  * @retval None
   */
+static void LL_AddDirtyRect(LCD_FB_Ctx_t *Fb, uint32_t Index, LCD_Rect_t *Rect)
+{
+  uint32_t i, best = 0U;
+  uint32_t area, best_area = 0xFFFFFFFFU;
+  uint32_t merged = 1U;
+  LCD_Rect_t *list = Fb->Dirty[Index];
+
+  /* Absorb all the rectangles touching the new one, the union may then
+     touch other ones */
+  while (merged != 0U)
+  {
+    merged = 0U;
+    for (i = 0U; i < Fb->DirtyNbr[Index]; i++)
+    {
+      if ((Rect->X0 <= list[i].X1) && (list[i].X0 <= Rect->X1) &&
+          (Rect->Y0 <= list[i].Y1) && (list[i].Y0 <= Rect->Y1))
+      {
+        Rect->X0 = LCD_MIN(Rect->X0, list[i].X0);
+        Rect->Y0 = LCD_MIN(Rect->Y0, list[i].Y0);
+        Rect->X1 = LCD_MAX(Rect->X1, list[i].X1);
+        Rect->Y1 = LCD_MAX(Rect->Y1, list[i].Y1);
+
+        /* Remove the absorbed rectangle */
+        Fb->DirtyNbr[Index]--;
+        list[i] = list[Fb->DirtyNbr[Index]];
+        merged = 1U;
+        break;
+      }
+    }
+  }
+
+  if (Fb->DirtyNbr[Index] < LCD_DIRTY_RECTS_NBR)
+  {
+    list[Fb->DirtyNbr[Index]] = *Rect;
+    Fb->DirtyNbr[Index]++;
+  }
+  else
+  {
+    for (i = 0U; i < LCD_DIRTY_RECTS_NBR; i++)
+    {
+      area = (LCD_MAX(Rect->X1, list[i].X1) - LCD_MIN(Rect->X0, list[i].X0)) *
+             (LCD_MAX(Rect->Y1, list[i].Y1) - LCD_MIN(Rect->Y0, list[i].Y0));
+      if (area < best_area)
+      {
+        best_area = area;
+        best      = i;
+      }
+    }
+
+    list[best].X0 = LCD_MIN(Rect->X0, list[best].X0);
+    list[best].Y0 = LCD_MIN(Rect->Y0, list[best].Y0);
+    list[best].X1 = LCD_MAX(Rect->X1, list[best].X1);
+    list[best].Y1 = LCD_MAX(Rect->Y1, list[best].Y1);
+  }
+}
+
 /**
-  * @brief  Fills a buffer.
+  * @brief  Blends an A8 text mask with a color, clipped to the display: only
+  *         the part of the mask inside the display is read, parts starting
+  *         left of or above the display included.
   * @param  Instance LCD Instance
-  * @param  pDst Pointer to destination buffer
-  * @param  xSize Buffer width
-  * @param  ySize Buffer height
-  * @param  OffLine Offset
-  * @param  Color RGB color
+  * @param  Xpos X position of the mask left side, may be negative
+  * @param  Ypos Y position of the mask top, may be negative
+  * @param  pMask Pointer to the A8 mask
+  * @param  Width Mask width
+  * @param  Height Mask height
+  * @param  Color Color in the layer pixel format
+  * @retval BSP status, BSP_ERROR_NONE when the mask is outside the display
+  */
+static int32_t LL_BlendTextMask(uint32_t Instance, int32_t Xpos, int32_t Ypos, const uint8_t *pMask, uint32_t Width,
+                                uint32_t Height, uint32_t Color)
+{
+  int32_t  ret = BSP_ERROR_NONE;
+  int32_t  x0, y0, x1, y1;
+  uint32_t width, height, address;
+  LCD_DMA2D_Job_t job;
+
+  /* Visible part of the mask */
+  x0 = LCD_MAX(Xpos, 0);
+  y0 = LCD_MAX(Ypos, 0);
+  x1 = LCD_MIN(Xpos + (int32_t)Width, (int32_t)LL_GetWidth(Instance));
+  y1 = LCD_MIN(Ypos + (int32_t)Height, (int32_t)LL_GetHeight(Instance));
+
+  if (Lcd_Ctx[Instance].BppFactor == 1U)
+  {
+    /* 8-bit layers cannot be blended */
+    ret = BSP_ERROR_FEATURE_NOT_SUPPORTED;
+  }
+  else if ((x0 < x1) && (y0 < y1))
+  {
+    width  = (uint32_t)(x1 - x0);
+    height = (uint32_t)(y1 - y0);
+
+    job.Mode            = DMA2D_M2M_BLEND;
+    job.InputColorMode  = DMA2D_INPUT_A8;
+    job.InputOffset     = Width - width;
+    job.AlphaMode       = DMA2D_COMBINE_ALPHA;
+    job.Src             = (uint32_t)&pMask[((uint32_t)(y0 - Ypos) * Width) + (uint32_t)(x0 - Xpos)];
+    job.Width           = width;
+    job.Height          = height;
+    job.OutputOffset    = Lcd_Ctx[Instance].XSize - width;
+    job.SrcPitch        = 0;
+    job.DstPitch        = 0;
+
+    /* Foreground color and constant alpha are given in ARGB8888 */
+    job.OutputColorMode = LL_GetOutputColorMode(Instance);
+    job.InputAlpha      = LL_ConvertToARGB8888(Instance, Color);
+
+#if (USE_BSP_CPU_CACHE_MAINTENANCE == 1)
+    SCB_CleanDCache_by_Addr((uint32_t *)job.Src, (int32_t)(((height - 1U) * Width) + width));
+#endif /* USE_BSP_CPU_CACHE_MAINTENANCE */
+
+    ret = LL_GetDrawAddress(Instance, &address);
+    job.Dst = address + (Lcd_Ctx[Instance].BppFactor * ((Lcd_Ctx[Instance].XSize * (uint32_t)y0) + (uint32_t)x0));
+
+    if (ret == BSP_ERROR_NONE)
+    {
+      ret = LL_SubmitRect(Instance, &job, (uint32_t)x0, (uint32_t)y0);
+    }
+
+    if (ret == BSP_ERROR_NONE)
+    {
+      LL_MarkDirty(Instance, (uint32_t)x0, (uint32_t)y0, width, height);
+    }
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Gets the descriptor of a character.
+  * @param  pFont Pointer to the font
+  * @param  Char Character
+  * @retval Pointer to the glyph, NULL when the font lacks the character
   */
-static void LL_FillBuffer(uint32_t Instance, uint32_t *pDst, uint32_t xSize, uint32_t ySize, uint32_t OffLine, uint32_t Color)
+static const BSP_LCD_Glyph_t *LL_GetGlyph(const BSP_LCD_Font_t *pFont, uint8_t Char)
 {
-  uint32_t output_color_mode, input_color = Color;
+  const BSP_LCD_Glyph_t *glyph = NULL;
 
-  switch(Lcd_Ctx[Instance].PixelFormat)
+  if ((Char >= pFont->FirstChar) && ((Char - pFont->FirstChar) < pFont->NbGlyphs))
   {
-  case LCD_PIXEL_FORMAT_RGB565:
-    output_color_mode = DMA2D_OUTPUT_RGB565; /* RGB565 */
-    input_color = CONVERTRGB5652ARGB8888(Color);
-    break;
-  case LCD_PIXEL_FORMAT_RGB888:
-  default:
-    output_color_mode = DMA2D_OUTPUT_ARGB8888; /* ARGB8888 */
-    break;
+    glyph = &pFont->pGlyphs[Char - pFont->FirstChar];
   }
 
-  /* Register to memory mode with ARGB8888 as color Mode */
-  hlcd_dma2d.Init.Mode         = DMA2D_R2M;
-  hlcd_dma2d.Init.ColorMode    = output_color_mode;
-  hlcd_dma2d.Init.OutputOffset = OffLine;
+  return glyph;
+}
 
-  hlcd_dma2d.Instance = DMA2D;
+/**
+  * @brief  Gets the width of a glyph run: the pen advances, extended to the
+  *         right side of the last glyph bitmap.
+  * @param  pFont Pointer to the font
+  * @param  pText Pointer to the string
+  * @param  Length String length
+  * @retval Width in pixels
+  */
+static uint32_t LL_GetRunWidth(const BSP_LCD_Font_t *pFont, const char *pText, uint32_t Length)
+{
+  uint32_t i, pen = 0U, width = 0U;
+  int32_t right;
+  const BSP_LCD_Glyph_t *glyph;
 
-  /* DMA2D Initialization */
-  if (HAL_DMA2D_Init(&hlcd_dma2d) == HAL_OK)
+  for (i = 0U; i < Length; i++)
   {
-    if (HAL_DMA2D_Start(&hlcd_dma2d, input_color, (uint32_t)pDst, xSize, ySize) == HAL_OK)
+    glyph = LL_GetGlyph(pFont, (uint8_t)pText[i]);
+    if (glyph != NULL)
     {
-      /* Polling For DMA transfer */
-      (void)HAL_DMA2D_PollForTransfer(&hlcd_dma2d, 50);
+      right = (int32_t)pen + glyph->XOffset + (int32_t)glyph->Width;
+      pen  += glyph->Advance;
+      width = LCD_MAX(width, pen);
+      width = ((right > 0) && ((uint32_t)right > width)) ? (uint32_t)right : width;
     }
   }
+
+  return width;
 }
 
+#if (USE_BSP_LCD_TEXT_CACHE == 1)
 /**
-  * @brief  Converts a line to an RGB pixel format.
-  * @param  Instance LCD Instance
-  * @param  pSrc Pointer to source buffer
-  * @param  pDst Output color
-  * @param  xSize Buffer width
-  * @param  ColorMode Input color mode
+  * @brief  Composes the glyphs of a string in a run. Overlapping glyphs keep
+  *         the highest coverage, glyph parts outside the run are clipped.
+  * @param  pRun Pointer to the run, font, size and length already set
+  * @param  pText Pointer to the string
+  * @retval None
   */
-static void LL_ConvertLineToRGB(uint32_t Instance, uint32_t *pSrc, uint32_t *pDst, uint32_t xSize, uint32_t ColorMode)
+static void LL_ComposeRun(LCD_TextRun_t *pRun, const char *pText)
 {
-  uint32_t output_color_mode;
+  uint32_t i, x, y, pen = 0U;
+  int32_t  dx, dy;
+  uint8_t  alpha;
+  const uint8_t *pglyph;
+  const BSP_LCD_Glyph_t *glyph;
 
-  switch(Lcd_Ctx[Instance].PixelFormat)
+  LL_CPU_FillLine((uint32_t)pRun->Run, pRun->Width * pRun->Height, 0U, 1U);
+
+  for (i = 0U; i < pRun->Length; i++)
   {
-  case LCD_PIXEL_FORMAT_RGB565:
-    output_color_mode = DMA2D_OUTPUT_RGB565; /* RGB565 */
-    break;
-  case LCD_PIXEL_FORMAT_RGB888:
-  default:
-    output_color_mode = DMA2D_OUTPUT_ARGB8888; /* ARGB8888 */
-    break;
+    glyph = LL_GetGlyph(pRun->pFont, (uint8_t)pText[i]);
+    if (glyph != NULL)
+    {
+      pglyph = &pRun->pFont->pAtlas[glyph->Offset];
+
+      for (y = 0U; y < glyph->Height; y++)
+      {
+        dy = glyph->YOffset + (int32_t)y;
+        for (x = 0U; (dy >= 0) && ((uint32_t)dy < pRun->Height) && (x < glyph->Width); x++)
+        {
+          dx    = (int32_t)pen + glyph->XOffset + (int32_t)x;
+          alpha = pglyph[(y * glyph->Width) + x];
+          if ((dx >= 0) && ((uint32_t)dx < pRun->Width) && (alpha > pRun->Run[((uint32_t)dy * pRun->Width) + (uint32_t)dx]))
+          {
+            pRun->Run[((uint32_t)dy * pRun->Width) + (uint32_t)dx] = alpha;
+          }
+        }
+      }
+      pen += glyph->Advance;
+    }
   }
 
-  /* Configure the DMA2D Mode, Color Mode and output offset */
-  hlcd_dma2d.Init.Mode         = DMA2D_M2M_PFC;
-  hlcd_dma2d.Init.ColorMode    = output_color_mode;
-  hlcd_dma2d.Init.OutputOffset = 0;
+  for (i = 0U; i < pRun->Length; i++)
+  {
+    pRun->Text[i] = pText[i];
+  }
+}
 
-  /* Foreground Configuration */
-  hlcd_dma2d.LayerCfg[1].AlphaMode = DMA2D_NO_MODIF_ALPHA;
-  hlcd_dma2d.LayerCfg[1].InputAlpha = 0xFF;
-  hlcd_dma2d.LayerCfg[1].InputColorMode = ColorMode;
-  hlcd_dma2d.LayerCfg[1].InputOffset = 0;
-  hlcd_dma2d.LayerCfg[1].AlphaInverted = DMA2D_REGULAR_ALPHA;
+/**
+  * @brief  Gets the cached run of a string, composing it in the least
+  *         recently used entry on a miss.
+  * @param  Instance LCD Instance
+  * @param  pFont Pointer to the font
+  * @param  pText Pointer to the string
+  * @param  Length String length, up to LCD_TEXT_MAX_LENGTH
+  * @param  Width Run width, the run fits in LCD_TEXT_RUN_SIZE
+  * @retval Pointer to the run
+  */
+static LCD_TextRun_t *LL_GetTextRun(uint32_t Instance, const BSP_LCD_Font_t *pFont, const char *pText, uint32_t Length, uint32_t Width)
+{
+  uint32_t i, c, lru = 0U;
+  LCD_TextRun_t *run = NULL;
 
-  hlcd_dma2d.Instance = DMA2D;
+  Lcd_TextClock++;
 
-  /* DMA2D Initialization */
-  if (HAL_DMA2D_Init(&hlcd_dma2d) == HAL_OK)
+  for (i = 0U; (i < LCD_TEXT_CACHE_NBR) && (run == NULL); i++)
   {
-    if (HAL_DMA2D_ConfigLayer(&hlcd_dma2d, 1) == HAL_OK)
+    if ((Lcd_TextRuns[i].pFont == pFont) && (Lcd_TextRuns[i].Length == Length))
     {
-      if (HAL_DMA2D_Start(&hlcd_dma2d, (uint32_t)pSrc, (uint32_t)pDst, xSize, 1) == HAL_OK)
+      for (c = 0U; (c < Length) && (Lcd_TextRuns[i].Text[c] == pText[c]); c++)
       {
-        /* Polling For DMA transfer */
-        (void)HAL_DMA2D_PollForTransfer(&hlcd_dma2d, 50);
       }
+      if (c == Length)
+      {
+        run = &Lcd_TextRuns[i];
+      }
+    }
+    if (Lcd_TextRuns[i].LastUse < Lcd_TextRuns[lru].LastUse)
+    {
+      lru = i;
     }
   }
+
+  if (run == NULL)
+  {
+    run = &Lcd_TextRuns[lru];
+
+#if (USE_BSP_LCD_DMA2D_ASYNC == 1)
+    /* The run may still be read by a queued blend */
+    (void)BSP_LCD_WaitFence(Instance, run->Fence, LCD_DMA2D_TIMEOUT);
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
+
+    run->pFont  = pFont;
+    run->Length = Length;
+    run->Width  = Width;
+    run->Height = pFont->LineHeight;
+    LL_ComposeRun(run, pText);
+  }
+
+  run->LastUse = Lcd_TextClock;
+
+  return run;
+}
+#endif /* USE_BSP_LCD_TEXT_CACHE */
+
+#if (USE_BSP_LCD_STATS == 1)
+/**
+  * @brief  Records the latency of a draw API call.
+  * @param  Primitive BSP_LCD_STATS_xxx
+  * @param  Start Cycle counter at the call start
+  * @param  Pixels Pixels written by the call
+  * @retval None
+  */
+static void LL_StatsRecord(uint32_t Primitive, uint32_t Start, uint32_t Pixels)
+{
+  uint32_t cycles = DWT->CYCCNT - Start;
+  BSP_LCD_Stats_t *stats = &Lcd_Stats[Primitive];
+
+  stats->Count++;
+  stats->TotalCycles += cycles;
+  stats->Pixels      += Pixels;
+  stats->MinCycles    = LCD_MIN(stats->MinCycles, cycles);
+  stats->MaxCycles    = LCD_MAX(stats->MaxCycles, cycles);
+
+  /* Bin of the most significant bit */
+  stats->Histogram[31U - __CLZ(cycles | 1U)]++;
+}
+#endif /* USE_BSP_LCD_STATS */
+
+/**
+  * @brief  Copies the dirty areas of the back buffer from the last flipped
+  *         buffer with DMA2D memory to memory jobs. The copy is kept
+  *         pending on error, so that it is submitted again by the next draw.
+  * @param  Instance LCD Instance
+  * @retval BSP status
+  */
+static int32_t LL_SyncBackBuffer(uint32_t Instance)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  uint32_t i, offset;
+  uint32_t bpp = Lcd_Ctx[Instance].BppFactor;
+  LCD_FB_Ctx_t *fb = &Lcd_Fb[Instance];
+  LCD_Rect_t *rect;
+  LCD_DMA2D_Job_t job;
+
+  job.Mode            = DMA2D_M2M;
+  job.OutputColorMode = LL_GetOutputColorMode(Instance);
+  job.InputColorMode  = LL_GetLayerInputColorMode(Instance);
+  job.AlphaMode       = DMA2D_NO_MODIF_ALPHA;
+  job.InputAlpha      = 0xFFU;
+  job.SrcPitch        = 0;
+  job.DstPitch        = 0;
+
+  for (i = 0U; (i < fb->DirtyNbr[fb->BackIndex]) && (ret == BSP_ERROR_NONE); i++)
+  {
+    rect   = &fb->Dirty[fb->BackIndex][i];
+    offset = bpp * ((Lcd_Ctx[Instance].XSize * rect->Y0) + rect->X0);
+
+    job.Src          = fb->Address[fb->SyncIndex] + offset;
+    job.Dst          = fb->Address[fb->BackIndex] + offset;
+    job.Width        = rect->X1 - rect->X0;
+    job.Height       = rect->Y1 - rect->Y0;
+    job.InputOffset  = Lcd_Ctx[Instance].XSize - job.Width;
+    job.OutputOffset = job.InputOffset;
+
+    ret = LL_DMA2D_Submit(Instance, &job);
+  }
+
+  if (ret == BSP_ERROR_NONE)
+  {
+    fb->DirtyNbr[fb->BackIndex] = 0U;
+    fb->SyncIndex = LCD_FB_NONE;
+  }
+
+  return ret;
 }
 
 /**
@@ -1431,6 +5291,9 @@ static void LTDC_MspDeInit(LTDC_HandleTypeDef *hltdc)
 
   if (hltdc->Instance == LTDC)
   {
+    /** Disable IRQ of LTDC IP */
+    HAL_NVIC_DisableIRQ(LTDC_IRQn);
+
     /* LTDC Pins deactivation */
     /* GPIOA deactivation */
     gpio_init_structure.Pin       = GPIO_PIN_0|GPIO_PIN_1|GPIO_PIN_8|GPIO_PIN_11 |GPIO_PIN_12| GPIO_PIN_15 | GPIO_PIN_6 | GPIO_PIN_9|GPIO_PIN_10;
@@ -1475,6 +5338,12 @@ static void DMA2D_MspInit(DMA2D_HandleTypeDef *hdma2d)
     /** Toggle Sw reset of DMA2D IP */
     __HAL_RCC_DMA2D_FORCE_RESET();
     __HAL_RCC_DMA2D_RELEASE_RESET();
+
+#if (USE_BSP_LCD_DMA2D_ASYNC == 1)
+    /** Enable DMA2D interrupt used to drain the DMA2D queue */
+    HAL_NVIC_SetPriority(DMA2D_IRQn, BSP_LCD_DMA2D_IT_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(DMA2D_IRQn);
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
   }
 }
 
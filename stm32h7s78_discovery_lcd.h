@@ -56,7 +56,10 @@ extern "C" {
   */
 #define LCD_INSTANCES_NBR                1U
 
+#define LCD_ORIENTATION_PORTRAIT         0x00U  /* Portrait orientation choice of LCD screen  */
 #define LCD_ORIENTATION_LANDSCAPE        0x01U  /* Landscape orientation choice of LCD screen */
+#define LCD_ORIENTATION_PORTRAIT_ROT180  0x02U  /* Portrait orientation rotated by 180 degrees  */
+#define LCD_ORIENTATION_LANDSCAPE_ROT180 0x03U  /* Landscape orientation rotated by 180 degrees */
 
 #define LCD_DEFAULT_WIDTH                800
 #define LCD_DEFAULT_HEIGHT               480
@@ -64,6 +67,132 @@ extern "C" {
 #define BSP_LCD_RELOAD_NONE              0U                            /* No reload executed       */
 #define BSP_LCD_RELOAD_IMMEDIATE         LTDC_RELOAD_IMMEDIATE         /* Immediate Reload         */
 #define BSP_LCD_RELOAD_VERTICAL_BLANKING LTDC_RELOAD_VERTICAL_BLANKING /* Vertical Blanking Reload */
+
+/* Layer format with 3 bytes per pixel, LCD_PIXEL_FORMAT_RGB888 selects an
+   ARGB8888 layer */
+#define LCD_PIXEL_FORMAT_RGB888_PACKED   0x10U
+
+/* Blending input formats */
+#define BSP_LCD_INPUT_ARGB8888           DMA2D_INPUT_ARGB8888
+#define BSP_LCD_INPUT_RGB888             DMA2D_INPUT_RGB888
+#define BSP_LCD_INPUT_RGB565             DMA2D_INPUT_RGB565
+#define BSP_LCD_INPUT_L8                 DMA2D_INPUT_L8
+#define BSP_LCD_INPUT_A8                 DMA2D_INPUT_A8
+#define BSP_LCD_INPUT_A4                 DMA2D_INPUT_A4
+
+/* DMA2D command queue: when enabled, draw operations are queued and executed
+   from the DMA2D transfer complete interrupt instead of being polled */
+#ifndef USE_BSP_LCD_DMA2D_ASYNC
+#define USE_BSP_LCD_DMA2D_ASYNC          0U
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
+
+#ifndef LCD_DMA2D_QUEUE_SIZE
+#define LCD_DMA2D_QUEUE_SIZE             16U   /* Number of queued DMA2D jobs, power of 2 */
+#endif /* LCD_DMA2D_QUEUE_SIZE */
+
+#ifndef BSP_LCD_DMA2D_IT_PRIORITY
+#define BSP_LCD_DMA2D_IT_PRIORITY        15U
+#endif /* BSP_LCD_DMA2D_IT_PRIORITY */
+
+/* CPU rendering: the DMA2D transfers of the draw operations are executed by
+   the CPU, DMA2D is left free for another client */
+#ifndef USE_BSP_LCD_CPU_RENDERING
+#define USE_BSP_LCD_CPU_RENDERING        0U
+#endif /* USE_BSP_LCD_CPU_RENDERING */
+
+/* DMA2D rotation: in the rotated orientations, images are rotated by the CPU
+   in small tile buffers and written by one DMA2D transfer per tile */
+#ifndef USE_BSP_LCD_DMA2D_ROTATION
+#define USE_BSP_LCD_DMA2D_ROTATION       0U
+#endif /* USE_BSP_LCD_DMA2D_ROTATION */
+
+#define LCD_DMA2D_TIMEOUT                1000U /* Default timeout (ms) to drain the DMA2D queue */
+
+/* Rendering statistics: per primitive latency histograms measured with the
+   DWT cycle counter */
+#ifndef USE_BSP_LCD_STATS
+#define USE_BSP_LCD_STATS                0U
+#endif /* USE_BSP_LCD_STATS */
+
+#define BSP_LCD_STATS_FILL               0U    /* FillRect, DrawHLine, DrawVLine   */
+#define BSP_LCD_STATS_BITMAP             1U    /* DrawBitmap, DrawRLEBitmap        */
+#define BSP_LCD_STATS_RGB_RECT           2U    /* FillRGBRect                      */
+#define BSP_LCD_STATS_BLEND              3U    /* BlendRGBRect, DrawAlphaBitmap    */
+#define BSP_LCD_STATS_TEXT               4U    /* DrawString                       */
+#define BSP_LCD_STATS_RELOAD             5U    /* Reload, SwapBuffers              */
+#define BSP_LCD_STATS_NBR                6U
+#define BSP_LCD_STATS_BINS               32U   /* Bin n counts latencies in [2^n, 2^(n+1)) cycles */
+
+/* Frame buffer manager: back buffers are allocated in PSRAM from
+   LCD_FRAME_BUFFER_POOL_ADDRESS, one LCD_FRAME_BUFFER_SIZE slot each */
+#ifndef LCD_FB_MAX_BUFFERS
+#define LCD_FB_MAX_BUFFERS               3U    /* Triple buffering */
+#endif /* LCD_FB_MAX_BUFFERS */
+
+#ifndef LCD_FRAME_BUFFER_SIZE
+#define LCD_FRAME_BUFFER_SIZE            0x200000U
+#endif /* LCD_FRAME_BUFFER_SIZE */
+
+#ifndef LCD_FRAME_BUFFER_POOL_ADDRESS
+#define LCD_FRAME_BUFFER_POOL_ADDRESS    (LCD_LAYER_1_ADDRESS + LCD_FRAME_BUFFER_SIZE)
+#endif /* LCD_FRAME_BUFFER_POOL_ADDRESS */
+
+#ifndef BSP_LCD_LTDC_IT_PRIORITY
+#define BSP_LCD_LTDC_IT_PRIORITY         15U
+#endif /* BSP_LCD_LTDC_IT_PRIORITY */
+
+#ifndef LCD_DIRTY_RECTS_NBR
+#define LCD_DIRTY_RECTS_NBR              8U    /* Dirty rectangles tracked per frame buffer */
+#endif /* LCD_DIRTY_RECTS_NBR */
+
+#define LCD_FB_SWAP_TIMEOUT              100U  /* Max time (ms) to wait for a pending flip */
+
+/* RLE images: decoded line by line in a ring of line buffers converted by DMA2D */
+#ifndef USE_BSP_LCD_RLE
+#define USE_BSP_LCD_RLE                  0U
+#endif /* USE_BSP_LCD_RLE */
+
+#ifndef LCD_RLE_MAX_WIDTH
+#define LCD_RLE_MAX_WIDTH                800U  /* Widest decoded line, in pixels */
+#endif /* LCD_RLE_MAX_WIDTH */
+
+#ifndef LCD_RLE_LINE_BUFFERS
+#define LCD_RLE_LINE_BUFFERS             2U    /* Lines decoded ahead of DMA2D */
+#endif /* LCD_RLE_LINE_BUFFERS */
+
+/* RLE image header (little endian):
+     [0..3]  BSP_LCD_RLE_MAGIC
+     [4..5]  width, [6..7] height
+     [8]     pixel format: BSP_LCD_INPUT_ARGB8888, BSP_LCD_INPUT_RGB888,
+             BSP_LCD_INPUT_RGB565 or BSP_LCD_INPUT_L8
+     [9..11] reserved
+   Followed by packets, which may cross lines: a control byte C then
+     C bit 7 set:   one pixel repeated (C & 0x7F) + 1 times
+     C bit 7 reset: (C & 0x7F) + 1 literal pixels */
+#define BSP_LCD_RLE_MAGIC                0x31454C52U /* "RLE1" */
+#define BSP_LCD_RLE_HEADER_SIZE          12U
+
+/* Text engine: strings are composed in A8 glyph runs, kept in a LRU cache */
+#ifndef USE_BSP_LCD_TEXT_CACHE
+#define USE_BSP_LCD_TEXT_CACHE           0U
+#endif /* USE_BSP_LCD_TEXT_CACHE */
+
+#ifndef LCD_TEXT_CACHE_NBR
+#define LCD_TEXT_CACHE_NBR               4U    /* Glyph runs cached in internal SRAM */
+#endif /* LCD_TEXT_CACHE_NBR */
+
+#ifndef LCD_TEXT_RUN_SIZE
+#define LCD_TEXT_RUN_SIZE                4096U /* Max A8 glyph run size in bytes     */
+#endif /* LCD_TEXT_RUN_SIZE */
+
+#ifndef LCD_TEXT_MAX_LENGTH
+#define LCD_TEXT_MAX_LENGTH              32U   /* Longest cached string              */
+#endif /* LCD_TEXT_MAX_LENGTH */
+
+/* Sprite overlay: layer scanning out the sprite image, not usable for drawing */
+#ifndef LCD_SPRITE_LAYER
+#define LCD_SPRITE_LAYER                 1U
+#endif /* LCD_SPRITE_LAYER */
 /**
   * @brief LCD special pins
   */
@@ -189,6 +318,9 @@ typedef struct
   uint32_t IsMspCallbacksValid;
   uint32_t ReloadEnable;
   uint32_t Brightness;
+  uint32_t FbAddress;    /* Cached draw address of the active layer, 0 when not valid */
+  uint32_t FbStride;     /* Cached line size of the active layer in bytes             */
+  uint32_t Orientation;  /* Drawing orientation, XSize and YSize stay the panel sizes */
 } BSP_LCD_Ctx_t;
 
 typedef struct
@@ -204,6 +336,45 @@ typedef struct
 #define BSP_LCD_LayerConfig_t MX_LTDC_LayerConfig_t
 
 
+typedef struct
+{
+  uint32_t Offset;    /* Offset of the A8 bitmap in the atlas, lines are contiguous */
+  uint8_t  Width;     /* Bitmap width                                            */
+  uint8_t  Height;    /* Bitmap height                                           */
+  int8_t   XOffset;   /* Bitmap left side from the pen position                  */
+  int8_t   YOffset;   /* Bitmap top side from the line top                       */
+  uint8_t  Advance;   /* Pen advance                                             */
+} BSP_LCD_Glyph_t;
+
+typedef struct
+{
+  const uint8_t         *pAtlas;     /* A8 glyph bitmaps, e.g. in memory-mapped XSPI NOR */
+  const BSP_LCD_Glyph_t *pGlyphs;    /* Glyph descriptors, one per character             */
+  uint32_t               FirstChar;  /* Character of the first descriptor                */
+  uint32_t               NbGlyphs;   /* Number of descriptors                            */
+  uint32_t               LineHeight; /* Line height in pixels                            */
+} BSP_LCD_Font_t;
+
+typedef struct
+{
+  const uint8_t *pImage;     /* Sprite pixels, scanned out by LTDC: must stay valid while shown */
+  uint32_t PixelFormat;      /* LTDC_PIXEL_FORMAT_xxx, per-pixel alpha formats for cursors      */
+  uint32_t Width;
+  uint32_t Height;
+  uint32_t HotSpotX;         /* Sprite pixel placed at the position given to BSP_LCD_MoveSprite() */
+  uint32_t HotSpotY;
+} BSP_LCD_Sprite_t;
+
+typedef struct
+{
+  uint32_t Count;                            /* Recorded calls                */
+  uint32_t MinCycles;
+  uint32_t MaxCycles;
+  uint64_t TotalCycles;
+  uint64_t Pixels;                           /* Pixels written by the calls   */
+  uint32_t Histogram[BSP_LCD_STATS_BINS];    /* Log2 latency histogram        */
+} BSP_LCD_Stats_t;
+
 #if (USE_HAL_LTDC_REGISTER_CALLBACKS == 1)
 typedef struct
 {
@@ -249,6 +420,13 @@ int32_t BSP_LCD_SetLayerAddress(uint32_t Instance, uint32_t LayerIndex, uint32_t
 int32_t BSP_LCD_SetLayerWindow(uint32_t Instance, uint16_t LayerIndex, uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height);
 int32_t BSP_LCD_SetColorKeying(uint32_t Instance, uint32_t LayerIndex, uint32_t Color);
 int32_t BSP_LCD_ResetColorKeying(uint32_t Instance, uint32_t LayerIndex);
+int32_t BSP_LCD_SetLayerCLUT(uint32_t Instance, uint32_t LayerIndex, const uint32_t *pCLUT, uint32_t Size);
+
+/* LCD sprite overlay APIs */
+int32_t BSP_LCD_ConfigSprite(uint32_t Instance, const BSP_LCD_Sprite_t *pSprite);
+int32_t BSP_LCD_MoveSprite(uint32_t Instance, int32_t Xpos, int32_t Ypos);
+int32_t BSP_LCD_ShowSprite(uint32_t Instance);
+int32_t BSP_LCD_HideSprite(uint32_t Instance);
 
 /* LCD generic APIs: Display control */
 int32_t BSP_LCD_DisplayOn(uint32_t Instance);
@@ -263,6 +441,9 @@ int32_t BSP_LCD_GetYSize(uint32_t Instance, uint32_t *YSize);
 int32_t BSP_LCD_SetActiveLayer(uint32_t Instance, uint32_t LayerIndex);
 int32_t BSP_LCD_GetPixelFormat(uint32_t Instance, uint32_t *PixelFormat);
 int32_t BSP_LCD_DrawBitmap(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pBmp);
+#if (USE_BSP_LCD_RLE == 1)
+int32_t BSP_LCD_DrawRLEBitmap(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, const uint8_t *pData, uint32_t Size);
+#endif /* USE_BSP_LCD_RLE */
 int32_t BSP_LCD_DrawHLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color);
 int32_t BSP_LCD_DrawVLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color);
 int32_t BSP_LCD_FillRGBRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t Width, uint32_t Height);
@@ -270,11 +451,134 @@ int32_t BSP_LCD_FillRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32
 int32_t BSP_LCD_ReadPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t *Color);
 int32_t BSP_LCD_WritePixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Color);
 
+/* LCD fast pixel access APIs */
+int32_t BSP_LCD_ReadSpan(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t *pColors, uint32_t Length);
+int32_t BSP_LCD_WriteSpan(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, const uint32_t *pColors, uint32_t Length);
+
+/* LCD blending APIs */
+int32_t BSP_LCD_BlendRGBRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t Width,
+                             uint32_t Height, uint32_t InputColorMode, uint32_t Alpha);
+int32_t BSP_LCD_DrawAlphaBitmap(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pMask, uint32_t Width,
+                                uint32_t Height, uint32_t MaskFormat, uint32_t Color);
+int32_t BSP_LCD_SetCLUT(uint32_t Instance, const uint32_t *pCLUT, uint32_t Size);
+
+/* LCD text APIs */
+int32_t BSP_LCD_SetFont(uint32_t Instance, const BSP_LCD_Font_t *pFont);
+int32_t BSP_LCD_GetStringWidth(uint32_t Instance, const char *pText, uint32_t *Width);
+int32_t BSP_LCD_DrawString(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, const char *pText, uint32_t Color);
+
+/* LCD DMA2D command queue APIs */
+int32_t BSP_LCD_GetFence(uint32_t Instance, uint32_t *Fence);
+int32_t BSP_LCD_WaitFence(uint32_t Instance, uint32_t Fence, uint32_t Timeout);
+#if (USE_BSP_LCD_DMA2D_ASYNC == 1)
+void    BSP_LCD_DMA2D_IRQHandler(uint32_t Instance);
+#endif /* USE_BSP_LCD_DMA2D_ASYNC */
+
+/* LCD frame buffer manager APIs */
+int32_t BSP_LCD_ConfigFrameBuffers(uint32_t Instance, uint32_t LayerIndex, uint32_t NbBuffers);
+int32_t BSP_LCD_GetBackBuffer(uint32_t Instance, uint32_t *Address);
+int32_t BSP_LCD_InvalidateRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height);
+int32_t BSP_LCD_SwapBuffers(uint32_t Instance);
+void    BSP_LCD_LTDC_IRQHandler(uint32_t Instance);
+void    BSP_LCD_FrameCompleteCallback(uint32_t Instance);
+void    BSP_LCD_ReloadEventCallback(LTDC_HandleTypeDef *hltdc);
+
+#if (USE_BSP_LCD_STATS == 1)
+/* LCD statistics APIs */
+int32_t BSP_LCD_ResetStats(uint32_t Instance);
+int32_t BSP_LCD_GetStats(uint32_t Instance, uint32_t Primitive, BSP_LCD_Stats_t *pStats);
+int32_t BSP_LCD_GetLatencyPercentile(uint32_t Instance, uint32_t Primitive, uint32_t Percent, uint32_t *Cycles);
+#endif /* USE_BSP_LCD_STATS */
+
 /* LCD MX APIs */
 HAL_StatusTypeDef MX_LTDC_ConfigLayer(LTDC_HandleTypeDef *hltdc, uint32_t LayerIndex, MX_LTDC_LayerConfig_t *Config);
 HAL_StatusTypeDef MX_LTDC_ClockConfig(LTDC_HandleTypeDef *hltdc);
 HAL_StatusTypeDef MX_LTDC_Init(LTDC_HandleTypeDef *hltdc, uint32_t Width, uint32_t Height);
 
+/**
+  * @brief  Reads a pixel of the active layer through the cached draw address.
+  *         The address is only cached in landscape orientation, for 16-bit
+  *         and 32-bit layers, with no DMA2D job in flight and when the frame
+  *         buffer manager does not drive the active layer, BSP_LCD_ReadPixel()
+  *         is called otherwise.
+  * @param  Instance LCD Instance
+  * @param  Xpos X position
+  * @param  Ypos Y position
+  * @param  Color Pointer to the pixel color
+  * @retval BSP status
+  */
+__STATIC_INLINE int32_t BSP_LCD_ReadPixelFast(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t *Color)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  if (Instance >= LCD_INSTANCES_NBR)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if (Lcd_Ctx[Instance].FbAddress == 0U)
+  {
+    /* No cached address: rotated orientation, DMA2D job in flight, frame
+       buffer manager or layer change */
+    ret = BSP_LCD_ReadPixel(Instance, Xpos, Ypos, Color);
+  }
+  else if ((Xpos >= Lcd_Ctx[Instance].XSize) || (Ypos >= Lcd_Ctx[Instance].YSize))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if (Lcd_Ctx[Instance].BppFactor == 4U)
+  {
+    *Color = *(__IO uint32_t *)(Lcd_Ctx[Instance].FbAddress + (Ypos * Lcd_Ctx[Instance].FbStride) + (4U * Xpos));
+  }
+  else
+  {
+    *Color = *(__IO uint16_t *)(Lcd_Ctx[Instance].FbAddress + (Ypos * Lcd_Ctx[Instance].FbStride) + (2U * Xpos));
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Writes a pixel of the active layer through the cached draw address.
+  *         The address is only cached in landscape orientation, for 16-bit
+  *         and 32-bit layers, with no DMA2D job in flight and when the frame
+  *         buffer manager does not drive the active layer, BSP_LCD_WritePixel()
+  *         is called otherwise.
+  * @param  Instance LCD Instance
+  * @param  Xpos X position
+  * @param  Ypos Y position
+  * @param  Color Pixel color
+  * @retval BSP status
+  */
+__STATIC_INLINE int32_t BSP_LCD_WritePixelFast(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Color)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  if (Instance >= LCD_INSTANCES_NBR)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if (Lcd_Ctx[Instance].FbAddress == 0U)
+  {
+    /* No cached address: rotated orientation, DMA2D job in flight, frame
+       buffer manager or layer change */
+    ret = BSP_LCD_WritePixel(Instance, Xpos, Ypos, Color);
+  }
+  else if ((Xpos >= Lcd_Ctx[Instance].XSize) || (Ypos >= Lcd_Ctx[Instance].YSize))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if (Lcd_Ctx[Instance].BppFactor == 4U)
+  {
+    *(__IO uint32_t *)(Lcd_Ctx[Instance].FbAddress + (Ypos * Lcd_Ctx[Instance].FbStride) + (4U * Xpos)) = Color;
+  }
+  else
+  {
+    *(__IO uint16_t *)(Lcd_Ctx[Instance].FbAddress + (Ypos * Lcd_Ctx[Instance].FbStride) + (2U * Xpos)) = (uint16_t)Color;
+  }
+
+  return ret;
+}
+
 /**
   * @}
   */
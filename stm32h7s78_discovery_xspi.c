@@ -29,12 +29,19 @@
        (++) Initialize the XSPI external memory using the BSP_XSPI_NOR_Init() function. This
             function includes the MSP layer hardware resources initialization and the
             XSPI interface with the external memory.
+       (++) BSP_XSPI_NOR_Init() first probes the protocol the memory is configured for
+            (SPI, STR OPI then DTR OPI). After a warm reset the memory is kept in its mode,
+            without reset nor reconfiguration when it is the requested one, so memory-mapped
+            mode can be enabled right away. The memory is reset only when its mode is not
+            recognized or when an operation was left suspended or failed.
 
    (#) MX66UW1G45G Octal NOR memory operations
        (++) XSPI memory can be accessed with read/write operations once it is
             initialized.
             Read/write operation can be performed with AHB access using the functions
             BSP_XSPI_NOR_Read()/BSP_XSPI_NOR_Write().
+       (++) BSP_XSPI_NOR_Write() programs page by page, the flash ready polling is only
+            done once before the first page and after each page program.
        (++) The function BSP_XSPI_NOR_GetInfo() returns the configuration of the XSPI memory.
             (see the XSPI memory data sheet)
        (++) Perform erase block operation using the function BSP_XSPI_NOR_Erase_Block() and by
@@ -45,6 +52,60 @@
        (++) The memory access can be configured in memory-mapped mode with the call of
             function BSP_XSPI_NOR_EnableMemoryMapped(). To go back in indirect mode, the
             function BSP_XSPI_NOR_DisableMemoryMapped() should be used.
+       (++) BSP_XSPI_NOR_Write_IT() and BSP_XSPI_NOR_Erase_Block_IT() start a program or
+            an erase and return. The write enable, the page program and the end of
+            program of each page are chained from the XSPI command complete, transfer
+            complete and status match interrupts, no step waits in interrupt context.
+            BSP_XSPI_NOR_IRQHandler() must be called from XSPI2_IRQHandler() and the
+            completion is notified by BSP_XSPI_NOR_WriteCpltCallback(),
+            BSP_XSPI_NOR_EraseCpltCallback() or BSP_XSPI_NOR_ErrorCallback(). Until the
+            completion, the blocking APIs return BSP_ERROR_BUSY, BSP_XSPI_NOR_SuspendErase()
+            and BSP_XSPI_NOR_ResumeErase() apply to the interrupt driven erase and
+            BSP_XSPI_NOR_DeInit() aborts the operation in progress. The driver does not
+            define the HAL callbacks: when USE_HAL_XSPI_REGISTER_CALLBACKS is set to 0,
+            the application HAL_XSPI_StatusMatchCallback(), HAL_XSPI_CmdCpltCallback(),
+            HAL_XSPI_TxCpltCallback() and HAL_XSPI_ErrorCallback() must call
+            BSP_XSPI_NOR_StatusMatchCallback(), BSP_XSPI_NOR_CmdCpltCallback(),
+            BSP_XSPI_NOR_TxCpltCallback() and BSP_XSPI_NOR_TransferErrorCallback().
+       (++) BSP_XSPI_NOR_Read() is served during an interrupt driven erase: the erase is
+            suspended for the read and resumed. A read issued less than
+            BSP_XSPI_NOR_ERASE_RESUME_TIME ms (at least 2 ticks) after the last resume
+            waits only for the rest of this interval before the suspend, so that the
+            erase always progresses. A read inside the erased block, or issued when the
+            erase was already suspended BSP_XSPI_NOR_ERASE_SUSPEND_MAX times, waits for
+            the end of the erase instead. The
+            wait is bounded by the maximum erase time of the block, an erase which fails
+            or does not end in time is reported by BSP_XSPI_NOR_ErrorCallback().
+            BSP_XSPI_NOR_GetSuspendStats() returns the suspended and deferred reads, the
+            highest suspend count of an erase and the longest read latency.
+       (++) When USE_BSP_XSPI_NOR_READ_CACHE is set to 1, the reads smaller than
+            BSP_XSPI_NOR_READ_CACHE_LINE_SIZE are served from BSP_XSPI_NOR_READ_CACHE_LINES
+            SRAM lines. A missed line is filled with one read command; a read following
+            the previous one (sequential stream) fills all the lines at once with the
+            next addresses. The lines are invalidated by the programs and the erases.
+            BSP_XSPI_NOR_GetCacheStats() returns the hit ratio and the bytes saved.
+       (++) When USE_BSP_XSPI_NOR_DMA is set to 1, BSP_XSPI_NOR_Read_DMA() and
+            BSP_XSPI_NOR_Write_DMA() move the data with the HPDMA while the CPU runs.
+            BSP_XSPI_NOR_ReadList_DMA() reads a list of discontiguous regions with a
+            single call, the next region being started from the transfer complete
+            interrupt. Buffers must be 4 bytes aligned, sizes multiple of 4 bytes and
+            kept coherent with the data cache by the application, a region outside the
+            memory returns BSP_ERROR_WRONG_PARAM.
+            BSP_XSPI_NOR_DMA_RX_IRQHandler() and BSP_XSPI_NOR_DMA_TX_IRQHandler() must
+            be called from the HPDMA1 channel 14 and 13 interrupt handlers, together with
+            BSP_XSPI_NOR_IRQHandler(). The completion is notified by
+            BSP_XSPI_NOR_ReadCpltCallback(), only defined with the DMA,
+            BSP_XSPI_NOR_WriteCpltCallback() or BSP_XSPI_NOR_ErrorCallback(). When USE_HAL_XSPI_REGISTER_CALLBACKS is set
+            to 0, the application HAL_XSPI_RxCpltCallback() must also call
+            BSP_XSPI_NOR_RxCpltCallback().
+       (++) BSP_XSPI_NOR_Update() is an incremental BSP_XSPI_NOR_Write() for delta updates:
+            the target is read back and compared, the pages already holding the data are
+            skipped and a 4KB sector is erased (and its other content rewritten) only when
+            bits must go from 0 to 1. It reports the skipped and programmed pages and the
+            erased sectors.
+       (++) BSP_XSPI_NOR_EraseRange() erases a 4KB aligned range with 64KB block erases
+            in the aligned part and 4KB sector erases at the edges. It can skip the sectors
+            already blank and reports the issued erases and the estimated time saved.
        (++) The erase operation can be suspend and resume with using functions
             BSP_XSPI_NOR_SuspendErase() and BSP_XSPI_NOR_ResumeErase()
        (++) It is possible to put the memory in deep power-down mode to reduce its consumption.
@@ -152,6 +213,58 @@ XSPI_RAM_Ctx_t XSPI_Ram_Ctx[XSPI_RAM_INSTANCES_NUMBER] = {{
 #elif (DUMMY_CYCLES_READ_OCTAL == 6U)
 #define XSPI_NOR_MAX_FREQ 66000000U /* Fmax of memory is 66 MHz */
 #endif /* DUMMY_CYCLES_READ_OCTAL */
+
+/* Typical erase times (ms) used to plan and report range erases */
+#define XSPI_NOR_ERASE_4K_TIME   25U
+#define XSPI_NOR_ERASE_64K_TIME  220U
+
+/* Maximum erase times (ms) bounding the wait for the end of an interrupt driven erase */
+#define XSPI_NOR_ERASE_4K_MAX_TIME    400U
+#define XSPI_NOR_ERASE_64K_MAX_TIME   2000U
+#define XSPI_NOR_ERASE_CHIP_MAX_TIME  1200000U
+
+/* Ticks an erase runs after a resume before being suspended again: the tick of the
+   resume is partly elapsed, so the time is compared with <= and at least 2 ticks */
+#define XSPI_NOR_ERASE_RESUME_TICKS   ((BSP_XSPI_NOR_ERASE_RESUME_TIME < 2U) ? 2U : BSP_XSPI_NOR_ERASE_RESUME_TIME)
+
+/* Size of an erase block, the chip erase covers the whole memory */
+#define XSPI_NOR_ERASE_SIZE(__BLOCK_SIZE__) \
+  (((__BLOCK_SIZE__) == BSP_XSPI_NOR_ERASE_4K) ? MX66UW1G45G_SUBSECTOR_4K \
+   : (((__BLOCK_SIZE__) == BSP_XSPI_NOR_ERASE_64K) ? MX66UW1G45G_SECTOR_64K : MX66UW1G45G_FLASH_SIZE))
+
+/* JEDEC manufacturer ID of Macronix, first byte of the memory ID */
+#define XSPI_NOR_MANUFACTURER_ID 0xC2U
+
+#if (USE_BSP_XSPI_NOR_READ_CACHE == 1)
+#if ((BSP_XSPI_NOR_READ_CACHE_LINE_SIZE & (BSP_XSPI_NOR_READ_CACHE_LINE_SIZE - 1U)) != 0U)
+#error "BSP_XSPI_NOR_READ_CACHE_LINE_SIZE must be a power of 2"
+#endif /* BSP_XSPI_NOR_READ_CACHE_LINE_SIZE */
+
+#define XSPI_NOR_CACHE_INVALID   0xFFFFFFFFU
+
+#define XSPI_NOR_CACHE_INVALIDATE(__INSTANCE__, __ADDRESS__, __SIZE__) \
+  XSPI_NOR_CacheInvalidate((__INSTANCE__), (__ADDRESS__), (__SIZE__))
+#else
+#define XSPI_NOR_CACHE_INVALIDATE(__INSTANCE__, __ADDRESS__, __SIZE__) ((void)0)
+#endif /* USE_BSP_XSPI_NOR_READ_CACHE */
+
+/* Interrupt driven operation states */
+#define XSPI_NOR_IT_IDLE         0U
+#define XSPI_NOR_IT_PROGRAM      1U
+#define XSPI_NOR_IT_ERASE        2U
+#define XSPI_NOR_IT_SUSPEND      3U   /* Erase paused to serve a read */
+#define XSPI_NOR_IT_READ_DMA     4U
+#define XSPI_NOR_IT_PROGRAM_DMA  5U
+#define XSPI_NOR_IT_ERASE_PAUSED 6U   /* Erase suspended by BSP_XSPI_NOR_SuspendErase() */
+
+/* Steps of an interrupt driven page program, each one ends with an interrupt */
+#define XSPI_NOR_STEP_WRITE_ENABLE  0U   /* Write enable command, command complete        */
+#define XSPI_NOR_STEP_WEL           1U   /* Write enable latch polling, status match      */
+#define XSPI_NOR_STEP_DATA          2U   /* Page program command, transfer complete       */
+#define XSPI_NOR_STEP_WIP           3U   /* End of program polling, status match          */
+
+/* Largest DMA transfer, the HPDMA block size is 16 bits wide */
+#define XSPI_NOR_DMA_MAX_SIZE    0xFFFCU
 /**
   * @}
   */
@@ -174,6 +287,42 @@ static const uint8_t XSPINor_DummyCyclesArray[] = {MX66UW1G45G_CR2_DC_6_CYCLES,
                                                    MX66UW1G45G_CR2_DC_18_CYCLES,
                                                    MX66UW1G45G_CR2_DC_20_CYCLES
                                                   };
+/* Sector read-modify-write buffer of the incremental updates */
+static uint8_t XSPINor_UpdateSector[MX66UW1G45G_SUBSECTOR_4K] __ALIGNED(4);
+
+/* Interrupt driven program/erase operation */
+typedef struct
+{
+  volatile uint32_t State;                   /* XSPI_NOR_IT_xxx                 */
+  uint32_t Address;                          /* Address of the page in progress */
+  uint32_t Size;                             /* Size of the page in progress    */
+  uint32_t EndAddress;
+  uint32_t DataAddress;                      /* Data of the page in progress    */
+  uint32_t Step;                             /* XSPI_NOR_STEP_xxx of the page   */
+  uint32_t Suspends;                         /* Suspends of the erase           */
+  uint32_t ResumeTick;                       /* Last start or resume of erase   */
+  const BSP_XSPI_NOR_DmaItem_t *pItems;      /* Regions of a DMA read           */
+  uint32_t NbItems;
+  uint32_t Item;                             /* Region in progress              */
+} XSPI_NOR_ItCtx_t;
+
+static XSPI_NOR_ItCtx_t XSPINor_ItCtx[XSPI_NOR_INSTANCES_NUMBER];
+static BSP_XSPI_NOR_SuspendStats_t XSPINor_SuspendStats[XSPI_NOR_INSTANCES_NUMBER];
+
+#if (USE_BSP_XSPI_NOR_READ_CACHE == 1)
+/* Read cache */
+typedef struct
+{
+  uint32_t Tag[BSP_XSPI_NOR_READ_CACHE_LINES];   /* Line addresses                  */
+  uint32_t Next;                                 /* Next line replaced              */
+  uint32_t StreamEnd;                            /* End address of the last read    */
+} XSPI_NOR_Cache_t;
+
+static XSPI_NOR_Cache_t XSPINor_Cache[XSPI_NOR_INSTANCES_NUMBER];
+static uint8_t XSPINor_CacheLines[XSPI_NOR_INSTANCES_NUMBER][BSP_XSPI_NOR_READ_CACHE_LINES]
+[BSP_XSPI_NOR_READ_CACHE_LINE_SIZE] __ALIGNED(4);
+static BSP_XSPI_NOR_CacheStats_t XSPINor_CacheStats[XSPI_NOR_INSTANCES_NUMBER];
+#endif /* USE_BSP_XSPI_NOR_READ_CACHE */
 /**
   * @}
   */
@@ -199,9 +348,40 @@ static uint32_t XSPIRam_IsMspCbValid[XSPI_RAM_INSTANCES_NUMBER] = {0};
 static void    XSPI_NOR_MspInit(XSPI_HandleTypeDef *hxspi);
 static void    XSPI_NOR_MspDeInit(XSPI_HandleTypeDef *hxspi);
 static int32_t XSPI_NOR_ResetMemory(uint32_t Instance);
+static int32_t XSPI_NOR_DetectMode(uint32_t Instance);
 static int32_t XSPI_NOR_EnterDOPIMode(uint32_t Instance);
 static int32_t XSPI_NOR_EnterSOPIMode(uint32_t Instance);
 static int32_t XSPI_NOR_ExitOPIMode(uint32_t Instance);
+static int32_t XSPI_NOR_ProgramPage(uint32_t Instance, const uint8_t *pData, uint32_t Address, uint32_t Size);
+static int32_t XSPI_NOR_AutoPolling_IT(uint32_t Instance, uint32_t MatchValue, uint32_t MatchMask);
+static void    XSPI_NOR_SetTransferCommand(uint32_t Instance, XSPI_RegularCmdTypeDef *pCommand, uint32_t Address,
+                                           uint32_t Size, uint32_t Write);
+static int32_t XSPI_NOR_ProgramStep_IT(uint32_t Instance);
+static void    XSPI_NOR_ResetItCtx(uint32_t Instance);
+static int32_t XSPI_NOR_SuspendErase(uint32_t Instance);
+static int32_t XSPI_NOR_ResumeErase(uint32_t Instance);
+static int32_t XSPI_NOR_GetBlankSectors(uint32_t Instance, uint32_t Address, uint32_t NbSectors, uint32_t *pBlank);
+static int32_t XSPI_NOR_WaitMemReady(uint32_t Instance);
+static int32_t XSPI_NOR_WaitEraseEnd(uint32_t Instance, uint32_t BlockSize);
+static int32_t XSPI_NOR_SuspendEraseForRead(uint32_t Instance, uint32_t ReadAddr, uint32_t Size);
+static int32_t XSPI_NOR_ResumeEraseAfterRead(uint32_t Instance, uint32_t StartTick);
+static int32_t XSPI_NOR_ReadMemory(uint32_t Instance, uint8_t *pData, uint32_t ReadAddr, uint32_t Size);
+#if (USE_BSP_XSPI_NOR_READ_CACHE == 1)
+static int32_t XSPI_NOR_CacheRead(uint32_t Instance, uint8_t *pData, uint32_t ReadAddr, uint32_t Size);
+static void    XSPI_NOR_CacheInvalidate(uint32_t Instance, uint32_t Address, uint32_t Size);
+#endif /* USE_BSP_XSPI_NOR_READ_CACHE */
+static int32_t XSPI_NOR_UpdateSector(uint32_t Instance, const uint8_t *pData, uint32_t Address, uint32_t Size,
+                                     BSP_XSPI_NOR_UpdateReport_t *pReport);
+static void    XSPI_NOR_StatusMatchCallback(XSPI_HandleTypeDef *hxspi);
+static void    XSPI_NOR_CmdCpltCallback(XSPI_HandleTypeDef *hxspi);
+static void    XSPI_NOR_TxCpltCallback(XSPI_HandleTypeDef *hxspi);
+static void    XSPI_NOR_ErrorCallback(XSPI_HandleTypeDef *hxspi);
+#if (USE_BSP_XSPI_NOR_DMA == 1)
+static int32_t XSPI_NOR_Transfer_DMA(uint32_t Instance, uint8_t *pData, uint32_t Address, uint32_t Size,
+                                     uint32_t Write);
+static int32_t XSPI_NOR_ReadNext_DMA(uint32_t Instance);
+static void    XSPI_NOR_RxCpltCallback(XSPI_HandleTypeDef *hxspi);
+#endif /* USE_BSP_XSPI_NOR_DMA */
 /**
   * @}
   */
@@ -261,6 +441,20 @@ int32_t BSP_XSPI_NOR_Init(uint32_t Instance, BSP_XSPI_NOR_Init_t *Init)
         }
       }
 #endif /* USE_HAL_XSPI_REGISTER_CALLBACKS */
+      XSPI_NOR_ResetItCtx(Instance);
+      XSPINor_SuspendStats[Instance].SuspendedReads   = 0U;
+      XSPINor_SuspendStats[Instance].DeferredReads    = 0U;
+      XSPINor_SuspendStats[Instance].MaxEraseSuspends = 0U;
+      XSPINor_SuspendStats[Instance].MaxReadLatency   = 0U;
+#if (USE_BSP_XSPI_NOR_READ_CACHE == 1)
+      XSPI_NOR_CacheInvalidate(Instance, 0U, MX66UW1G45G_FLASH_SIZE);
+      XSPINor_CacheStats[Instance].Reads       = 0U;
+      XSPINor_CacheStats[Instance].Hits        = 0U;
+      XSPINor_CacheStats[Instance].HitRatio    = 0U;
+      XSPINor_CacheStats[Instance].LineFills   = 0U;
+      XSPINor_CacheStats[Instance].StreamFills = 0U;
+      XSPINor_CacheStats[Instance].BytesSaved  = 0U;
+#endif /* USE_BSP_XSPI_NOR_READ_CACHE */
 
       /* Get Flash information of one memory */
       (void)MX66UW1G45G_GetFlashInfo(&pInfo);
@@ -281,8 +475,34 @@ int32_t BSP_XSPI_NOR_Init(uint32_t Instance, BSP_XSPI_NOR_Init_t *Init)
       {
         ret = BSP_ERROR_PERIPH_FAILURE;
       }
-      /* XSPI memory reset */
-      else if (XSPI_NOR_ResetMemory(Instance) != BSP_ERROR_NONE)
+#if (USE_HAL_XSPI_REGISTER_CALLBACKS == 1)
+      /* Register the callbacks of the interrupt driven program/erase operations */
+      else if (HAL_XSPI_RegisterCallback(&hxspi_nor[Instance], HAL_XSPI_STATUS_MATCH_CB_ID,
+                                         XSPI_NOR_StatusMatchCallback) != HAL_OK)
+      {
+        ret = BSP_ERROR_PERIPH_FAILURE;
+      }
+      else if (HAL_XSPI_RegisterCallback(&hxspi_nor[Instance], HAL_XSPI_ERROR_CB_ID, XSPI_NOR_ErrorCallback) != HAL_OK)
+      {
+        ret = BSP_ERROR_PERIPH_FAILURE;
+      }
+      else if (HAL_XSPI_RegisterCallback(&hxspi_nor[Instance], HAL_XSPI_CMD_CPLT_CB_ID, XSPI_NOR_CmdCpltCallback) != HAL_OK)
+      {
+        ret = BSP_ERROR_PERIPH_FAILURE;
+      }
+      else if (HAL_XSPI_RegisterCallback(&hxspi_nor[Instance], HAL_XSPI_TX_CPLT_CB_ID, XSPI_NOR_TxCpltCallback) != HAL_OK)
+      {
+        ret = BSP_ERROR_PERIPH_FAILURE;
+      }
+#if (USE_BSP_XSPI_NOR_DMA == 1)
+      else if (HAL_XSPI_RegisterCallback(&hxspi_nor[Instance], HAL_XSPI_RX_CPLT_CB_ID, XSPI_NOR_RxCpltCallback) != HAL_OK)
+      {
+        ret = BSP_ERROR_PERIPH_FAILURE;
+      }
+#endif /* USE_BSP_XSPI_NOR_DMA */
+#endif /* USE_HAL_XSPI_REGISTER_CALLBACKS */
+      /* Keep the protocol the memory is already configured for, reset it only when unknown */
+      else if ((XSPI_NOR_DetectMode(Instance) != BSP_ERROR_NONE) && (XSPI_NOR_ResetMemory(Instance) != BSP_ERROR_NONE))
       {
         ret = BSP_ERROR_COMPONENT_FAILURE;
       }
@@ -331,6 +551,32 @@ int32_t BSP_XSPI_NOR_DeInit(uint32_t Instance)
     /* Check if the instance is already initialized */
     if (XSPI_Nor_Ctx[Instance].IsInitialized != XSPI_ACCESS_NONE)
     {
+      /* Stop the interrupt or DMA driven operation in progress, its interrupts must
+         not reach the next initialization */
+      HAL_NVIC_DisableIRQ(XSPI2_IRQn);
+      if (XSPINor_ItCtx[Instance].State == XSPI_NOR_IT_ERASE_PAUSED)
+      {
+        /* No transfer in progress, the suspended erase is resumed to complete */
+        if (MX66UW1G45G_Resume(&hxspi_nor[Instance], XSPI_Nor_Ctx[Instance].InterfaceMode,
+                               XSPI_Nor_Ctx[Instance].TransferRate) != MX66UW1G45G_OK)
+        {
+          ret = BSP_ERROR_COMPONENT_FAILURE;
+        }
+      }
+      else if (XSPINor_ItCtx[Instance].State != XSPI_NOR_IT_IDLE)
+      {
+        if (HAL_XSPI_Abort(&hxspi_nor[Instance]) != HAL_OK)
+        {
+          ret = BSP_ERROR_PERIPH_FAILURE;
+        }
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+      XSPI_NOR_ResetItCtx(Instance);
+      HAL_NVIC_EnableIRQ(XSPI2_IRQn);
+
       /* Disable Memory mapped mode */
       if (XSPI_Nor_Ctx[Instance].IsInitialized == XSPI_ACCESS_MMP)
       {
@@ -494,36 +740,47 @@ int32_t BSP_XSPI_NOR_RegisterMspCallbacks(uint32_t Instance, BSP_XSPI_Cb_t *Call
 int32_t BSP_XSPI_NOR_Read(uint32_t Instance, uint8_t *pData, uint32_t ReadAddr, uint32_t Size)
 {
   int32_t ret;
+  uint32_t erase;
+  uint32_t tick;
 
   /* Check if the instance is supported */
   if (Instance >= XSPI_NOR_INSTANCES_NUMBER)
   {
     ret = BSP_ERROR_WRONG_PARAM;
+  }/* Check if an interrupt driven program is ongoing */
+  else if ((XSPINor_ItCtx[Instance].State != XSPI_NOR_IT_IDLE) &&
+           (XSPINor_ItCtx[Instance].State != XSPI_NOR_IT_ERASE) &&
+           (XSPINor_ItCtx[Instance].State != XSPI_NOR_IT_ERASE_PAUSED))
+  {
+    ret = BSP_ERROR_BUSY;
   }
   else
   {
-    if (XSPI_Nor_Ctx[Instance].TransferRate == BSP_XSPI_NOR_STR_TRANSFER)
+    /* An interrupt driven erase is suspended, or completed, to serve the read */
+    erase = (XSPINor_ItCtx[Instance].State == XSPI_NOR_IT_ERASE) ? 1U : 0U;
+    tick  = HAL_GetTick();
+    ret   = (erase == 1U) ? XSPI_NOR_SuspendEraseForRead(Instance, ReadAddr, Size) : BSP_ERROR_NONE;
+
+    if (ret != BSP_ERROR_NONE)
     {
-      if (MX66UW1G45G_ReadSTR(&hxspi_nor[Instance], XSPI_Nor_Ctx[Instance].InterfaceMode,
-                              MX66UW1G45G_4BYTES_SIZE, pData, ReadAddr, Size) != MX66UW1G45G_OK)
-      {
-        ret = BSP_ERROR_COMPONENT_FAILURE;
-      }
-      else
-      {
-        ret = BSP_ERROR_NONE;
-      }
+      /* Nothing to do, the erase could not be paused */
+    }
+#if (USE_BSP_XSPI_NOR_READ_CACHE == 1)
+    /* The line fills are not done during an erase, they could reach the erased block */
+    else if ((XSPINor_ItCtx[Instance].State == XSPI_NOR_IT_IDLE) && (Size < BSP_XSPI_NOR_READ_CACHE_LINE_SIZE))
+    {
+      ret = XSPI_NOR_CacheRead(Instance, pData, ReadAddr, Size);
     }
+#endif /* USE_BSP_XSPI_NOR_READ_CACHE */
     else
     {
-      if (MX66UW1G45G_ReadDTR(&hxspi_nor[Instance], pData, ReadAddr, Size) != MX66UW1G45G_OK)
-      {
-        ret = BSP_ERROR_COMPONENT_FAILURE;
-      }
-      else
-      {
-        ret = BSP_ERROR_NONE;
-      }
+      ret = XSPI_NOR_ReadMemory(Instance, pData, ReadAddr, Size);
+    }
+
+    /* Resume the erase even if the read failed */
+    if ((erase == 1U) && (XSPI_NOR_ResumeEraseAfterRead(Instance, tick) != BSP_ERROR_NONE))
+    {
+      ret = BSP_ERROR_COMPONENT_FAILURE;
     }
   }
 
@@ -551,6 +808,16 @@ int32_t BSP_XSPI_NOR_Write(uint32_t Instance, const uint8_t *pData, uint32_t Wri
   if (Instance >= XSPI_NOR_INSTANCES_NUMBER)
   {
     ret = BSP_ERROR_WRONG_PARAM;
+  }/* Check if an interrupt driven operation is ongoing */
+  else if (XSPINor_ItCtx[Instance].State != XSPI_NOR_IT_IDLE)
+  {
+    ret = BSP_ERROR_BUSY;
+  }/* Check if Flash busy ? Only needed before the first page, the end of program
+      polling of a page guarantees that the flash is ready for the next one */
+  else if (MX66UW1G45G_AutoPollingMemReady(&hxspi_nor[Instance], XSPI_Nor_Ctx[Instance].InterfaceMode,
+                                           XSPI_Nor_Ctx[Instance].TransferRate) != MX66UW1G45G_OK)
+  {
+    ret = BSP_ERROR_COMPONENT_FAILURE;
   }
   else
   {
@@ -571,56 +838,25 @@ int32_t BSP_XSPI_NOR_Write(uint32_t Instance, const uint8_t *pData, uint32_t Wri
     /* Perform the write page by page */
     do
     {
-      /* Check if Flash busy ? */
-      if (MX66UW1G45G_AutoPollingMemReady(&hxspi_nor[Instance], XSPI_Nor_Ctx[Instance].InterfaceMode,
-                                          XSPI_Nor_Ctx[Instance].TransferRate) != MX66UW1G45G_OK)
-      {
-        ret = BSP_ERROR_COMPONENT_FAILURE;
-      }/* Enable write operations */
-      else if (MX66UW1G45G_WriteEnable(&hxspi_nor[Instance], XSPI_Nor_Ctx[Instance].InterfaceMode,
-                                       XSPI_Nor_Ctx[Instance].TransferRate) != MX66UW1G45G_OK)
-      {
-        ret = BSP_ERROR_COMPONENT_FAILURE;
-      }
-      else
+      /* Enable write operations and issue page program command */
+      ret = XSPI_NOR_ProgramPage(Instance, (const uint8_t *)data_addr, current_addr, current_size);
+
+      if (ret == BSP_ERROR_NONE)
       {
-        if (XSPI_Nor_Ctx[Instance].TransferRate == BSP_XSPI_NOR_STR_TRANSFER)
+        /* Configure automatic polling mode to wait for end of program */
+        if (MX66UW1G45G_AutoPollingMemReady(&hxspi_nor[Instance], XSPI_Nor_Ctx[Instance].InterfaceMode,
+                                            XSPI_Nor_Ctx[Instance].TransferRate) != MX66UW1G45G_OK)
         {
-          /* Issue page program command */
-          if (MX66UW1G45G_PageProgram(&hxspi_nor[Instance], XSPI_Nor_Ctx[Instance].InterfaceMode,
-                                      MX66UW1G45G_4BYTES_SIZE, (uint8_t *)data_addr, current_addr,
-                                      current_size) != MX66UW1G45G_OK)
-          {
-            ret = BSP_ERROR_COMPONENT_FAILURE;
-          }
+          ret = BSP_ERROR_COMPONENT_FAILURE;
         }
         else
         {
-          /* Issue page program command */
-          if (MX66UW1G45G_PageProgramDTR(&hxspi_nor[Instance], (uint8_t *)data_addr, current_addr,
-                                         current_size) != MX66UW1G45G_OK)
-          {
-            ret = BSP_ERROR_COMPONENT_FAILURE;
-          }
-        }
-
-        if (ret == BSP_ERROR_NONE)
-        {
-          /* Configure automatic polling mode to wait for end of program */
-          if (MX66UW1G45G_AutoPollingMemReady(&hxspi_nor[Instance], XSPI_Nor_Ctx[Instance].InterfaceMode,
-                                              XSPI_Nor_Ctx[Instance].TransferRate) != MX66UW1G45G_OK)
-          {
-            ret = BSP_ERROR_COMPONENT_FAILURE;
-          }
-          else
-          {
-            /* Update the address and size variables for next page programming */
-            current_addr += current_size;
-            data_addr += current_size;
-            current_size = ((current_addr + MX66UW1G45G_PAGE_SIZE) > end_addr)
-                           ? (end_addr - current_addr)
-                           : MX66UW1G45G_PAGE_SIZE;
-          }
+          /* Update the address and size variables for next page programming */
+          current_addr += current_size;
+          data_addr += current_size;
+          current_size = ((current_addr + MX66UW1G45G_PAGE_SIZE) > end_addr)
+                         ? (end_addr - current_addr)
+                         : MX66UW1G45G_PAGE_SIZE;
         }
       }
     } while ((current_addr < end_addr) && (ret == BSP_ERROR_NONE));
@@ -630,6 +866,65 @@ int32_t BSP_XSPI_NOR_Write(uint32_t Instance, const uint8_t *pData, uint32_t Wri
   return ret;
 }
 
+/**
+  * @brief  Writes an amount of data to the XSPI memory, only where it differs.
+  *         Each 4KB sector is compared to the data: the pages already holding
+  *         the data are skipped, the pages only needing bits cleared are
+  *         programmed and the sector is erased, then reprogrammed with its
+  *         previous content outside the range, only when bits must be set.
+  * @param  Instance  XSPI instance
+  * @param  pData     Pointer to data to be written
+  * @param  WriteAddr Write start address
+  * @param  Size      Size of data to write
+  * @param  pReport   Pointer to the update report, can be NULL
+  * @retval BSP status
+  */
+int32_t BSP_XSPI_NOR_Update(uint32_t Instance, const uint8_t *pData, uint32_t WriteAddr, uint32_t Size,
+                            BSP_XSPI_NOR_UpdateReport_t *pReport)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  uint32_t addr = WriteAddr;
+  uint32_t end_addr = WriteAddr + Size;
+  uint32_t sector_end;
+  BSP_XSPI_NOR_UpdateReport_t report = {0};
+
+  /* Check if the instance is supported */
+  if ((Instance >= XSPI_NOR_INSTANCES_NUMBER) || (pData == NULL) || (Size > MX66UW1G45G_FLASH_SIZE) ||
+      (WriteAddr > (MX66UW1G45G_FLASH_SIZE - Size)))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }/* Check if an interrupt driven operation is ongoing */
+  else if (XSPINor_ItCtx[Instance].State != XSPI_NOR_IT_IDLE)
+  {
+    ret = BSP_ERROR_BUSY;
+  }
+  else
+  {
+    ret = XSPI_NOR_WaitMemReady(Instance);
+
+    /* Update the range sector by sector */
+    while ((addr < end_addr) && (ret == BSP_ERROR_NONE))
+    {
+      sector_end = (addr - (addr % MX66UW1G45G_SUBSECTOR_4K)) + MX66UW1G45G_SUBSECTOR_4K;
+      if (sector_end > end_addr)
+      {
+        sector_end = end_addr;
+      }
+
+      ret = XSPI_NOR_UpdateSector(Instance, &pData[addr - WriteAddr], addr, sector_end - addr, &report);
+      addr = sector_end;
+    }
+
+    if (pReport != NULL)
+    {
+      *pReport = report;
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
 /**
   * @brief  Erases the specified block of the XSPI memory.
   * @param  Instance     XSPI instance
@@ -645,6 +940,10 @@ int32_t BSP_XSPI_NOR_Erase_Block(uint32_t Instance, uint32_t BlockAddress, BSP_X
   if (Instance >= XSPI_NOR_INSTANCES_NUMBER)
   {
     ret = BSP_ERROR_WRONG_PARAM;
+  }/* Check if an interrupt driven operation is ongoing */
+  else if (XSPINor_ItCtx[Instance].State != XSPI_NOR_IT_IDLE)
+  {
+    ret = BSP_ERROR_BUSY;
   }
   else
   {
@@ -667,6 +966,9 @@ int32_t BSP_XSPI_NOR_Erase_Block(uint32_t Instance, uint32_t BlockAddress, BSP_X
     }
     else
     {
+      /* Only the lines of the erased block are invalidated */
+      XSPI_NOR_CACHE_INVALIDATE(Instance, BlockAddress - (BlockAddress % XSPI_NOR_ERASE_SIZE(BlockSize)),
+                                XSPI_NOR_ERASE_SIZE(BlockSize));
       ret = BSP_ERROR_NONE;
     }
   }
@@ -688,6 +990,10 @@ int32_t BSP_XSPI_NOR_Erase_Chip(uint32_t Instance)
   if (Instance >= XSPI_NOR_INSTANCES_NUMBER)
   {
     ret = BSP_ERROR_WRONG_PARAM;
+  }/* Check if an interrupt driven operation is ongoing */
+  else if (XSPINor_ItCtx[Instance].State != XSPI_NOR_IT_IDLE)
+  {
+    ret = BSP_ERROR_BUSY;
   }
   else
   {
@@ -709,6 +1015,7 @@ int32_t BSP_XSPI_NOR_Erase_Chip(uint32_t Instance)
     }
     else
     {
+      XSPI_NOR_CACHE_INVALIDATE(Instance, 0U, MX66UW1G45G_FLASH_SIZE);
       ret = BSP_ERROR_NONE;
     }
   }
@@ -717,6 +1024,120 @@ int32_t BSP_XSPI_NOR_Erase_Chip(uint32_t Instance)
   return ret;
 }
 
+/**
+  * @brief  Erases a range of the XSPI memory with the fewest erase commands:
+  *         64KB block erases where the range covers whole blocks, 4KB sector
+  *         erases at the edges.
+  * @param  Instance  XSPI instance
+  * @param  Address   Range start address, 4KB aligned
+  * @param  Size      Range size, multiple of 4KB
+  * @param  SkipBlank When 1, the sectors reading back as all 0xFF are not erased and
+  *                   a block holding only a few non blank sectors is erased sector by
+  *                   sector when it is faster
+  * @param  pReport   Pointer to the erase report, can be NULL
+  * @retval BSP status
+  */
+int32_t BSP_XSPI_NOR_EraseRange(uint32_t Instance, uint32_t Address, uint32_t Size, uint32_t SkipBlank,
+                                BSP_XSPI_NOR_EraseReport_t *pReport)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  uint32_t addr = Address;
+  uint32_t end_addr = Address + Size;
+  uint32_t nb_sectors;
+  uint32_t blank;
+  uint32_t nb_erase;
+  uint32_t i;
+  BSP_XSPI_NOR_EraseReport_t report = {0};
+
+  /* Check if the instance is supported and the range is sector aligned */
+  if ((Instance >= XSPI_NOR_INSTANCES_NUMBER) || ((Address % MX66UW1G45G_SUBSECTOR_4K) != 0U) ||
+      ((Size % MX66UW1G45G_SUBSECTOR_4K) != 0U) || (Size > MX66UW1G45G_FLASH_SIZE) ||
+      (Address > (MX66UW1G45G_FLASH_SIZE - Size)))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }/* Check if an interrupt driven operation is ongoing */
+  else if (XSPINor_ItCtx[Instance].State != XSPI_NOR_IT_IDLE)
+  {
+    ret = BSP_ERROR_BUSY;
+  }
+  else
+  {
+    while ((addr < end_addr) && (ret == BSP_ERROR_NONE))
+    {
+      /* A whole 64KB block or a single 4KB sector */
+      nb_sectors = (((addr % MX66UW1G45G_SECTOR_64K) == 0U) && ((end_addr - addr) >= MX66UW1G45G_SECTOR_64K))
+                   ? (MX66UW1G45G_SECTOR_64K / MX66UW1G45G_SUBSECTOR_4K) : 1U;
+      blank = 0U;
+
+      if (SkipBlank == 1U)
+      {
+        ret = XSPI_NOR_GetBlankSectors(Instance, addr, nb_sectors, &blank);
+      }
+
+      if (ret == BSP_ERROR_NONE)
+      {
+        /* Non blank sectors */
+        nb_erase = 0U;
+        for (i = 0U; i < nb_sectors; i++)
+        {
+          nb_erase += ((blank & (1UL << i)) == 0U) ? 1U : 0U;
+        }
+
+        if (nb_sectors == 1U)
+        {
+          report.SavedTime += (nb_erase == 0U) ? XSPI_NOR_ERASE_4K_TIME : 0U;
+        }
+        else
+        {
+          report.SavedTime += (nb_erase == 0U) ? XSPI_NOR_ERASE_64K_TIME
+                              : (((nb_erase * XSPI_NOR_ERASE_4K_TIME) < XSPI_NOR_ERASE_64K_TIME)
+                                 ? (XSPI_NOR_ERASE_64K_TIME - (nb_erase * XSPI_NOR_ERASE_4K_TIME)) : 0U);
+        }
+
+        if ((nb_sectors > 1U) && ((nb_erase * XSPI_NOR_ERASE_4K_TIME) >= XSPI_NOR_ERASE_64K_TIME))
+        {
+          ret = BSP_XSPI_NOR_Erase_Block(Instance, addr, BSP_XSPI_NOR_ERASE_64K);
+          report.Erase64KNbr++;
+        }
+        else
+        {
+          /* Erase the non blank sectors one by one, the blank ones are skipped */
+          report.SkippedSectors += nb_sectors - nb_erase;
+
+          for (i = 0U; (i < nb_sectors) && (ret == BSP_ERROR_NONE); i++)
+          {
+            if ((blank & (1UL << i)) == 0U)
+            {
+              ret = BSP_XSPI_NOR_Erase_Block(Instance, addr + (i * MX66UW1G45G_SUBSECTOR_4K), BSP_XSPI_NOR_ERASE_4K);
+              report.Erase4KNbr++;
+            }
+          }
+        }
+      }
+
+      addr += nb_sectors * MX66UW1G45G_SUBSECTOR_4K;
+    }
+
+    /* Wait for the end of the last erase */
+    if ((ret == BSP_ERROR_NONE) &&
+        (MX66UW1G45G_AutoPollingMemReady(&hxspi_nor[Instance], XSPI_Nor_Ctx[Instance].InterfaceMode,
+                                         XSPI_Nor_Ctx[Instance].TransferRate) != MX66UW1G45G_OK))
+    {
+      ret = BSP_ERROR_COMPONENT_FAILURE;
+    }
+
+    report.EraseTime = (report.Erase64KNbr * XSPI_NOR_ERASE_64K_TIME) + (report.Erase4KNbr * XSPI_NOR_ERASE_4K_TIME);
+
+    if (pReport != NULL)
+    {
+      *pReport = report;
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
 /**
   * @brief  Reads current status of the XSPI memory.
   * @param  Instance  XSPI instance
@@ -803,6 +1224,10 @@ int32_t BSP_XSPI_NOR_EnableMemoryMappedMode(uint32_t Instance)
   if (Instance >= XSPI_NOR_INSTANCES_NUMBER)
   {
     ret = BSP_ERROR_WRONG_PARAM;
+  }/* Check if an interrupt driven operation is ongoing */
+  else if (XSPINor_ItCtx[Instance].State != XSPI_NOR_IT_IDLE)
+  {
+    ret = BSP_ERROR_BUSY;
   }
   else
   {
@@ -995,29 +1420,43 @@ int32_t BSP_XSPI_NOR_ConfigFlash(uint32_t Instance, BSP_XSPI_NOR_Interface_t Mod
 int32_t BSP_XSPI_NOR_SuspendErase(uint32_t Instance)
 {
   int32_t ret;
+  uint32_t state;
 
   /* Check if the instance is supported */
   if (Instance >= XSPI_NOR_INSTANCES_NUMBER)
   {
     ret = BSP_ERROR_WRONG_PARAM;
-  }
-  /* Check whether the device is busy (erase operation is in progress). */
-  else if (BSP_XSPI_NOR_GetStatus(Instance) != BSP_ERROR_BUSY)
-  {
-    ret = BSP_ERROR_COMPONENT_FAILURE;
-  }
-  else if (MX66UW1G45G_Suspend(&hxspi_nor[Instance], XSPI_Nor_Ctx[Instance].InterfaceMode,
-                               XSPI_Nor_Ctx[Instance].TransferRate) != MX66UW1G45G_OK)
-  {
-    ret = BSP_ERROR_COMPONENT_FAILURE;
-  }
-  else if (BSP_XSPI_NOR_GetStatus(Instance) != BSP_ERROR_XSPI_SUSPENDED)
+  }/* Only an interrupt driven erase can be suspended, not a program or a transfer */
+  else if ((XSPINor_ItCtx[Instance].State != XSPI_NOR_IT_IDLE) &&
+           (XSPINor_ItCtx[Instance].State != XSPI_NOR_IT_ERASE))
   {
-    ret = BSP_ERROR_COMPONENT_FAILURE;
+    ret = BSP_ERROR_BUSY;
   }
   else
   {
-    ret = BSP_ERROR_NONE;
+    /* Stop the status polling of an interrupt driven erase, its end must not be
+       reported while it is suspended */
+    HAL_NVIC_DisableIRQ(XSPI2_IRQn);
+    state = XSPINor_ItCtx[Instance].State;
+    if (state == XSPI_NOR_IT_ERASE)
+    {
+      (void)HAL_XSPI_Abort(&hxspi_nor[Instance]);
+      XSPINor_ItCtx[Instance].State = XSPI_NOR_IT_ERASE_PAUSED;
+    }
+    HAL_NVIC_EnableIRQ(XSPI2_IRQn);
+
+    ret = XSPI_NOR_SuspendErase(Instance);
+
+    if ((ret != BSP_ERROR_NONE) && (state == XSPI_NOR_IT_ERASE))
+    {
+      /* The erase is still running or is completed, its polling is restarted */
+      XSPINor_ItCtx[Instance].State = XSPI_NOR_IT_ERASE;
+      if (XSPI_NOR_AutoPolling_IT(Instance, 0U, MX66UW1G45G_SR_WIP) != BSP_ERROR_NONE)
+      {
+        XSPINor_ItCtx[Instance].State = XSPI_NOR_IT_IDLE;
+        BSP_XSPI_NOR_ErrorCallback(Instance);
+      }
+    }
   }
 
   /* Return BSP status */
@@ -1037,29 +1476,38 @@ int32_t BSP_XSPI_NOR_ResumeErase(uint32_t Instance)
   if (Instance >= XSPI_NOR_INSTANCES_NUMBER)
   {
     ret = BSP_ERROR_WRONG_PARAM;
-  }
-  /* Check whether the device is busy (erase operation is in progress). */
-  else if (BSP_XSPI_NOR_GetStatus(Instance) != BSP_ERROR_XSPI_SUSPENDED)
-  {
-    ret = BSP_ERROR_COMPONENT_FAILURE;
-  }
-  else if (MX66UW1G45G_Resume(&hxspi_nor[Instance], XSPI_Nor_Ctx[Instance].InterfaceMode,
-                              XSPI_Nor_Ctx[Instance].TransferRate) != MX66UW1G45G_OK)
-  {
-    ret = BSP_ERROR_COMPONENT_FAILURE;
-  }
-  /*
-  When this command is executed, the status register write in progress bit is set to 1, and
-  the flag status register program erase controller bit is set to 0. This command is ignored
-  if the device is not in a suspended state.
-  */
-  else if (BSP_XSPI_NOR_GetStatus(Instance) != BSP_ERROR_BUSY)
+  }/* An erase paused to serve a read is resumed by the read itself */
+  else if ((XSPINor_ItCtx[Instance].State != XSPI_NOR_IT_IDLE) &&
+           (XSPINor_ItCtx[Instance].State != XSPI_NOR_IT_ERASE_PAUSED))
   {
-    ret = BSP_ERROR_COMPONENT_FAILURE;
+    ret = BSP_ERROR_BUSY;
   }
   else
   {
-    ret = BSP_ERROR_NONE;
+    ret = XSPI_NOR_ResumeErase(Instance);
+
+    if ((ret == BSP_ERROR_NONE) && (XSPINor_ItCtx[Instance].State == XSPI_NOR_IT_ERASE_PAUSED))
+    {
+      /* Wait again for the end of erase in interrupt mode */
+      XSPINor_ItCtx[Instance].ResumeTick = HAL_GetTick();
+      XSPINor_ItCtx[Instance].State      = XSPI_NOR_IT_ERASE;
+
+      ret = XSPI_NOR_AutoPolling_IT(Instance, 0U, MX66UW1G45G_SR_WIP);
+      if (ret != BSP_ERROR_NONE)
+      {
+        XSPINor_ItCtx[Instance].State = XSPI_NOR_IT_IDLE;
+      }
+    }
+    else if ((ret != BSP_ERROR_NONE) && (XSPINor_ItCtx[Instance].State == XSPI_NOR_IT_ERASE_PAUSED) &&
+             (BSP_XSPI_NOR_GetStatus(Instance) != BSP_ERROR_XSPI_SUSPENDED))
+    {
+      /* The memory holds no suspended erase any more, nothing is left to resume */
+      XSPINor_ItCtx[Instance].State = XSPI_NOR_IT_IDLE;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
   }
 
   /* Return BSP status */
@@ -1126,111 +1574,57 @@ int32_t BSP_XSPI_NOR_LeaveDeepPowerDown(uint32_t Instance)
   /* Return BSP status */
   return ret;
 }
-/**
-  * @}
-  */
-#endif /* USE_NOR_MEMORY_MX66UW1G45G */
-
-#if (USE_RAM_MEMORY_APS256XX == 1)
-/** @addtogroup STM32H7S78_DK_XSPI_RAM_Exported_Functions
-  * @{
-  */
 
 /**
-  * @brief  Initializes the XSPI interface.
-  * @param  Instance   XSPI Instance
-  * @param  Init       XSPI Init structure
+  * @brief  Starts writing an amount of data to the XSPI memory in interrupt mode.
+  *         The write enable, the page program and the end of program polling of
+  *         each page are chained from the XSPI interrupts without any wait,
+  *         BSP_XSPI_NOR_WriteCpltCallback() is called at the end of the last page.
+  * @param  Instance  XSPI instance
+  * @param  pData     Pointer to data to be written, must stay valid until the end of the write
+  * @param  WriteAddr Write start address
+  * @param  Size      Size of data to write
   * @retval BSP status
   */
-int32_t BSP_XSPI_RAM_Init(uint32_t Instance, BSP_XSPI_RAM_Cfg_t *Init)
+int32_t BSP_XSPI_NOR_Write_IT(uint32_t Instance, const uint8_t *pData, uint32_t WriteAddr, uint32_t Size)
 {
-  MX_XSPI_InitTypeDef xspi_init;
-  int32_t ret = BSP_ERROR_NONE;
-  uint32_t xspi_clk, xspi_max_freq;
+  int32_t ret;
+  XSPI_NOR_ItCtx_t *ctx;
 
   /* Check if the instance is supported */
-  if (Instance >= XSPI_RAM_INSTANCES_NUMBER)
+  if ((Instance >= XSPI_NOR_INSTANCES_NUMBER) || (pData == NULL) || (Size == 0U))
   {
     ret = BSP_ERROR_WRONG_PARAM;
+  }/* Check if an interrupt driven operation is ongoing */
+  else if (XSPINor_ItCtx[Instance].State != XSPI_NOR_IT_IDLE)
+  {
+    ret = BSP_ERROR_BUSY;
+  }/* Check if Flash busy ? */
+  else if (MX66UW1G45G_AutoPollingMemReady(&hxspi_nor[Instance], XSPI_Nor_Ctx[Instance].InterfaceMode,
+                                           XSPI_Nor_Ctx[Instance].TransferRate) != MX66UW1G45G_OK)
+  {
+    ret = BSP_ERROR_COMPONENT_FAILURE;
   }
   else
   {
-    /* Check if the instance is already initialized */
-    if (XSPI_Ram_Ctx[Instance].IsInitialized == XSPI_ACCESS_NONE)
+    ctx = &XSPINor_ItCtx[Instance];
+
+    /* Program the first page, up to the end of the page */
+    ctx->Address     = WriteAddr;
+    ctx->EndAddress  = WriteAddr + Size;
+    ctx->DataAddress = (uint32_t)pData;
+    ctx->Size        = MX66UW1G45G_PAGE_SIZE - (WriteAddr % MX66UW1G45G_PAGE_SIZE);
+    if (ctx->Size > Size)
     {
-#if (USE_HAL_XSPI_REGISTER_CALLBACKS == 0)
-      /* Msp XSPI initialization */
-      XSPI_RAM_MspInit(&hxspi_ram[Instance]);
-#else
-      /* Register the XSPI MSP Callbacks */
-      if (XSPIRam_IsMspCbValid[Instance] == 0UL)
-      {
-        if (BSP_XSPI_RAM_RegisterDefaultMspCallbacks(Instance) != BSP_ERROR_NONE)
-        {
-          return BSP_ERROR_PERIPH_FAILURE;
-        }
-      }
-#endif /* USE_HAL_XSPI_REGISTER_CALLBACKS */
-
-      /* Fill config structure */
-      if ((Init->ReadLatencyCode == BSP_XSPI_RAM_READ_LATENCY_3) ||
-          (Init->WriteLatencyCode == BSP_XSPI_RAM_WRITE_LATENCY_3))
-      {
-        /* In case of latency 3, Fmax of memory is 66 MHz */
-        xspi_max_freq = 66000000U;
-      }
-      else if ((Init->ReadLatencyCode == BSP_XSPI_RAM_READ_LATENCY_4) ||
-               (Init->WriteLatencyCode == BSP_XSPI_RAM_WRITE_LATENCY_4))
-      {
-        /* In case of latency 4, Fmax of memory is 109 MHz */
-        xspi_max_freq = 109000000U;
-      }
-      else if ((Init->ReadLatencyCode == BSP_XSPI_RAM_READ_LATENCY_5) ||
-               (Init->WriteLatencyCode == BSP_XSPI_RAM_WRITE_LATENCY_5))
-      {
-        /* In case of latency 5, Fmax of memory is 133 MHz */
-        xspi_max_freq = 133000000U;
-      }
-      else if ((Init->ReadLatencyCode == BSP_XSPI_RAM_READ_LATENCY_6) ||
-          (Init->WriteLatencyCode == BSP_XSPI_RAM_WRITE_LATENCY_6))
-      {
-        /* In case of latency 6, Fmax of memory is 166 MHz */
-        xspi_max_freq = 166000000U;
-      }
-      else
-      {
-        /* In case of latency 7, Fmax of memory is 200 MHz */
-        xspi_max_freq = 200000000U;
-      }
-      xspi_clk = HAL_RCCEx_GetPeriphCLKFreq(RCC_PERIPHCLK_XSPI1);
-      xspi_init.ClockPrescaler = (xspi_clk / xspi_max_freq);
-      if ((xspi_clk % xspi_max_freq) == 0U)
-      {
-        xspi_init.ClockPrescaler = xspi_init.ClockPrescaler - 1U;
-      }
-      xspi_init.MemorySize     = HAL_XSPI_SIZE_256MB;
-      xspi_init.SampleShifting = HAL_XSPI_SAMPLE_SHIFT_NONE;
+      ctx->Size = Size;
+    }
+    ctx->State = XSPI_NOR_IT_PROGRAM;
+    ctx->Step  = XSPI_NOR_STEP_WRITE_ENABLE;
 
-      /* STM32 XSPI interface initialization */
-      if (MX_XSPI_RAM_Init(&hxspi_ram[Instance], &xspi_init) != HAL_OK)
-      {
-        ret = BSP_ERROR_PERIPH_FAILURE;
-      }
-      /* Reset the memory */
-      else if (APS256XX_Reset(&hxspi_ram[Instance]) != APS256XX_OK)
-      {
-        ret = BSP_ERROR_COMPONENT_FAILURE;
-      }
-      /* Configure the memory */
-      else if (BSP_XSPI_RAM_Config16BitsOctalRAM(Instance, Init) != BSP_ERROR_NONE)
-      {
-        ret = BSP_ERROR_COMPONENT_FAILURE;
-      }
-      else
-      {
-        /* Update current status parameter */
-        XSPI_Ram_Ctx[Instance].IsInitialized = XSPI_ACCESS_INDIRECT;
-      }
+    ret = XSPI_NOR_ProgramStep_IT(Instance);
+    if (ret != BSP_ERROR_NONE)
+    {
+      ctx->State = XSPI_NOR_IT_IDLE;
     }
   }
 
@@ -1239,133 +1633,106 @@ int32_t BSP_XSPI_RAM_Init(uint32_t Instance, BSP_XSPI_RAM_Cfg_t *Init)
 }
 
 /**
-  * @brief  De-Initializes the XSPI interface.
-  * @param  Instance   XSPI Instance
+  * @brief  Starts erasing the specified block of the XSPI memory in interrupt mode.
+  *         BSP_XSPI_NOR_EraseCpltCallback() is called at the end of the erase.
+  * @param  Instance     XSPI instance
+  * @param  BlockAddress Block address to erase
+  * @param  BlockSize    Erase Block size
   * @retval BSP status
   */
-int32_t BSP_XSPI_RAM_DeInit(uint32_t Instance)
+int32_t BSP_XSPI_NOR_Erase_Block_IT(uint32_t Instance, uint32_t BlockAddress, BSP_XSPI_NOR_Erase_t BlockSize)
 {
-  int32_t ret = BSP_ERROR_NONE;
+  int32_t ret;
 
   /* Check if the instance is supported */
-  if (Instance >= XSPI_RAM_INSTANCES_NUMBER)
+  if (Instance >= XSPI_NOR_INSTANCES_NUMBER)
   {
     ret = BSP_ERROR_WRONG_PARAM;
+  }/* Check if an interrupt driven operation is ongoing */
+  else if (XSPINor_ItCtx[Instance].State != XSPI_NOR_IT_IDLE)
+  {
+    ret = BSP_ERROR_BUSY;
+  }/* Check Flash busy ? */
+  else if (MX66UW1G45G_AutoPollingMemReady(&hxspi_nor[Instance], XSPI_Nor_Ctx[Instance].InterfaceMode,
+                                           XSPI_Nor_Ctx[Instance].TransferRate) != MX66UW1G45G_OK)
+  {
+    ret = BSP_ERROR_COMPONENT_FAILURE;
+  }/* Enable write operations */
+  else if (MX66UW1G45G_WriteEnable(&hxspi_nor[Instance], XSPI_Nor_Ctx[Instance].InterfaceMode,
+                                   XSPI_Nor_Ctx[Instance].TransferRate) != MX66UW1G45G_OK)
+  {
+    ret = BSP_ERROR_COMPONENT_FAILURE;
+  }/* Issue Block Erase command */
+  else if (MX66UW1G45G_BlockErase(&hxspi_nor[Instance], XSPI_Nor_Ctx[Instance].InterfaceMode,
+                                  XSPI_Nor_Ctx[Instance].TransferRate, MX66UW1G45G_4BYTES_SIZE,
+                                  BlockAddress, BlockSize) != MX66UW1G45G_OK)
+  {
+    ret = BSP_ERROR_COMPONENT_FAILURE;
   }
   else
   {
-    /* Check if the instance is already initialized */
-    if (XSPI_Ram_Ctx[Instance].IsInitialized != XSPI_ACCESS_NONE)
+    /* Erased block, a read inside it can not be served by suspending the erase */
+    XSPINor_ItCtx[Instance].Size       = XSPI_NOR_ERASE_SIZE(BlockSize);
+    XSPINor_ItCtx[Instance].Address    = BlockAddress - (BlockAddress % XSPINor_ItCtx[Instance].Size);
+    XSPI_NOR_CACHE_INVALIDATE(Instance, XSPINor_ItCtx[Instance].Address, XSPINor_ItCtx[Instance].Size);
+    XSPINor_ItCtx[Instance].Suspends   = 0U;
+    XSPINor_ItCtx[Instance].ResumeTick = HAL_GetTick();
+
+    /* Wait for the end of erase in interrupt mode */
+    XSPINor_ItCtx[Instance].State = XSPI_NOR_IT_ERASE;
+
+    ret = XSPI_NOR_AutoPolling_IT(Instance, 0U, MX66UW1G45G_SR_WIP);
+    if (ret != BSP_ERROR_NONE)
     {
-      /* Disable Memory mapped mode */
-      if (XSPI_Ram_Ctx[Instance].IsInitialized == XSPI_ACCESS_MMP)
-      {
-        if (BSP_XSPI_RAM_DisableMemoryMappedMode(Instance) != BSP_ERROR_NONE)
-        {
-          return BSP_ERROR_COMPONENT_FAILURE;
-        }
-      }
-      /* Set default XSPI_Ram_Ctx values */
-      XSPI_Ram_Ctx[Instance].IsInitialized    = XSPI_ACCESS_NONE;
-      XSPI_Ram_Ctx[Instance].LatencyType      = BSP_XSPI_RAM_VARIABLE_LATENCY;
-      XSPI_Ram_Ctx[Instance].ReadLatencyCode  = DEFAULT_READ_LATENCY_CODE;
-      XSPI_Ram_Ctx[Instance].WriteLatencyCode = DEFAULT_WRITE_LATENCY_CODE;
-      XSPI_Ram_Ctx[Instance].IOMode           = BSP_XSPI_RAM_IO_X8_MODE;
-
-#if (USE_HAL_XSPI_REGISTER_CALLBACKS == 0)
-      XSPI_RAM_MspDeInit(&hxspi_ram[Instance]);
-#endif /* (USE_HAL_XSPI_REGISTER_CALLBACKS == 0) */
-
-      /* Call the DeInit function to reset the driver */
-      if (HAL_XSPI_DeInit(&hxspi_ram[Instance]) != HAL_OK)
-      {
-        ret = BSP_ERROR_PERIPH_FAILURE;
-      }
+      XSPINor_ItCtx[Instance].State = XSPI_NOR_IT_IDLE;
     }
   }
 
   /* Return BSP status */
   return ret;
 }
-/**
-  * @}
-  */
-
-/** @addtogroup STM32H7S78_DK_XSPI_Exported_Init_Functions
-  * @{
-  */
 
 /**
-  * @brief  Initializes the XSPI interface.
-  * @param  hxspi          XSPI handle
-  * @param  Init           XSPI config structure
-  * @retval BSP status
+  * @brief  Handles XSPI NOR interrupt request.
+  * @param  Instance XSPI instance
+  * @retval None
   */
-__weak HAL_StatusTypeDef MX_XSPI_RAM_Init(XSPI_HandleTypeDef *hxspi, MX_XSPI_InitTypeDef *Init)
+void BSP_XSPI_NOR_IRQHandler(uint32_t Instance)
 {
-  uint32_t hspi_clk = HAL_RCCEx_GetPeriphCLKFreq(RCC_PERIPHCLK_XSPI1);
-
-  /* XSPI initialization */
-  hxspi->Instance = XSPI1;
-
-  hxspi->Init.FifoThresholdByte       = 4U;
-  hxspi->Init.MemoryType              = HAL_XSPI_MEMTYPE_APMEM_16BITS;
-  hxspi->Init.MemoryMode              = HAL_XSPI_SINGLE_MEM;
-  hxspi->Init.MemorySize              = Init->MemorySize;
-  hxspi->Init.MemorySelect            = HAL_XSPI_CSSEL_NCS1;
-  hxspi->Init.ChipSelectHighTimeCycle = 5U; /* tCPH = 24 ns min */
-  hxspi->Init.ClockMode               = HAL_XSPI_CLOCK_MODE_0;
-  hxspi->Init.ClockPrescaler          = Init->ClockPrescaler;
-  hxspi->Init.SampleShifting          = Init->SampleShifting;
-  hxspi->Init.DelayHoldQuarterCycle   = HAL_XSPI_DHQC_DISABLE;
-  hxspi->Init.ChipSelectBoundary      = HAL_XSPI_BONDARYOF_16KB;
-  hxspi->Init.FreeRunningClock        = HAL_XSPI_FREERUNCLK_DISABLE;
-  /* tCEM = 2 us max => REFRESH+4 clock cycles for read */
-  hxspi->Init.Refresh                 = ((2U * (hspi_clk / (hxspi->Init.ClockPrescaler + 1U)) / 1000000U) - 4U);
-  hxspi->Init.WrapSize                = HAL_XSPI_WRAP_NOT_SUPPORTED;
-  hxspi->Init.MaxTran                 = 0U;
-
-  return HAL_XSPI_Init(hxspi);
+  HAL_XSPI_IRQHandler(&hxspi_nor[Instance]);
 }
-/**
-  * @}
-  */
 
-/** @addtogroup STM32H7S78_DK_XSPI_RAM_Exported_Functions
-  * @{
-  */
-#if (USE_HAL_XSPI_REGISTER_CALLBACKS == 1)
+#if (USE_BSP_XSPI_NOR_DMA == 1)
 /**
-  * @brief Default BSP XSPI Msp Callbacks
-  * @param Instance      XSPI Instance
+  * @brief  Reads an amount of data from the XSPI memory in DMA mode.
+  *         BSP_XSPI_NOR_ReadCpltCallback() is called at the end of the transfer.
+  * @param  Instance  XSPI instance
+  * @param  pData     Pointer to data to be read, 4 bytes aligned
+  * @param  ReadAddr  Read start address
+  * @param  Size      Size of data to read, multiple of 4 bytes
   * @retval BSP status
   */
-int32_t BSP_XSPI_RAM_RegisterDefaultMspCallbacks(uint32_t Instance)
+int32_t BSP_XSPI_NOR_Read_DMA(uint32_t Instance, uint8_t *pData, uint32_t ReadAddr, uint32_t Size)
 {
-  int32_t ret = BSP_ERROR_NONE;
+  static BSP_XSPI_NOR_DmaItem_t item[XSPI_NOR_INSTANCES_NUMBER];
+  int32_t ret;
 
   /* Check if the instance is supported */
-  if (Instance >= XSPI_RAM_INSTANCES_NUMBER)
+  if (Instance >= XSPI_NOR_INSTANCES_NUMBER)
   {
     ret = BSP_ERROR_WRONG_PARAM;
+  }/* Check if an interrupt driven operation is ongoing, the item is in use */
+  else if (XSPINor_ItCtx[Instance].State != XSPI_NOR_IT_IDLE)
+  {
+    ret = BSP_ERROR_BUSY;
   }
   else
   {
-    /* Register MspInit/MspDeInit Callbacks */
-    if (HAL_XSPI_RegisterCallback(&hxspi_ram[Instance], HAL_XSPI_MSP_INIT_CB_ID,
-                                  XSPI_RAM_MspInit) != HAL_OK)
-    {
-      ret = BSP_ERROR_PERIPH_FAILURE;
-    }
-    else if (HAL_XSPI_RegisterCallback(&hxspi_ram[Instance], HAL_XSPI_MSP_DEINIT_CB_ID,
-                                       XSPI_RAM_MspDeInit) != HAL_OK)
-    {
-      ret = BSP_ERROR_PERIPH_FAILURE;
-    }
-    else
-    {
-      XSPIRam_IsMspCbValid[Instance] = 1U;
-    }
+    item[Instance].Address = ReadAddr;
+    item[Instance].pData   = pData;
+    item[Instance].Size    = Size;
+
+    ret = BSP_XSPI_NOR_ReadList_DMA(Instance, &item[Instance], 1U);
   }
 
   /* Return BSP status */
@@ -1373,69 +1740,127 @@ int32_t BSP_XSPI_RAM_RegisterDefaultMspCallbacks(uint32_t Instance)
 }
 
 /**
-  * @brief BSP XSPI Msp Callback registering
-  * @param Instance     XSPI Instance
-  * @param CallBacks    pointer to MspInit/MspDeInit callbacks functions
+  * @brief  Reads a list of memory regions in DMA mode. Each region is read with one
+  *         DMA transfer (split every XSPI_NOR_DMA_MAX_SIZE bytes), the next one is
+  *         started from the transfer complete interrupt and
+  *         BSP_XSPI_NOR_ReadCpltCallback() is called at the end of the last region.
+  * @param  Instance  XSPI instance
+  * @param  pItems    Regions to read, must stay valid until the end of the read
+  * @param  NbItems   Number of regions
   * @retval BSP status
   */
-int32_t BSP_XSPI_RAM_RegisterMspCallbacks(uint32_t Instance, BSP_XSPI_Cb_t *CallBacks)
+int32_t BSP_XSPI_NOR_ReadList_DMA(uint32_t Instance, const BSP_XSPI_NOR_DmaItem_t *pItems, uint32_t NbItems)
 {
   int32_t ret = BSP_ERROR_NONE;
+  XSPI_NOR_ItCtx_t *ctx;
+  uint32_t i;
 
   /* Check if the instance is supported */
-  if (Instance >= XSPI_RAM_INSTANCES_NUMBER)
+  if ((Instance >= XSPI_NOR_INSTANCES_NUMBER) || (pItems == NULL) || (NbItems == 0U))
   {
     ret = BSP_ERROR_WRONG_PARAM;
   }
   else
   {
-    /* Register MspInit/MspDeInit Callbacks */
-    if (HAL_XSPI_RegisterCallback(&hxspi_ram[Instance], HAL_XSPI_MSP_INIT_CB_ID,
-                                  CallBacks->pMspInitCb) != HAL_OK)
-    {
-      ret = BSP_ERROR_PERIPH_FAILURE;
-    }
-    else if (HAL_XSPI_RegisterCallback(&hxspi_ram[Instance], HAL_XSPI_MSP_DEINIT_CB_ID,
-                                       CallBacks->pMspDeInitCb) != HAL_OK)
+    /* The DMA moves words, each region must lie in the memory */
+    for (i = 0U; i < NbItems; i++)
     {
-      ret = BSP_ERROR_PERIPH_FAILURE;
+      if ((pItems[i].pData == NULL) || (pItems[i].Size == 0U) || (((uint32_t)pItems[i].pData % 4U) != 0U) ||
+          ((pItems[i].Size % 4U) != 0U) || (pItems[i].Size > MX66UW1G45G_FLASH_SIZE) ||
+          (pItems[i].Address > (MX66UW1G45G_FLASH_SIZE - pItems[i].Size)))
+      {
+        ret = BSP_ERROR_WRONG_PARAM;
+      }
     }
-    else
+  }
+
+  if (ret != BSP_ERROR_NONE)
+  {
+    /* Nothing to do */
+  }/* Check if an interrupt driven operation is ongoing */
+  else if (XSPINor_ItCtx[Instance].State != XSPI_NOR_IT_IDLE)
+  {
+    ret = BSP_ERROR_BUSY;
+  }/* Check if Flash busy ? */
+  else if (MX66UW1G45G_AutoPollingMemReady(&hxspi_nor[Instance], XSPI_Nor_Ctx[Instance].InterfaceMode,
+                                           XSPI_Nor_Ctx[Instance].TransferRate) != MX66UW1G45G_OK)
+  {
+    ret = BSP_ERROR_COMPONENT_FAILURE;
+  }
+  else
+  {
+    ctx = &XSPINor_ItCtx[Instance];
+
+    ctx->pItems      = pItems;
+    ctx->NbItems     = NbItems;
+    ctx->Item        = 0U;
+    ctx->Address     = pItems[0].Address;
+    ctx->EndAddress  = pItems[0].Address + pItems[0].Size;
+    ctx->DataAddress = (uint32_t)pItems[0].pData;
+    ctx->State       = XSPI_NOR_IT_READ_DMA;
+
+    ret = XSPI_NOR_ReadNext_DMA(Instance);
+    if (ret != BSP_ERROR_NONE)
     {
-      XSPIRam_IsMspCbValid[Instance] = 1U;
+      ctx->State = XSPI_NOR_IT_IDLE;
     }
   }
 
   /* Return BSP status */
   return ret;
 }
-#endif /* (USE_HAL_XSPI_REGISTER_CALLBACKS == 1) */
 
 /**
-  * @brief  Reads an amount of data from the XSPI memory.
+  * @brief  Writes an amount of data to the XSPI memory in DMA mode. Each page is
+  *         sent by the DMA, then programmed while the XSPI polls the memory status;
+  *         BSP_XSPI_NOR_WriteCpltCallback() is called at the end of the last page.
   * @param  Instance  XSPI instance
-  * @param  pData     Pointer to data to be read
-  * @param  ReadAddr  Read start address
-  * @param  Size      Size of data to read
+  * @param  pData     Pointer to data to be written, 4 bytes aligned, must stay valid
+  *                   until the end of the write
+  * @param  WriteAddr Write start address, multiple of 4 bytes
+  * @param  Size      Size of data to write, multiple of 4 bytes
   * @retval BSP status
   */
-int32_t BSP_XSPI_RAM_Read(uint32_t Instance, uint8_t *pData, uint32_t ReadAddr, uint32_t Size)
+int32_t BSP_XSPI_NOR_Write_DMA(uint32_t Instance, const uint8_t *pData, uint32_t WriteAddr, uint32_t Size)
 {
-  int32_t ret = BSP_ERROR_NONE;
+  int32_t ret;
+  XSPI_NOR_ItCtx_t *ctx;
 
   /* Check if the instance is supported */
-  if (Instance >= XSPI_RAM_INSTANCES_NUMBER)
+  if ((Instance >= XSPI_NOR_INSTANCES_NUMBER) || (pData == NULL) || (Size == 0U) ||
+      (((uint32_t)pData % 4U) != 0U) || ((WriteAddr % 4U) != 0U) || ((Size % 4U) != 0U))
   {
     ret = BSP_ERROR_WRONG_PARAM;
+  }/* Check if an interrupt driven operation is ongoing */
+  else if (XSPINor_ItCtx[Instance].State != XSPI_NOR_IT_IDLE)
+  {
+    ret = BSP_ERROR_BUSY;
+  }/* Check if Flash busy ? */
+  else if (MX66UW1G45G_AutoPollingMemReady(&hxspi_nor[Instance], XSPI_Nor_Ctx[Instance].InterfaceMode,
+                                           XSPI_Nor_Ctx[Instance].TransferRate) != MX66UW1G45G_OK)
+  {
+    ret = BSP_ERROR_COMPONENT_FAILURE;
   }
   else
   {
-    if (APS256XX_Read(&hxspi_ram[Instance], pData, ReadAddr, Size,
-                      (uint32_t)APS256XX_READ_LATENCY((uint32_t)(XSPI_Ram_Ctx[Instance].ReadLatencyCode),
-                                                      (uint32_t)(XSPI_Ram_Ctx[Instance].LatencyType)),
-                      (uint32_t)(XSPI_Ram_Ctx[Instance].IOMode), 0U) != APS256XX_OK)
+    ctx = &XSPINor_ItCtx[Instance];
+
+    /* Program the first page, up to the end of the page */
+    ctx->Address     = WriteAddr;
+    ctx->EndAddress  = WriteAddr + Size;
+    ctx->DataAddress = (uint32_t)pData;
+    ctx->Size        = MX66UW1G45G_PAGE_SIZE - (WriteAddr % MX66UW1G45G_PAGE_SIZE);
+    if (ctx->Size > Size)
     {
-      ret = BSP_ERROR_PERIPH_FAILURE;
+      ctx->Size = Size;
+    }
+    ctx->State = XSPI_NOR_IT_PROGRAM_DMA;
+    ctx->Step  = XSPI_NOR_STEP_WRITE_ENABLE;
+
+    ret = XSPI_NOR_ProgramStep_IT(Instance);
+    if (ret != BSP_ERROR_NONE)
+    {
+      ctx->State = XSPI_NOR_IT_IDLE;
     }
   }
 
@@ -1444,30 +1869,304 @@ int32_t BSP_XSPI_RAM_Read(uint32_t Instance, uint8_t *pData, uint32_t ReadAddr,
 }
 
 /**
-  * @brief  Reads an amount of data from the 16-bits Octal RAM memory in DMA mode.
-  * @param  Instance  XSPI instance
-  * @param  pData     Pointer to data to be read
-  * @param  ReadAddr  Read start address
-  * @param  Size      Size of data to read
-  * @retval BSP status
+  * @brief  Handles XSPI NOR DMA receive interrupt request.
+  * @param  Instance XSPI instance
+  * @retval None
   */
-int32_t BSP_XSPI_RAM_Read_DMA(uint32_t Instance, uint8_t *pData, uint32_t ReadAddr, uint32_t Size)
+void BSP_XSPI_NOR_DMA_RX_IRQHandler(uint32_t Instance)
 {
-  int32_t ret = BSP_ERROR_NONE;
+  HAL_DMA_IRQHandler(hxspi_nor[Instance].hdmarx);
+}
 
-  /* Check if the instance is supported */
+/**
+  * @brief  Handles XSPI NOR DMA transmit interrupt request.
+  * @param  Instance XSPI instance
+  * @retval None
+  */
+void BSP_XSPI_NOR_DMA_TX_IRQHandler(uint32_t Instance)
+{
+  HAL_DMA_IRQHandler(hxspi_nor[Instance].hdmatx);
+}
+#endif /* USE_BSP_XSPI_NOR_DMA */
+
+/**
+  * @brief  Gets the statistics of the reads issued during interrupt driven erases.
+  * @param  Instance  XSPI instance
+  * @param  pStats    Pointer to the statistics
+  * @retval BSP status
+  */
+int32_t BSP_XSPI_NOR_GetSuspendStats(uint32_t Instance, BSP_XSPI_NOR_SuspendStats_t *pStats)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  /* Check if the instance is supported */
+  if ((Instance >= XSPI_NOR_INSTANCES_NUMBER) || (pStats == NULL))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    *pStats = XSPINor_SuspendStats[Instance];
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+#if (USE_BSP_XSPI_NOR_READ_CACHE == 1)
+/**
+  * @brief  Gets the statistics of the read cache.
+  * @param  Instance  XSPI instance
+  * @param  pStats    Pointer to the statistics
+  * @retval BSP status
+  */
+int32_t BSP_XSPI_NOR_GetCacheStats(uint32_t Instance, BSP_XSPI_NOR_CacheStats_t *pStats)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  /* Check if the instance is supported */
+  if ((Instance >= XSPI_NOR_INSTANCES_NUMBER) || (pStats == NULL))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    *pStats = XSPINor_CacheStats[Instance];
+    pStats->HitRatio = (pStats->Reads == 0U) ? 0U
+                       : (uint32_t)(((uint64_t)pStats->Hits * 100U) / pStats->Reads);
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+#endif /* USE_BSP_XSPI_NOR_READ_CACHE */
+
+#if (USE_BSP_XSPI_NOR_DMA == 1)
+/**
+  * @brief  BSP XSPI NOR read complete callback.
+  * @param  Instance XSPI instance
+  * @retval None
+  */
+__weak void BSP_XSPI_NOR_ReadCpltCallback(uint32_t Instance)
+{
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(Instance);
+
+  /* This function should be implemented by the user application.
+     It is called into this driver when a DMA read is completed. */
+}
+#endif /* USE_BSP_XSPI_NOR_DMA */
+
+/**
+  * @brief  BSP XSPI NOR write complete callback.
+  * @param  Instance XSPI instance
+  * @retval None
+  */
+__weak void BSP_XSPI_NOR_WriteCpltCallback(uint32_t Instance)
+{
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(Instance);
+
+  /* This function should be implemented by the user application.
+     It is called into this driver when an interrupt driven write is completed. */
+}
+
+/**
+  * @brief  BSP XSPI NOR erase complete callback.
+  * @param  Instance XSPI instance
+  * @retval None
+  */
+__weak void BSP_XSPI_NOR_EraseCpltCallback(uint32_t Instance)
+{
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(Instance);
+
+  /* This function should be implemented by the user application.
+     It is called into this driver when an interrupt driven erase is completed. */
+}
+
+/**
+  * @brief  BSP XSPI NOR error callback.
+  * @param  Instance XSPI instance
+  * @retval None
+  */
+__weak void BSP_XSPI_NOR_ErrorCallback(uint32_t Instance)
+{
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(Instance);
+
+  /* This function should be implemented by the user application.
+     It is called into this driver when an interrupt driven operation fails. */
+}
+
+#if (USE_HAL_XSPI_REGISTER_CALLBACKS == 0)
+/**
+  * @brief  Forwards the XSPI status match event to the interrupt driven NOR
+  *         operations. Without HAL callbacks registration, it must be called
+  *         from the application HAL_XSPI_StatusMatchCallback().
+  * @param  hxspi XSPI handle
+  * @retval None
+  */
+void BSP_XSPI_NOR_StatusMatchCallback(XSPI_HandleTypeDef *hxspi)
+{
+  XSPI_NOR_StatusMatchCallback(hxspi);
+}
+
+/**
+  * @brief  Forwards the XSPI error event to the interrupt driven NOR
+  *         operations. Without HAL callbacks registration, it must be called
+  *         from the application HAL_XSPI_ErrorCallback().
+  * @param  hxspi XSPI handle
+  * @retval None
+  */
+void BSP_XSPI_NOR_TransferErrorCallback(XSPI_HandleTypeDef *hxspi)
+{
+  XSPI_NOR_ErrorCallback(hxspi);
+}
+
+/**
+  * @brief  Forwards the XSPI command complete event to the interrupt driven NOR
+  *         operations. Without HAL callbacks registration, it must be called
+  *         from the application HAL_XSPI_CmdCpltCallback().
+  * @param  hxspi XSPI handle
+  * @retval None
+  */
+void BSP_XSPI_NOR_CmdCpltCallback(XSPI_HandleTypeDef *hxspi)
+{
+  XSPI_NOR_CmdCpltCallback(hxspi);
+}
+
+/**
+  * @brief  Forwards the XSPI Tx transfer complete event to the interrupt and DMA
+  *         driven NOR programs. Without HAL callbacks registration, it must be
+  *         called from the application HAL_XSPI_TxCpltCallback().
+  * @param  hxspi XSPI handle
+  * @retval None
+  */
+void BSP_XSPI_NOR_TxCpltCallback(XSPI_HandleTypeDef *hxspi)
+{
+  XSPI_NOR_TxCpltCallback(hxspi);
+}
+
+#if (USE_BSP_XSPI_NOR_DMA == 1)
+/**
+  * @brief  Forwards the XSPI Rx transfer complete event to the DMA driven NOR
+  *         operations. Without HAL callbacks registration, it must be called
+  *         from the application HAL_XSPI_RxCpltCallback().
+  * @param  hxspi XSPI handle
+  * @retval None
+  */
+void BSP_XSPI_NOR_RxCpltCallback(XSPI_HandleTypeDef *hxspi)
+{
+  XSPI_NOR_RxCpltCallback(hxspi);
+}
+#endif /* USE_BSP_XSPI_NOR_DMA */
+#endif /* (USE_HAL_XSPI_REGISTER_CALLBACKS == 0) */
+/**
+  * @}
+  */
+#endif /* USE_NOR_MEMORY_MX66UW1G45G */
+
+#if (USE_RAM_MEMORY_APS256XX == 1)
+/** @addtogroup STM32H7S78_DK_XSPI_RAM_Exported_Functions
+  * @{
+  */
+
+/**
+  * @brief  Initializes the XSPI interface.
+  * @param  Instance   XSPI Instance
+  * @param  Init       XSPI Init structure
+  * @retval BSP status
+  */
+int32_t BSP_XSPI_RAM_Init(uint32_t Instance, BSP_XSPI_RAM_Cfg_t *Init)
+{
+  MX_XSPI_InitTypeDef xspi_init;
+  int32_t ret = BSP_ERROR_NONE;
+  uint32_t xspi_clk, xspi_max_freq;
+
+  /* Check if the instance is supported */
   if (Instance >= XSPI_RAM_INSTANCES_NUMBER)
   {
     ret = BSP_ERROR_WRONG_PARAM;
   }
   else
   {
-    if (APS256XX_Read_DMA(&hxspi_ram[Instance], pData, ReadAddr, Size,
-                          (uint32_t)APS256XX_READ_LATENCY((uint32_t)(XSPI_Ram_Ctx[Instance].ReadLatencyCode),
-                                                          (uint32_t)(XSPI_Ram_Ctx[Instance].LatencyType)),
-                          (uint32_t)(XSPI_Ram_Ctx[Instance].IOMode), 0U) != APS256XX_OK)
+    /* Check if the instance is already initialized */
+    if (XSPI_Ram_Ctx[Instance].IsInitialized == XSPI_ACCESS_NONE)
     {
-      ret = BSP_ERROR_COMPONENT_FAILURE;
+#if (USE_HAL_XSPI_REGISTER_CALLBACKS == 0)
+      /* Msp XSPI initialization */
+      XSPI_RAM_MspInit(&hxspi_ram[Instance]);
+#else
+      /* Register the XSPI MSP Callbacks */
+      if (XSPIRam_IsMspCbValid[Instance] == 0UL)
+      {
+        if (BSP_XSPI_RAM_RegisterDefaultMspCallbacks(Instance) != BSP_ERROR_NONE)
+        {
+          return BSP_ERROR_PERIPH_FAILURE;
+        }
+      }
+#endif /* USE_HAL_XSPI_REGISTER_CALLBACKS */
+
+      /* Fill config structure */
+      if ((Init->ReadLatencyCode == BSP_XSPI_RAM_READ_LATENCY_3) ||
+          (Init->WriteLatencyCode == BSP_XSPI_RAM_WRITE_LATENCY_3))
+      {
+        /* In case of latency 3, Fmax of memory is 66 MHz */
+        xspi_max_freq = 66000000U;
+      }
+      else if ((Init->ReadLatencyCode == BSP_XSPI_RAM_READ_LATENCY_4) ||
+               (Init->WriteLatencyCode == BSP_XSPI_RAM_WRITE_LATENCY_4))
+      {
+        /* In case of latency 4, Fmax of memory is 109 MHz */
+        xspi_max_freq = 109000000U;
+      }
+      else if ((Init->ReadLatencyCode == BSP_XSPI_RAM_READ_LATENCY_5) ||
+               (Init->WriteLatencyCode == BSP_XSPI_RAM_WRITE_LATENCY_5))
+      {
+        /* In case of latency 5, Fmax of memory is 133 MHz */
+        xspi_max_freq = 133000000U;
+      }
+      else if ((Init->ReadLatencyCode == BSP_XSPI_RAM_READ_LATENCY_6) ||
+          (Init->WriteLatencyCode == BSP_XSPI_RAM_WRITE_LATENCY_6))
+      {
+        /* In case of latency 6, Fmax of memory is 166 MHz */
+        xspi_max_freq = 166000000U;
+      }
+      else
+      {
+        /* In case of latency 7, Fmax of memory is 200 MHz */
+        xspi_max_freq = 200000000U;
+      }
+      xspi_clk = HAL_RCCEx_GetPeriphCLKFreq(RCC_PERIPHCLK_XSPI1);
+      xspi_init.ClockPrescaler = (xspi_clk / xspi_max_freq);
+      if ((xspi_clk % xspi_max_freq) == 0U)
+      {
+        xspi_init.ClockPrescaler = xspi_init.ClockPrescaler - 1U;
+      }
+      xspi_init.MemorySize     = HAL_XSPI_SIZE_256MB;
+      xspi_init.SampleShifting = HAL_XSPI_SAMPLE_SHIFT_NONE;
+
+      /* STM32 XSPI interface initialization */
+      if (MX_XSPI_RAM_Init(&hxspi_ram[Instance], &xspi_init) != HAL_OK)
+      {
+        ret = BSP_ERROR_PERIPH_FAILURE;
+      }
+      /* Reset the memory */
+      else if (APS256XX_Reset(&hxspi_ram[Instance]) != APS256XX_OK)
+      {
+        ret = BSP_ERROR_COMPONENT_FAILURE;
+      }
+      /* Configure the memory */
+      else if (BSP_XSPI_RAM_Config16BitsOctalRAM(Instance, Init) != BSP_ERROR_NONE)
+      {
+        ret = BSP_ERROR_COMPONENT_FAILURE;
+      }
+      else
+      {
+        /* Update current status parameter */
+        XSPI_Ram_Ctx[Instance].IsInitialized = XSPI_ACCESS_INDIRECT;
+      }
     }
   }
 
@@ -1476,30 +2175,1271 @@ int32_t BSP_XSPI_RAM_Read_DMA(uint32_t Instance, uint8_t *pData, uint32_t ReadAd
 }
 
 /**
-  * @brief  Writes an amount of data to the XSPI memory.
-  * @param  Instance  XSPI instance
-  * @param  pData     Pointer to data to be written
-  * @param  WriteAddr Write start address
-  * @param  Size      Size of data to write
+  * @brief  De-Initializes the XSPI interface.
+  * @param  Instance   XSPI Instance
   * @retval BSP status
   */
-int32_t BSP_XSPI_RAM_Write(uint32_t Instance, uint8_t *pData, uint32_t WriteAddr, uint32_t Size)
+int32_t BSP_XSPI_RAM_DeInit(uint32_t Instance)
 {
   int32_t ret = BSP_ERROR_NONE;
 
   /* Check if the instance is supported */
   if (Instance >= XSPI_RAM_INSTANCES_NUMBER)
   {
-    ret = BSP_ERROR_WRONG_PARAM;
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    /* Check if the instance is already initialized */
+    if (XSPI_Ram_Ctx[Instance].IsInitialized != XSPI_ACCESS_NONE)
+    {
+      /* Disable Memory mapped mode */
+      if (XSPI_Ram_Ctx[Instance].IsInitialized == XSPI_ACCESS_MMP)
+      {
+        if (BSP_XSPI_RAM_DisableMemoryMappedMode(Instance) != BSP_ERROR_NONE)
+        {
+          return BSP_ERROR_COMPONENT_FAILURE;
+        }
+      }
+      /* Set default XSPI_Ram_Ctx values */
+      XSPI_Ram_Ctx[Instance].IsInitialized    = XSPI_ACCESS_NONE;
+      XSPI_Ram_Ctx[Instance].LatencyType      = BSP_XSPI_RAM_VARIABLE_LATENCY;
+      XSPI_Ram_Ctx[Instance].ReadLatencyCode  = DEFAULT_READ_LATENCY_CODE;
+      XSPI_Ram_Ctx[Instance].WriteLatencyCode = DEFAULT_WRITE_LATENCY_CODE;
+      XSPI_Ram_Ctx[Instance].IOMode           = BSP_XSPI_RAM_IO_X8_MODE;
+
+#if (USE_HAL_XSPI_REGISTER_CALLBACKS == 0)
+      XSPI_RAM_MspDeInit(&hxspi_ram[Instance]);
+#endif /* (USE_HAL_XSPI_REGISTER_CALLBACKS == 0) */
+
+      /* Call the DeInit function to reset the driver */
+      if (HAL_XSPI_DeInit(&hxspi_ram[Instance]) != HAL_OK)
+      {
+        ret = BSP_ERROR_PERIPH_FAILURE;
+      }
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+/**
+  * @}
+  */
+
+/** @addtogroup STM32H7S78_DK_XSPI_Exported_Init_Functions
+  * @{
+  */
+
+/**
+  * @brief  Initializes the XSPI interface.
+  * @param  hxspi          XSPI handle
+  * @param  Init           XSPI config structure
+  * @retval BSP status
+  */
+__weak HAL_StatusTypeDef MX_XSPI_RAM_Init(XSPI_HandleTypeDef *hxspi, MX_XSPI_InitTypeDef *Init)
+{
+  uint32_t hspi_clk = HAL_RCCEx_GetPeriphCLKFreq(RCC_PERIPHCLK_XSPI1);
+
+  /* XSPI initialization */
+  hxspi->Instance = XSPI1;
+
+  hxspi->Init.FifoThresholdByte       = 4U;
+  hxspi->Init.MemoryType              = HAL_XSPI_MEMTYPE_APMEM_16BITS;
+  hxspi->Init.MemoryMode              = HAL_XSPI_SINGLE_MEM;
+  hxspi->Init.MemorySize              = Init->MemorySize;
+  hxspi->Init.MemorySelect            = HAL_XSPI_CSSEL_NCS1;
+  hxspi->Init.ChipSelectHighTimeCycle = 5U; /* tCPH = 24 ns min */
+  hxspi->Init.ClockMode               = HAL_XSPI_CLOCK_MODE_0;
+  hxspi->Init.ClockPrescaler          = Init->ClockPrescaler;
+  hxspi->Init.SampleShifting          = Init->SampleShifting;
+  hxspi->Init.DelayHoldQuarterCycle   = HAL_XSPI_DHQC_DISABLE;
+  hxspi->Init.ChipSelectBoundary      = HAL_XSPI_BONDARYOF_16KB;
+  hxspi->Init.FreeRunningClock        = HAL_XSPI_FREERUNCLK_DISABLE;
+  /* tCEM = 2 us max => REFRESH+4 clock cycles for read */
+  hxspi->Init.Refresh                 = ((2U * (hspi_clk / (hxspi->Init.ClockPrescaler + 1U)) / 1000000U) - 4U);
+  hxspi->Init.WrapSize                = HAL_XSPI_WRAP_NOT_SUPPORTED;
+  hxspi->Init.MaxTran                 = 0U;
+
+  return HAL_XSPI_Init(hxspi);
+}
+/**
+  * @}
+  */
+
+/** @addtogroup STM32H7S78_DK_XSPI_RAM_Exported_Functions
+  * @{
+  */
+#if (USE_HAL_XSPI_REGISTER_CALLBACKS == 1)
+/**
+  * @brief Default BSP XSPI Msp Callbacks
+  * @param Instance      XSPI Instance
+  * @retval BSP status
+  */
+int32_t BSP_XSPI_RAM_RegisterDefaultMspCallbacks(uint32_t Instance)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  /* Check if the instance is supported */
+  if (Instance >= XSPI_RAM_INSTANCES_NUMBER)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    /* Register MspInit/MspDeInit Callbacks */
+    if (HAL_XSPI_RegisterCallback(&hxspi_ram[Instance], HAL_XSPI_MSP_INIT_CB_ID,
+                                  XSPI_RAM_MspInit) != HAL_OK)
+    {
+      ret = BSP_ERROR_PERIPH_FAILURE;
+    }
+    else if (HAL_XSPI_RegisterCallback(&hxspi_ram[Instance], HAL_XSPI_MSP_DEINIT_CB_ID,
+                                       XSPI_RAM_MspDeInit) != HAL_OK)
+    {
+      ret = BSP_ERROR_PERIPH_FAILURE;
+    }
+    else
+    {
+      XSPIRam_IsMspCbValid[Instance] = 1U;
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief BSP XSPI Msp Callback registering
+  * @param Instance     XSPI Instance
+  * @param CallBacks    pointer to MspInit/MspDeInit callbacks functions
+  * @retval BSP status
+  */
+int32_t BSP_XSPI_RAM_RegisterMspCallbacks(uint32_t Instance, BSP_XSPI_Cb_t *CallBacks)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  /* Check if the instance is supported */
+  if (Instance >= XSPI_RAM_INSTANCES_NUMBER)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    /* Register MspInit/MspDeInit Callbacks */
+    if (HAL_XSPI_RegisterCallback(&hxspi_ram[Instance], HAL_XSPI_MSP_INIT_CB_ID,
+                                  CallBacks->pMspInitCb) != HAL_OK)
+    {
+      ret = BSP_ERROR_PERIPH_FAILURE;
+    }
+    else if (HAL_XSPI_RegisterCallback(&hxspi_ram[Instance], HAL_XSPI_MSP_DEINIT_CB_ID,
+                                       CallBacks->pMspDeInitCb) != HAL_OK)
+    {
+      ret = BSP_ERROR_PERIPH_FAILURE;
+    }
+    else
+    {
+      XSPIRam_IsMspCbValid[Instance] = 1U;
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+#endif /* (USE_HAL_XSPI_REGISTER_CALLBACKS == 1) */
+
+/**
+  * @brief  Reads an amount of data from the XSPI memory.
+  * @param  Instance  XSPI instance
+  * @param  pData     Pointer to data to be read
+  * @param  ReadAddr  Read start address
+  * @param  Size      Size of data to read
+  * @retval BSP status
+  */
+int32_t BSP_XSPI_RAM_Read(uint32_t Instance, uint8_t *pData, uint32_t ReadAddr, uint32_t Size)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  /* Check if the instance is supported */
+  if (Instance >= XSPI_RAM_INSTANCES_NUMBER)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    if (APS256XX_Read(&hxspi_ram[Instance], pData, ReadAddr, Size,
+                      (uint32_t)APS256XX_READ_LATENCY((uint32_t)(XSPI_Ram_Ctx[Instance].ReadLatencyCode),
+                                                      (uint32_t)(XSPI_Ram_Ctx[Instance].LatencyType)),
+                      (uint32_t)(XSPI_Ram_Ctx[Instance].IOMode), 0U) != APS256XX_OK)
+    {
+      ret = BSP_ERROR_PERIPH_FAILURE;
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  Reads an amount of data from the 16-bits Octal RAM memory in DMA mode.
+  * @param  Instance  XSPI instance
+  * @param  pData     Pointer to data to be read
+  * @param  ReadAddr  Read start address
+  * @param  Size      Size of data to read
+  * @retval BSP status
+  */
+int32_t BSP_XSPI_RAM_Read_DMA(uint32_t Instance, uint8_t *pData, uint32_t ReadAddr, uint32_t Size)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  /* Check if the instance is supported */
+  if (Instance >= XSPI_RAM_INSTANCES_NUMBER)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    if (APS256XX_Read_DMA(&hxspi_ram[Instance], pData, ReadAddr, Size,
+                          (uint32_t)APS256XX_READ_LATENCY((uint32_t)(XSPI_Ram_Ctx[Instance].ReadLatencyCode),
+                                                          (uint32_t)(XSPI_Ram_Ctx[Instance].LatencyType)),
+                          (uint32_t)(XSPI_Ram_Ctx[Instance].IOMode), 0U) != APS256XX_OK)
+    {
+      ret = BSP_ERROR_COMPONENT_FAILURE;
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  Writes an amount of data to the XSPI memory.
+  * @param  Instance  XSPI instance
+  * @param  pData     Pointer to data to be written
+  * @param  WriteAddr Write start address
+  * @param  Size      Size of data to write
+  * @retval BSP status
+  */
+int32_t BSP_XSPI_RAM_Write(uint32_t Instance, uint8_t *pData, uint32_t WriteAddr, uint32_t Size)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  /* Check if the instance is supported */
+  if (Instance >= XSPI_RAM_INSTANCES_NUMBER)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    if (APS256XX_Write(&hxspi_ram[Instance], pData, WriteAddr, Size,
+                       (uint32_t)APS256XX_WRITE_LATENCY((uint32_t)(XSPI_Ram_Ctx[Instance].WriteLatencyCode)),
+                       (uint32_t)(XSPI_Ram_Ctx[Instance].IOMode), 0U) != APS256XX_OK)
+    {
+      ret = BSP_ERROR_PERIPH_FAILURE;
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  Writes an amount of data to the 16-bits Octal RAM memory in DMA mode.
+  * @param  Instance  XSPI instance
+  * @param  pData     Pointer to data to be written
+  * @param  WriteAddr Write start address
+  * @param  Size      Size of data to write
+  * @retval BSP status
+  */
+int32_t BSP_XSPI_RAM_Write_DMA(uint32_t Instance, uint8_t *pData, uint32_t WriteAddr, uint32_t Size)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  /* Check if the instance is supported */
+  if (Instance >= XSPI_RAM_INSTANCES_NUMBER)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    if (APS256XX_Write_DMA(&hxspi_ram[Instance], pData, WriteAddr, Size,
+                           (uint32_t)APS256XX_WRITE_LATENCY((uint32_t)(XSPI_Ram_Ctx[Instance].WriteLatencyCode)),
+                           (uint32_t)(XSPI_Ram_Ctx[Instance].IOMode), 0U) != APS256XX_OK)
+    {
+      ret = BSP_ERROR_COMPONENT_FAILURE;
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  Configure the XSPI in memory-mapped mode
+  * @param  Instance  XSPI instance
+  * @retval BSP status
+  */
+int32_t BSP_XSPI_RAM_EnableMemoryMappedMode(uint32_t Instance)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  /* Check if the instance is supported */
+  if (Instance >= XSPI_RAM_INSTANCES_NUMBER)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    if (APS256XX_EnableMemoryMappedMode(&hxspi_ram[Instance],
+                                        (uint32_t)APS256XX_READ_LATENCY(\
+                                                                        (uint32_t)(XSPI_Ram_Ctx[Instance].ReadLatencyCode),
+                                                                        (uint32_t)(XSPI_Ram_Ctx[Instance].LatencyType)),
+                                        (uint32_t)APS256XX_WRITE_LATENCY(\
+                                                                        (uint32_t)(XSPI_Ram_Ctx[Instance].WriteLatencyCode)),
+                                        (uint32_t)(XSPI_Ram_Ctx[Instance].IOMode), 0U) != APS256XX_OK)
+    {
+      ret = BSP_ERROR_PERIPH_FAILURE;
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  Exit the memory-mapped mode
+  * @param  Instance  XSPI instance
+  * @retval BSP status
+  */
+int32_t BSP_XSPI_RAM_DisableMemoryMappedMode(uint32_t Instance)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  /* Check if the instance is supported */
+  if (Instance >= XSPI_RAM_INSTANCES_NUMBER)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    if (XSPI_Ram_Ctx[Instance].IsInitialized != XSPI_ACCESS_MMP)
+    {
+      ret = BSP_ERROR_XSPI_MMP_UNLOCK_FAILURE;
+    }
+    /* Abort MMP back to indirect mode */
+    else if (HAL_XSPI_Abort(&hxspi_ram[Instance]) != HAL_OK)
+    {
+      ret = BSP_ERROR_PERIPH_FAILURE;
+    }
+    /* Update XSPI HyperRAM context if all operations are well done */
+    else
+    {
+      XSPI_Ram_Ctx[Instance].IsInitialized = XSPI_ACCESS_INDIRECT;
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  Get RAM ID 3 Bytes:
+  *         Vendor ID, Device ID, Device Density
+  * @param  Instance  XSPI instance
+  * @param  Id Pointer to RAM ID bytes
+  * @retval BSP status
+  */
+int32_t BSP_XSPI_RAM_ReadID(uint32_t Instance, uint8_t *Id)
+{
+  int32_t ret;
+
+  /* Check if the instance is supported */
+  if (Instance >= XSPI_RAM_INSTANCES_NUMBER)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if (APS256XX_ReadID(&hxspi_ram[0], Id, (uint32_t)APS256XX_READ_REG_LATENCY(\
+                                                                                  (uint32_t)(XSPI_Ram_Ctx[Instance].ReadLatencyCode))) != APS256XX_OK)
+  {
+    ret = BSP_ERROR_COMPONENT_FAILURE;
+  }
+  else
+  {
+    ret = BSP_ERROR_NONE;
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  Set 16-bits Octal RAM to desired configuration. And this instance becomes current instance.
+  *         If current instance running at MMP mode then this function doesn't work.
+  *         Indirect -> Indirect
+  * @param  Instance    XSPI instance
+  * @param  Cfg         pointer to the RAM config
+  * @retval BSP status
+  */
+int32_t BSP_XSPI_RAM_Config16BitsOctalRAM(uint32_t Instance, BSP_XSPI_RAM_Cfg_t *Cfg)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  uint8_t reg[2] = {0};
+
+  /* Check if the instance is supported */
+  if (Instance >= XSPI_RAM_INSTANCES_NUMBER)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    /* Check if MMP mode locked ***********************************************/
+    if (XSPI_Ram_Ctx[Instance].IsInitialized == XSPI_ACCESS_MMP)
+    {
+      ret = BSP_ERROR_XSPI_MMP_LOCK_FAILURE;
+    }
+    else
+    {
+      if ((XSPI_Ram_Ctx[Instance].IsInitialized   == XSPI_ACCESS_NONE) ||
+          (XSPI_Ram_Ctx[Instance].LatencyType     != Cfg->LatencyType) ||
+          (XSPI_Ram_Ctx[Instance].ReadLatencyCode != Cfg->ReadLatencyCode))
+      {
+        /* Reading the configuration of Mode Register 0 ***********************/
+        if (APS256XX_ReadReg(&hxspi_ram[Instance], APS256XX_MR0_ADDRESS, reg,
+                             (uint32_t)APS256XX_READ_REG_LATENCY((uint32_t) \
+                               (XSPI_Ram_Ctx[Instance].ReadLatencyCode))) != APS256XX_OK)
+        {
+          ret = BSP_ERROR_COMPONENT_FAILURE;
+        }
+        else
+        {
+          /* Configure the 16-bits Octal RAM memory ***************************/
+          MODIFY_REG(reg[0], ((uint8_t)APS256XX_MR0_LATENCY_TYPE |
+                              (uint8_t)APS256XX_MR0_READ_LATENCY_CODE |
+                              (uint8_t)APS256XX_MR0_DRIVE_STRENGTH),
+                     ((uint8_t)(Cfg->LatencyType) |
+                     (uint8_t)(Cfg->ReadLatencyCode) |
+                     (uint8_t)CONF_HSPI_DS));
+
+          if (APS256XX_WriteReg(&hxspi_ram[Instance], APS256XX_MR0_ADDRESS, reg[0]) != APS256XX_OK)
+          {
+            ret = BSP_ERROR_COMPONENT_FAILURE;
+          }
+        }
+      }
+
+      if (ret == BSP_ERROR_NONE)
+      {
+        if ((XSPI_Ram_Ctx[Instance].IsInitialized    == XSPI_ACCESS_NONE) ||
+            (XSPI_Ram_Ctx[Instance].WriteLatencyCode != Cfg->WriteLatencyCode))
+        {
+          /* Reading the configuration of Mode Register 4 ***********************/
+          if (APS256XX_ReadReg(&hxspi_ram[Instance], APS256XX_MR4_ADDRESS, reg,
+                               (uint32_t)APS256XX_READ_REG_LATENCY((uint32_t) \
+                                                                   (XSPI_Ram_Ctx[Instance].ReadLatencyCode))) != APS256XX_OK)
+          {
+            ret = BSP_ERROR_COMPONENT_FAILURE;
+          }
+          else
+          {
+            /* Configure the 16-bits Octal RAM memory ***************************/
+            WRITE_REG(reg[0], ((uint8_t)Cfg->WriteLatencyCode |
+                               (uint8_t)CONF_HSPI_RF |
+                               (uint8_t)CONF_HSPI_PASR));
+
+            if (APS256XX_WriteReg(&hxspi_ram[Instance], APS256XX_MR4_ADDRESS, reg[0]) != APS256XX_OK)
+            {
+              ret = BSP_ERROR_COMPONENT_FAILURE;
+            }
+          }
+        }
+      }
+
+      if (ret == BSP_ERROR_NONE)
+      {
+        if ((XSPI_Ram_Ctx[Instance].IsInitialized == XSPI_ACCESS_NONE) ||
+            (XSPI_Ram_Ctx[Instance].IOMode        != Cfg->IOMode))
+        {
+          /* Reading the configuration of Mode Register 8 ***********************/
+          if (APS256XX_ReadReg(&hxspi_ram[Instance], APS256XX_MR8_ADDRESS, reg,
+                               (uint32_t)APS256XX_READ_REG_LATENCY((uint32_t) \
+                                                                   (XSPI_Ram_Ctx[Instance].ReadLatencyCode))) != APS256XX_OK)
+          {
+            ret = BSP_ERROR_COMPONENT_FAILURE;
+          }
+          else
+          {
+            /* Configure the 16-bits Octal RAM memory ***************************/
+            MODIFY_REG(reg[0], (uint8_t)APS256XX_MR8_X8_X16, (uint8_t)(Cfg->IOMode));
+
+            if (APS256XX_WriteReg(&hxspi_ram[Instance], APS256XX_MR8_ADDRESS, reg[0]) != APS256XX_OK)
+            {
+              ret = BSP_ERROR_COMPONENT_FAILURE;
+            }
+          }
+        }
+      }
+
+      /* Update XSPI context if all operations are well done */
+      if (ret == BSP_ERROR_NONE)
+      {
+        /* Update current status parameter *****************************************/
+        XSPI_Ram_Ctx[Instance].IsInitialized    = XSPI_ACCESS_INDIRECT;
+        XSPI_Ram_Ctx[Instance].LatencyType      = Cfg->LatencyType;
+        XSPI_Ram_Ctx[Instance].ReadLatencyCode  = Cfg->ReadLatencyCode;
+        XSPI_Ram_Ctx[Instance].WriteLatencyCode = Cfg->WriteLatencyCode;
+        XSPI_Ram_Ctx[Instance].IOMode           = Cfg->IOMode;
+      }
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  Handles XSPI 16-bits Octal RAM DMA transfer interrupt request.
+  * @param  Instance XSPI instance
+  * @retval None
+  */
+void BSP_XSPI_RAM_DMA_RX_IRQHandler(uint32_t Instance)
+{
+  HAL_DMA_IRQHandler(hxspi_ram[Instance].hdmarx);
+}
+
+/**
+  * @brief  Handles XSPI 16-bits Octal RAM DMA transfer interrupt request.
+  * @param  Instance XSPI instance
+  * @retval None
+  */
+void BSP_XSPI_RAM_DMA_TX_IRQHandler(uint32_t Instance)
+{
+  HAL_DMA_IRQHandler(hxspi_ram[Instance].hdmatx);
+}
+
+/**
+  * @brief  Handles XSPI 16-bits Octal RAM interrupt request.
+  * @param  Instance XSPI instance
+  * @retval None
+  */
+void BSP_XSPI_RAM_IRQHandler(uint32_t Instance)
+{
+  HAL_XSPI_IRQHandler(&hxspi_ram[Instance]);
+}
+/**
+  * @}
+  */
+#endif /* USE_RAM_MEMORY_APS256XX */
+
+#if (USE_NOR_MEMORY_MX66UW1G45G == 1)
+/** @addtogroup STM32H7S78_DK_XSPI_NOR_Private_Functions
+  * @{
+  */
+
+/**
+  * @brief  Initializes the XSPI MSP.
+  * @param  hxspi XSPI handle
+  * @retval None
+  */
+static void XSPI_NOR_MspInit(XSPI_HandleTypeDef *hxspi)
+{
+#if (USE_BSP_XSPI_NOR_DMA == 1)
+  static DMA_HandleTypeDef hdmatx, hdmarx;
+#endif /* USE_BSP_XSPI_NOR_DMA */
+  GPIO_InitTypeDef GPIO_InitStruct;
+
+  /* hxspi unused argument(s) compilation warning */
+  UNUSED(hxspi);
+
+  /* Enable the SBS Clock */
+  __HAL_RCC_SBS_CLK_ENABLE();
+
+  /* Enable the power of XSPI */
+  XSPI_NOR_PWR_ENABLE();
+
+  /* Enable the XSPI memory interface clock */
+  XSPI_NOR_CLK_ENABLE();
+#if (USE_BSP_XSPI_NOR_DMA == 1)
+  XSPI_NOR_DMAx_CLK_ENABLE();
+#endif /* USE_BSP_XSPI_NOR_DMA */
+
+  /* Reset the XSPI memory interface */
+  XSPI_NOR_FORCE_RESET();
+  XSPI_NOR_RELEASE_RESET();
+
+  /* Enable GPIO clocks */
+  XSPI_NOR_CLK_GPIO_CLK_ENABLE();
+  XSPI_NOR_DQS_GPIO_CLK_ENABLE();
+  XSPI_NOR_CS_GPIO_CLK_ENABLE();
+  XSPI_NOR_D0_GPIO_CLK_ENABLE();
+  XSPI_NOR_D1_GPIO_CLK_ENABLE();
+  XSPI_NOR_D2_GPIO_CLK_ENABLE();
+  XSPI_NOR_D3_GPIO_CLK_ENABLE();
+  XSPI_NOR_D4_GPIO_CLK_ENABLE();
+  XSPI_NOR_D5_GPIO_CLK_ENABLE();
+  XSPI_NOR_D6_GPIO_CLK_ENABLE();
+  XSPI_NOR_D7_GPIO_CLK_ENABLE();
+
+  /* SBS: Enable HSLV on XSPI2 */
+  HAL_SBS_EnableIOSpeedOptimize(SBS_IO_XSPI2_HSLV);
+
+  /* XSPI CS GPIO pin configuration  */
+  GPIO_InitStruct.Pin       = XSPI_NOR_CS_PIN;
+  GPIO_InitStruct.Mode      = GPIO_MODE_AF_PP;
+  GPIO_InitStruct.Pull      = GPIO_PULLUP;
+  GPIO_InitStruct.Speed     = GPIO_SPEED_FREQ_VERY_HIGH;
+  GPIO_InitStruct.Alternate = XSPI_NOR_CS_PIN_AF;
+  HAL_GPIO_Init(XSPI_NOR_CS_GPIO_PORT, &GPIO_InitStruct);
+
+  /* XSPI DQS GPIO pin configuration  */
+  GPIO_InitStruct.Pin       = XSPI_NOR_DQS_PIN;
+  GPIO_InitStruct.Alternate = XSPI_NOR_DQS_PIN_AF;
+  HAL_GPIO_Init(XSPI_NOR_DQS_GPIO_PORT, &GPIO_InitStruct);
+
+  /* XSPI CLK GPIO pin configuration  */
+  GPIO_InitStruct.Pin       = XSPI_NOR_CLK_PIN;
+  GPIO_InitStruct.Pull      = GPIO_NOPULL;
+  GPIO_InitStruct.Alternate = XSPI_NOR_CLK_PIN_AF;
+  HAL_GPIO_Init(XSPI_NOR_CLK_GPIO_PORT, &GPIO_InitStruct);
+
+  /* XSPI D0 GPIO pin configuration  */
+  GPIO_InitStruct.Pin       = XSPI_NOR_D0_PIN;
+  GPIO_InitStruct.Alternate = XSPI_NOR_D0_PIN_AF;
+  HAL_GPIO_Init(XSPI_NOR_D0_GPIO_PORT, &GPIO_InitStruct);
+
+  /* XSPI D1 GPIO pin configuration  */
+  GPIO_InitStruct.Pin       = XSPI_NOR_D1_PIN;
+  GPIO_InitStruct.Alternate = XSPI_NOR_D1_PIN_AF;
+  HAL_GPIO_Init(XSPI_NOR_D1_GPIO_PORT, &GPIO_InitStruct);
+
+  /* XSPI D2 GPIO pin configuration  */
+  GPIO_InitStruct.Pin       = XSPI_NOR_D2_PIN;
+  GPIO_InitStruct.Alternate = XSPI_NOR_D2_PIN_AF;
+  HAL_GPIO_Init(XSPI_NOR_D2_GPIO_PORT, &GPIO_InitStruct);
+
+  /* XSPI D3 GPIO pin configuration  */
+  GPIO_InitStruct.Pin       = XSPI_NOR_D3_PIN;
+  GPIO_InitStruct.Alternate = XSPI_NOR_D3_PIN_AF;
+  HAL_GPIO_Init(XSPI_NOR_D3_GPIO_PORT, &GPIO_InitStruct);
+
+  /* XSPI D4 GPIO pin configuration  */
+  GPIO_InitStruct.Pin       = XSPI_NOR_D4_PIN;
+  GPIO_InitStruct.Alternate = XSPI_NOR_D4_PIN_AF;
+  HAL_GPIO_Init(XSPI_NOR_D4_GPIO_PORT, &GPIO_InitStruct);
+
+  /* XSPI D5 GPIO pin configuration  */
+  GPIO_InitStruct.Pin       = XSPI_NOR_D5_PIN;
+  GPIO_InitStruct.Alternate = XSPI_NOR_D5_PIN_AF;
+  HAL_GPIO_Init(XSPI_NOR_D5_GPIO_PORT, &GPIO_InitStruct);
+
+  /* XSPI D6 GPIO pin configuration  */
+  GPIO_InitStruct.Pin       = XSPI_NOR_D6_PIN;
+  GPIO_InitStruct.Alternate = XSPI_NOR_D6_PIN_AF;
+  HAL_GPIO_Init(XSPI_NOR_D6_GPIO_PORT, &GPIO_InitStruct);
+
+  /* XSPI D7 GPIO pin configuration  */
+  GPIO_InitStruct.Pin       = XSPI_NOR_D7_PIN;
+  GPIO_InitStruct.Alternate = XSPI_NOR_D7_PIN_AF;
+  HAL_GPIO_Init(XSPI_NOR_D7_GPIO_PORT, &GPIO_InitStruct);
+
+#if (USE_BSP_XSPI_NOR_DMA == 1)
+  hdmatx.Init.Request = XSPI_NOR_DMAx_Request;
+  hdmatx.Instance = XSPI_NOR_DMAx_TX_CHANNEL;
+
+  /* Configure the XSPI DMA transmit */
+  hdmatx.Init.Direction             = DMA_MEMORY_TO_PERIPH;
+  hdmatx.Init.SrcInc                = DMA_SINC_INCREMENTED;
+  hdmatx.Init.DestInc               = DMA_DINC_FIXED;
+  hdmatx.Init.Priority              = DMA_HIGH_PRIORITY;
+  hdmatx.Init.SrcBurstLength        = 4;
+  hdmatx.Init.DestBurstLength       = 4;
+  hdmatx.Init.TransferEventMode     = DMA_TCEM_BLOCK_TRANSFER;
+  hdmatx.Init.SrcDataWidth          = DMA_SRC_DATAWIDTH_WORD;
+  hdmatx.Init.DestDataWidth         = DMA_DEST_DATAWIDTH_WORD;
+  hdmatx.Init.TransferAllocatedPort = (DMA_SRC_ALLOCATED_PORT0 | DMA_DEST_ALLOCATED_PORT1);
+  __HAL_LINKDMA(hxspi, hdmatx, hdmatx);
+
+  /* Initialize the DMA channel */
+  (void)HAL_DMA_Init(&hdmatx);
+
+  hdmarx.Init.Request = XSPI_NOR_DMAx_Request;
+  hdmarx.Instance = XSPI_NOR_DMAx_RX_CHANNEL;
+
+  /* Configure the XSPI DMA receive */
+  hdmarx.Init.Direction             = DMA_PERIPH_TO_MEMORY;
+  hdmarx.Init.SrcInc                = DMA_SINC_FIXED;
+  hdmarx.Init.DestInc               = DMA_DINC_INCREMENTED;
+  hdmarx.Init.Priority              = DMA_HIGH_PRIORITY;
+  hdmarx.Init.SrcBurstLength        = 4;
+  hdmarx.Init.DestBurstLength       = 4;
+  hdmarx.Init.TransferEventMode     = DMA_TCEM_BLOCK_TRANSFER;
+  hdmarx.Init.SrcDataWidth          = DMA_SRC_DATAWIDTH_WORD;
+  hdmarx.Init.DestDataWidth         = DMA_DEST_DATAWIDTH_WORD;
+  hdmarx.Init.TransferAllocatedPort = (DMA_SRC_ALLOCATED_PORT1 | DMA_DEST_ALLOCATED_PORT0);
+  __HAL_LINKDMA(hxspi, hdmarx, hdmarx);
+
+  /* Initialize the DMA channel */
+  (void)HAL_DMA_Init(&hdmarx);
+
+  /* Enable and set priority of the DMA interrupts */
+  HAL_NVIC_SetPriority(XSPI_NOR_DMAx_RX_IRQn, BSP_XSPI_NOR_DMA_IT_PRIORITY, 0);
+  HAL_NVIC_SetPriority(XSPI_NOR_DMAx_TX_IRQn, BSP_XSPI_NOR_DMA_IT_PRIORITY, 0);
+  HAL_NVIC_EnableIRQ(XSPI_NOR_DMAx_RX_IRQn);
+  HAL_NVIC_EnableIRQ(XSPI_NOR_DMAx_TX_IRQn);
+#endif /* USE_BSP_XSPI_NOR_DMA */
+
+  /* Enable and set priority of the XSPI interrupt, used by the interrupt driven operations */
+  HAL_NVIC_SetPriority(XSPI2_IRQn, BSP_XSPI_NOR_IT_PRIORITY, 0);
+  HAL_NVIC_EnableIRQ(XSPI2_IRQn);
+}
+
+/**
+  * @brief  De-Initializes the XSPI MSP.
+  * @param  hxspi XSPI handle
+  * @retval None
+  */
+static void XSPI_NOR_MspDeInit(XSPI_HandleTypeDef *hxspi)
+{
+  /* hxspi unused argument(s) compilation warning */
+  UNUSED(hxspi);
+
+  /* Disable the XSPI interrupt */
+  HAL_NVIC_DisableIRQ(XSPI2_IRQn);
+
+#if (USE_BSP_XSPI_NOR_DMA == 1)
+  /* XSPI DMA channels de-configuration */
+  HAL_NVIC_DisableIRQ(XSPI_NOR_DMAx_RX_IRQn);
+  HAL_NVIC_DisableIRQ(XSPI_NOR_DMAx_TX_IRQn);
+  (void)HAL_DMA_DeInit(hxspi->hdmarx);
+  (void)HAL_DMA_DeInit(hxspi->hdmatx);
+#endif /* USE_BSP_XSPI_NOR_DMA */
+
+  /* XSPI GPIO pins de-configuration  */
+  HAL_GPIO_DeInit(XSPI_NOR_CLK_GPIO_PORT, XSPI_NOR_CLK_PIN);
+  HAL_GPIO_DeInit(XSPI_NOR_DQS_GPIO_PORT, XSPI_NOR_DQS_PIN);
+  HAL_GPIO_DeInit(XSPI_NOR_CS_GPIO_PORT, XSPI_NOR_CS_PIN);
+  HAL_GPIO_DeInit(XSPI_NOR_D0_GPIO_PORT, XSPI_NOR_D0_PIN);
+  HAL_GPIO_DeInit(XSPI_NOR_D1_GPIO_PORT, XSPI_NOR_D1_PIN);
+  HAL_GPIO_DeInit(XSPI_NOR_D2_GPIO_PORT, XSPI_NOR_D2_PIN);
+  HAL_GPIO_DeInit(XSPI_NOR_D3_GPIO_PORT, XSPI_NOR_D3_PIN);
+  HAL_GPIO_DeInit(XSPI_NOR_D4_GPIO_PORT, XSPI_NOR_D4_PIN);
+  HAL_GPIO_DeInit(XSPI_NOR_D5_GPIO_PORT, XSPI_NOR_D5_PIN);
+  HAL_GPIO_DeInit(XSPI_NOR_D6_GPIO_PORT, XSPI_NOR_D6_PIN);
+  HAL_GPIO_DeInit(XSPI_NOR_D7_GPIO_PORT, XSPI_NOR_D7_PIN);
+
+  /* Reset the XSPI memory interface */
+  XSPI_NOR_FORCE_RESET();
+  XSPI_NOR_RELEASE_RESET();
+
+  /* Disable the XSPI memory interface clock */
+  XSPI_NOR_CLK_DISABLE();
+}
+
+/**
+  * @brief  Enables the write operations and issues a page program command.
+  * @param  Instance  XSPI instance
+  * @param  pData     Pointer to the page data
+  * @param  Address   Page program address
+  * @param  Size      Size of data, up to the end of the page
+  * @retval BSP status
+  */
+static int32_t XSPI_NOR_ProgramPage(uint32_t Instance, const uint8_t *pData, uint32_t Address, uint32_t Size)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  XSPI_NOR_CACHE_INVALIDATE(Instance, Address, Size);
+
+  /* Enable write operations */
+  if (MX66UW1G45G_WriteEnable(&hxspi_nor[Instance], XSPI_Nor_Ctx[Instance].InterfaceMode,
+                              XSPI_Nor_Ctx[Instance].TransferRate) != MX66UW1G45G_OK)
+  {
+    ret = BSP_ERROR_COMPONENT_FAILURE;
+  }
+  else if (XSPI_Nor_Ctx[Instance].TransferRate == BSP_XSPI_NOR_STR_TRANSFER)
+  {
+    /* Issue page program command */
+    if (MX66UW1G45G_PageProgram(&hxspi_nor[Instance], XSPI_Nor_Ctx[Instance].InterfaceMode,
+                                MX66UW1G45G_4BYTES_SIZE, (uint8_t *)pData, Address, Size) != MX66UW1G45G_OK)
+    {
+      ret = BSP_ERROR_COMPONENT_FAILURE;
+    }
+  }
+  else
+  {
+    /* Issue page program command */
+    if (MX66UW1G45G_PageProgramDTR(&hxspi_nor[Instance], (uint8_t *)pData, Address, Size) != MX66UW1G45G_OK)
+    {
+      ret = BSP_ERROR_COMPONENT_FAILURE;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Starts the automatic polling of the status register, the status match
+  *         interrupt is raised when the masked bits match.
+  * @param  Instance    XSPI instance
+  * @param  MatchValue  Expected value of the masked status bits
+  * @param  MatchMask   Polled status bits, MX66UW1G45G_SR_WIP or MX66UW1G45G_SR_WEL
+  * @retval BSP status
+  */
+static int32_t XSPI_NOR_AutoPolling_IT(uint32_t Instance, uint32_t MatchValue, uint32_t MatchMask)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  XSPI_RegularCmdTypeDef  s_command = {0};
+  XSPI_AutoPollingTypeDef s_config = {0};
+  BSP_XSPI_NOR_Interface_t mode = XSPI_Nor_Ctx[Instance].InterfaceMode;
+  BSP_XSPI_NOR_Transfer_t rate = XSPI_Nor_Ctx[Instance].TransferRate;
+
+  /* Same read status register command as MX66UW1G45G_AutoPollingMemReady() */
+  s_command.OperationType      = HAL_XSPI_OPTYPE_COMMON_CFG;
+  s_command.IOSelect           = HAL_XSPI_SELECT_IO_7_0;
+  s_command.InstructionMode    = (mode == BSP_XSPI_NOR_SPI_MODE) ? HAL_XSPI_INSTRUCTION_1_LINE : HAL_XSPI_INSTRUCTION_8_LINES;
+  s_command.InstructionDTRMode = (rate == BSP_XSPI_NOR_DTR_TRANSFER) ? HAL_XSPI_INSTRUCTION_DTR_ENABLE
+                                 : HAL_XSPI_INSTRUCTION_DTR_DISABLE;
+  s_command.InstructionWidth   = (mode == BSP_XSPI_NOR_SPI_MODE) ? HAL_XSPI_INSTRUCTION_8_BITS : HAL_XSPI_INSTRUCTION_16_BITS;
+  s_command.Instruction        = (mode == BSP_XSPI_NOR_SPI_MODE) ? MX66UW1G45G_READ_STATUS_REG_CMD
+                                 : MX66UW1G45G_OCTA_READ_STATUS_REG_CMD;
+  s_command.AddressMode        = (mode == BSP_XSPI_NOR_SPI_MODE) ? HAL_XSPI_ADDRESS_NONE : HAL_XSPI_ADDRESS_8_LINES;
+  s_command.AddressDTRMode     = (rate == BSP_XSPI_NOR_DTR_TRANSFER) ? HAL_XSPI_ADDRESS_DTR_ENABLE
+                                 : HAL_XSPI_ADDRESS_DTR_DISABLE;
+  s_command.AddressWidth       = HAL_XSPI_ADDRESS_32_BITS;
+  s_command.Address            = 0U;
+  s_command.AlternateBytesMode = HAL_XSPI_ALT_BYTES_NONE;
+  s_command.DataMode           = (mode == BSP_XSPI_NOR_SPI_MODE) ? HAL_XSPI_DATA_1_LINE : HAL_XSPI_DATA_8_LINES;
+  s_command.DataDTRMode        = (rate == BSP_XSPI_NOR_DTR_TRANSFER) ? HAL_XSPI_DATA_DTR_ENABLE : HAL_XSPI_DATA_DTR_DISABLE;
+  s_command.DummyCycles        = (mode == BSP_XSPI_NOR_SPI_MODE) ? 0U
+                                 : ((rate == BSP_XSPI_NOR_DTR_TRANSFER) ? DUMMY_CYCLES_REG_OCTAL_DTR
+                                    : DUMMY_CYCLES_REG_OCTAL);
+  s_command.DataLength         = (rate == BSP_XSPI_NOR_DTR_TRANSFER) ? 2U : 1U;
+  s_command.DQSMode            = (rate == BSP_XSPI_NOR_DTR_TRANSFER) ? HAL_XSPI_DQS_ENABLE : HAL_XSPI_DQS_DISABLE;
+
+  s_config.MatchValue          = MatchValue;
+  s_config.MatchMask           = MatchMask;
+  s_config.MatchMode           = HAL_XSPI_MATCH_MODE_AND;
+  s_config.IntervalTime        = MX66UW1G45G_AUTOPOLLING_INTERVAL_TIME;
+  s_config.AutomaticStop       = HAL_XSPI_AUTOMATIC_STOP_ENABLE;
+
+  if (HAL_XSPI_Command(&hxspi_nor[Instance], &s_command, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+  {
+    ret = BSP_ERROR_PERIPH_FAILURE;
+  }
+  else if (HAL_XSPI_AutoPolling_IT(&hxspi_nor[Instance], &s_config) != HAL_OK)
+  {
+    ret = BSP_ERROR_PERIPH_FAILURE;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Builds the read or page program command of a transfer.
+  * @param  Instance  XSPI instance
+  * @param  pCommand  Command to fill
+  * @param  Address   Memory address
+  * @param  Size      Size of data, up to the end of the page for a program
+  * @param  Write     1 for a page program, 0 for a read
+  * @retval None
+  */
+static void XSPI_NOR_SetTransferCommand(uint32_t Instance, XSPI_RegularCmdTypeDef *pCommand, uint32_t Address,
+                                        uint32_t Size, uint32_t Write)
+{
+  BSP_XSPI_NOR_Interface_t mode = XSPI_Nor_Ctx[Instance].InterfaceMode;
+  BSP_XSPI_NOR_Transfer_t rate = XSPI_Nor_Ctx[Instance].TransferRate;
+
+  /* Same commands as MX66UW1G45G_ReadSTR/DTR() and MX66UW1G45G_PageProgram/DTR() */
+  pCommand->OperationType      = HAL_XSPI_OPTYPE_COMMON_CFG;
+  pCommand->IOSelect           = HAL_XSPI_SELECT_IO_7_0;
+  pCommand->InstructionMode    = (mode == BSP_XSPI_NOR_SPI_MODE) ? HAL_XSPI_INSTRUCTION_1_LINE : HAL_XSPI_INSTRUCTION_8_LINES;
+  pCommand->InstructionDTRMode = (rate == BSP_XSPI_NOR_DTR_TRANSFER) ? HAL_XSPI_INSTRUCTION_DTR_ENABLE
+                                 : HAL_XSPI_INSTRUCTION_DTR_DISABLE;
+  pCommand->InstructionWidth   = (mode == BSP_XSPI_NOR_SPI_MODE) ? HAL_XSPI_INSTRUCTION_8_BITS : HAL_XSPI_INSTRUCTION_16_BITS;
+  pCommand->AddressMode        = (mode == BSP_XSPI_NOR_SPI_MODE) ? HAL_XSPI_ADDRESS_1_LINE : HAL_XSPI_ADDRESS_8_LINES;
+  pCommand->AddressDTRMode     = (rate == BSP_XSPI_NOR_DTR_TRANSFER) ? HAL_XSPI_ADDRESS_DTR_ENABLE
+                                 : HAL_XSPI_ADDRESS_DTR_DISABLE;
+  pCommand->AddressWidth       = HAL_XSPI_ADDRESS_32_BITS;
+  pCommand->Address            = Address;
+  pCommand->AlternateBytesMode = HAL_XSPI_ALT_BYTES_NONE;
+  pCommand->DataMode           = (mode == BSP_XSPI_NOR_SPI_MODE) ? HAL_XSPI_DATA_1_LINE : HAL_XSPI_DATA_8_LINES;
+  pCommand->DataDTRMode        = (rate == BSP_XSPI_NOR_DTR_TRANSFER) ? HAL_XSPI_DATA_DTR_ENABLE : HAL_XSPI_DATA_DTR_DISABLE;
+  pCommand->DataLength         = Size;
+
+  if (Write == 1U)
+  {
+    pCommand->Instruction      = (mode == BSP_XSPI_NOR_SPI_MODE) ? MX66UW1G45G_4_BYTE_PAGE_PROG_CMD
+                                 : MX66UW1G45G_OCTA_PAGE_PROG_CMD;
+    pCommand->DummyCycles      = 0U;
+    pCommand->DQSMode          = HAL_XSPI_DQS_DISABLE;
+  }
+  else
+  {
+    pCommand->Instruction      = (mode == BSP_XSPI_NOR_SPI_MODE) ? MX66UW1G45G_4_BYTE_ADDR_FAST_READ_CMD
+                                 : ((rate == BSP_XSPI_NOR_DTR_TRANSFER) ? MX66UW1G45G_OCTA_READ_DTR_CMD
+                                    : MX66UW1G45G_OCTA_READ_CMD);
+    pCommand->DummyCycles      = (mode == BSP_XSPI_NOR_SPI_MODE) ? DUMMY_CYCLES_READ
+                                 : ((rate == BSP_XSPI_NOR_DTR_TRANSFER) ? DUMMY_CYCLES_READ_OCTAL_DTR
+                                    : DUMMY_CYCLES_READ_OCTAL);
+    pCommand->DQSMode          = (rate == BSP_XSPI_NOR_DTR_TRANSFER) ? HAL_XSPI_DQS_ENABLE : HAL_XSPI_DQS_DISABLE;
+  }
+}
+
+/**
+  * @brief  Starts the current step of the interrupt driven page program, the next
+  *         step is started from the interrupt ending this one.
+  * @param  Instance  XSPI instance
+  * @retval BSP status
+  */
+static int32_t XSPI_NOR_ProgramStep_IT(uint32_t Instance)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  XSPI_NOR_ItCtx_t *ctx = &XSPINor_ItCtx[Instance];
+  XSPI_RegularCmdTypeDef s_command = {0};
+  BSP_XSPI_NOR_Interface_t mode = XSPI_Nor_Ctx[Instance].InterfaceMode;
+  BSP_XSPI_NOR_Transfer_t rate = XSPI_Nor_Ctx[Instance].TransferRate;
+
+  if (ctx->Step == XSPI_NOR_STEP_WRITE_ENABLE)
+  {
+    /* Same write enable command as MX66UW1G45G_WriteEnable() */
+    s_command.OperationType      = HAL_XSPI_OPTYPE_COMMON_CFG;
+    s_command.IOSelect           = HAL_XSPI_SELECT_IO_7_0;
+    s_command.InstructionMode    = (mode == BSP_XSPI_NOR_SPI_MODE) ? HAL_XSPI_INSTRUCTION_1_LINE
+                                   : HAL_XSPI_INSTRUCTION_8_LINES;
+    s_command.InstructionDTRMode = (rate == BSP_XSPI_NOR_DTR_TRANSFER) ? HAL_XSPI_INSTRUCTION_DTR_ENABLE
+                                   : HAL_XSPI_INSTRUCTION_DTR_DISABLE;
+    s_command.InstructionWidth   = (mode == BSP_XSPI_NOR_SPI_MODE) ? HAL_XSPI_INSTRUCTION_8_BITS
+                                   : HAL_XSPI_INSTRUCTION_16_BITS;
+    s_command.Instruction        = (mode == BSP_XSPI_NOR_SPI_MODE) ? MX66UW1G45G_WRITE_ENABLE_CMD
+                                   : MX66UW1G45G_OCTA_WRITE_ENABLE_CMD;
+    s_command.AddressMode        = HAL_XSPI_ADDRESS_NONE;
+    s_command.AlternateBytesMode = HAL_XSPI_ALT_BYTES_NONE;
+    s_command.DataMode           = HAL_XSPI_DATA_NONE;
+    s_command.DummyCycles        = 0U;
+    s_command.DQSMode            = HAL_XSPI_DQS_DISABLE;
+
+    /* Ended by the command complete interrupt */
+    if (HAL_XSPI_Command_IT(&hxspi_nor[Instance], &s_command) != HAL_OK)
+    {
+      ret = BSP_ERROR_PERIPH_FAILURE;
+    }
+  }
+  else if (ctx->Step == XSPI_NOR_STEP_WEL)
+  {
+    /* Ended by the status match interrupt once the write enable latch is set */
+    ret = XSPI_NOR_AutoPolling_IT(Instance, MX66UW1G45G_SR_WEL, MX66UW1G45G_SR_WEL);
+  }
+  else if (ctx->Step == XSPI_NOR_STEP_DATA)
+  {
+    /* Ended by the transfer complete interrupt */
+    XSPI_NOR_CACHE_INVALIDATE(Instance, ctx->Address, ctx->Size);
+#if (USE_BSP_XSPI_NOR_DMA == 1)
+    if (ctx->State == XSPI_NOR_IT_PROGRAM_DMA)
+    {
+      ret = XSPI_NOR_Transfer_DMA(Instance, (uint8_t *)ctx->DataAddress, ctx->Address, ctx->Size, 1U);
+    }
+    else
+#endif /* USE_BSP_XSPI_NOR_DMA */
+    {
+      XSPI_NOR_SetTransferCommand(Instance, &s_command, ctx->Address, ctx->Size, 1U);
+
+      if (HAL_XSPI_Command(&hxspi_nor[Instance], &s_command, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+      {
+        ret = BSP_ERROR_PERIPH_FAILURE;
+      }
+      else if (HAL_XSPI_Transmit_IT(&hxspi_nor[Instance], (uint8_t *)ctx->DataAddress) != HAL_OK)
+      {
+        ret = BSP_ERROR_PERIPH_FAILURE;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+    }
+  }
+  else
+  {
+    /* Ended by the status match interrupt once the memory is ready */
+    ret = XSPI_NOR_AutoPolling_IT(Instance, 0U, MX66UW1G45G_SR_WIP);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Clears the interrupt driven operation context of an instance.
+  * @param  Instance  XSPI instance
+  * @retval None
+  */
+static void XSPI_NOR_ResetItCtx(uint32_t Instance)
+{
+  XSPI_NOR_ItCtx_t *ctx = &XSPINor_ItCtx[Instance];
+
+  ctx->State       = XSPI_NOR_IT_IDLE;
+  ctx->Step        = XSPI_NOR_STEP_WRITE_ENABLE;
+  ctx->Address     = 0U;
+  ctx->Size        = 0U;
+  ctx->EndAddress  = 0U;
+  ctx->DataAddress = 0U;
+  ctx->Suspends    = 0U;
+  ctx->ResumeTick  = 0U;
+  ctx->pItems      = NULL;
+  ctx->NbItems     = 0U;
+  ctx->Item        = 0U;
+}
+
+/**
+  * @brief  Finds the 4KB sectors reading back as all 0xFF.
+  * @param  Instance   XSPI instance
+  * @param  Address    Address of the first sector
+  * @param  NbSectors  Number of sectors to check, up to 32
+  * @param  pBlank     Bit n set when the sector n is blank
+  * @retval BSP status
+  */
+static int32_t XSPI_NOR_GetBlankSectors(uint32_t Instance, uint32_t Address, uint32_t NbSectors, uint32_t *pBlank)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  uint32_t sector;
+  uint32_t offset;
+  uint32_t i;
+  uint32_t page[MX66UW1G45G_PAGE_SIZE / 4U];
+
+  *pBlank = 0U;
+
+  /* The previous erase must be completed before reading */
+  if (MX66UW1G45G_AutoPollingMemReady(&hxspi_nor[Instance], XSPI_Nor_Ctx[Instance].InterfaceMode,
+                                      XSPI_Nor_Ctx[Instance].TransferRate) != MX66UW1G45G_OK)
+  {
+    ret = BSP_ERROR_COMPONENT_FAILURE;
+  }
+
+  for (sector = 0U; (sector < NbSectors) && (ret == BSP_ERROR_NONE); sector++)
+  {
+    *pBlank |= (1UL << sector);
+
+    /* Read the sector page by page, stop at the first programmed word */
+    for (offset = 0U; (offset < MX66UW1G45G_SUBSECTOR_4K) && ((*pBlank & (1UL << sector)) != 0U) &&
+         (ret == BSP_ERROR_NONE); offset += MX66UW1G45G_PAGE_SIZE)
+    {
+      ret = BSP_XSPI_NOR_Read(Instance, (uint8_t *)page,
+                              Address + (sector * MX66UW1G45G_SUBSECTOR_4K) + offset, MX66UW1G45G_PAGE_SIZE);
+
+      for (i = 0U; (i < (MX66UW1G45G_PAGE_SIZE / 4U)) && (ret == BSP_ERROR_NONE); i++)
+      {
+        if (page[i] != 0xFFFFFFFFU)
+        {
+          *pBlank &= ~(1UL << sector);
+          break;
+        }
+      }
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Waits until the memory is ready.
+  * @param  Instance  XSPI instance
+  * @retval BSP status
+  */
+static int32_t XSPI_NOR_WaitMemReady(uint32_t Instance)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  if (MX66UW1G45G_AutoPollingMemReady(&hxspi_nor[Instance], XSPI_Nor_Ctx[Instance].InterfaceMode,
+                                      XSPI_Nor_Ctx[Instance].TransferRate) != MX66UW1G45G_OK)
+  {
+    ret = BSP_ERROR_COMPONENT_FAILURE;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Waits for the end of an erase, within the maximum erase time of the block.
+  * @param  Instance   XSPI instance
+  * @param  BlockSize  Size of the erased block in bytes
+  * @retval BSP status, BSP_ERROR_BUSY when the erase does not end in time
+  */
+static int32_t XSPI_NOR_WaitEraseEnd(uint32_t Instance, uint32_t BlockSize)
+{
+  int32_t ret;
+  uint32_t timeout = (BlockSize == MX66UW1G45G_SUBSECTOR_4K) ? XSPI_NOR_ERASE_4K_MAX_TIME
+                     : ((BlockSize == MX66UW1G45G_SECTOR_64K) ? XSPI_NOR_ERASE_64K_MAX_TIME
+                        : XSPI_NOR_ERASE_CHIP_MAX_TIME);
+  uint32_t tickstart = HAL_GetTick();
+
+  do
+  {
+    ret = BSP_XSPI_NOR_GetStatus(Instance);
+  } while ((ret == BSP_ERROR_BUSY) && ((HAL_GetTick() - tickstart) <= timeout));
+
+  return ret;
+}
+
+/**
+  * @brief  Pauses the interrupt driven erase to serve a read. The erase is suspended
+  *         once BSP_XSPI_NOR_ERASE_RESUME_TIME has elapsed since its last resume,
+  *         unless the read targets the erased block or the erase was already suspended
+  *         BSP_XSPI_NOR_ERASE_SUSPEND_MAX times: the end of the erase is then awaited.
+  *         An erase which fails or does not end in time is reported by
+  *         BSP_XSPI_NOR_ErrorCallback().
+  * @param  Instance  XSPI instance
+  * @param  ReadAddr  Read start address
+  * @param  Size      Size of data to read
+  * @retval BSP status
+  */
+static int32_t XSPI_NOR_SuspendEraseForRead(uint32_t Instance, uint32_t ReadAddr, uint32_t Size)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  XSPI_NOR_ItCtx_t *ctx = &XSPINor_ItCtx[Instance];
+  HAL_StatusTypeDef status = HAL_OK;
+
+  /* Stop the status polling, the status match interrupt must not complete the erase meanwhile */
+  HAL_NVIC_DisableIRQ(XSPI2_IRQn);
+  if (ctx->State == XSPI_NOR_IT_ERASE)
+  {
+    ctx->State = XSPI_NOR_IT_SUSPEND;
+    status = HAL_XSPI_Abort(&hxspi_nor[Instance]);
+  }
+  HAL_NVIC_EnableIRQ(XSPI2_IRQn);
+
+  if (ctx->State != XSPI_NOR_IT_SUSPEND)
+  {
+    /* Nothing to do, the erase completed before the polling was stopped */
+  }
+  else if (status != HAL_OK)
+  {
+    ctx->State = XSPI_NOR_IT_IDLE;
+    ret = BSP_ERROR_PERIPH_FAILURE;
+    BSP_XSPI_NOR_ErrorCallback(Instance);
+  }
+  else if ((((ReadAddr + Size) > ctx->Address) && (ReadAddr < (ctx->Address + ctx->Size))) ||
+           (ctx->Suspends >= BSP_XSPI_NOR_ERASE_SUSPEND_MAX))
+  {
+    /* The erased block can not be read, or the erase was suspended too often: wait for its end */
+    ret = XSPI_NOR_WaitEraseEnd(Instance, ctx->Size);
+    ctx->State = XSPI_NOR_IT_IDLE;
+    XSPINor_SuspendStats[Instance].DeferredReads++;
+    if (ret == BSP_ERROR_NONE)
+    {
+      BSP_XSPI_NOR_EraseCpltCallback(Instance);
+    }
+    else
+    {
+      BSP_XSPI_NOR_ErrorCallback(Instance);
+    }
+  }
+  else
+  {
+    /* Let the erase progress for the minimum time since its last resume */
+    while ((HAL_GetTick() - ctx->ResumeTick) <= XSPI_NOR_ERASE_RESUME_TICKS)
+    {
+      /* Nothing to do */
+    }
+
+    ret = BSP_XSPI_NOR_GetStatus(Instance);
+    if (ret != BSP_ERROR_BUSY)
+    {
+      /* The erase is over */
+      ctx->State = XSPI_NOR_IT_IDLE;
+      if (ret == BSP_ERROR_NONE)
+      {
+        BSP_XSPI_NOR_EraseCpltCallback(Instance);
+      }
+      else
+      {
+        BSP_XSPI_NOR_ErrorCallback(Instance);
+      }
+    }
+    else if (MX66UW1G45G_Suspend(&hxspi_nor[Instance], XSPI_Nor_Ctx[Instance].InterfaceMode,
+                                 XSPI_Nor_Ctx[Instance].TransferRate) != MX66UW1G45G_OK)
+    {
+      ctx->State = XSPI_NOR_IT_IDLE;
+      ret = BSP_ERROR_COMPONENT_FAILURE;
+      BSP_XSPI_NOR_ErrorCallback(Instance);
+    }
+    else
+    {
+      /* The memory is ready for the read once the erase is suspended */
+      ret = XSPI_NOR_WaitMemReady(Instance);
+      ctx->Suspends++;
+      XSPINor_SuspendStats[Instance].SuspendedReads++;
+      if (ctx->Suspends > XSPINor_SuspendStats[Instance].MaxEraseSuspends)
+      {
+        XSPINor_SuspendStats[Instance].MaxEraseSuspends = ctx->Suspends;
+      }
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Issues the suspend command of an ongoing erase.
+  * @param  Instance  XSPI instance
+  * @retval BSP status
+  */
+static int32_t XSPI_NOR_SuspendErase(uint32_t Instance)
+{
+  int32_t ret;
+
+  /* Check whether the device is busy (erase operation is in progress). */
+  if (BSP_XSPI_NOR_GetStatus(Instance) != BSP_ERROR_BUSY)
+  {
+    ret = BSP_ERROR_COMPONENT_FAILURE;
+  }
+  else if (MX66UW1G45G_Suspend(&hxspi_nor[Instance], XSPI_Nor_Ctx[Instance].InterfaceMode,
+                               XSPI_Nor_Ctx[Instance].TransferRate) != MX66UW1G45G_OK)
+  {
+    ret = BSP_ERROR_COMPONENT_FAILURE;
+  }
+  else if (BSP_XSPI_NOR_GetStatus(Instance) != BSP_ERROR_XSPI_SUSPENDED)
+  {
+    ret = BSP_ERROR_COMPONENT_FAILURE;
+  }
+  else
+  {
+    ret = BSP_ERROR_NONE;
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  Issues the resume command of a suspended erase.
+  * @param  Instance  XSPI instance
+  * @retval BSP status
+  */
+static int32_t XSPI_NOR_ResumeErase(uint32_t Instance)
+{
+  int32_t ret;
+
+  /* Check whether the device is busy (erase operation is in progress). */
+  if (BSP_XSPI_NOR_GetStatus(Instance) != BSP_ERROR_XSPI_SUSPENDED)
+  {
+    ret = BSP_ERROR_COMPONENT_FAILURE;
+  }
+  else if (MX66UW1G45G_Resume(&hxspi_nor[Instance], XSPI_Nor_Ctx[Instance].InterfaceMode,
+                              XSPI_Nor_Ctx[Instance].TransferRate) != MX66UW1G45G_OK)
+  {
+    ret = BSP_ERROR_COMPONENT_FAILURE;
+  }
+  /*
+  When this command is executed, the status register write in progress bit is set to 1, and
+  the flag status register program erase controller bit is set to 0. This command is ignored
+  if the device is not in a suspended state.
+  */
+  else if (BSP_XSPI_NOR_GetStatus(Instance) != BSP_ERROR_BUSY)
+  {
+    ret = BSP_ERROR_COMPONENT_FAILURE;
   }
   else
   {
-    if (APS256XX_Write(&hxspi_ram[Instance], pData, WriteAddr, Size,
-                       (uint32_t)APS256XX_WRITE_LATENCY((uint32_t)(XSPI_Ram_Ctx[Instance].WriteLatencyCode)),
-                       (uint32_t)(XSPI_Ram_Ctx[Instance].IOMode), 0U) != APS256XX_OK)
-    {
-      ret = BSP_ERROR_PERIPH_FAILURE;
-    }
+    ret = BSP_ERROR_NONE;
   }
 
   /* Return BSP status */
@@ -1507,428 +3447,555 @@ int32_t BSP_XSPI_RAM_Write(uint32_t Instance, uint8_t *pData, uint32_t WriteAddr
 }
 
 /**
-  * @brief  Writes an amount of data to the 16-bits Octal RAM memory in DMA mode.
-  * @param  Instance  XSPI instance
-  * @param  pData     Pointer to data to be written
-  * @param  WriteAddr Write start address
-  * @param  Size      Size of data to write
+  * @brief  Resumes the erase suspended by XSPI_NOR_SuspendEraseForRead() and restarts
+  *         the status polling in interrupt mode.
+  * @param  Instance   XSPI instance
+  * @param  StartTick  Tick of the read start
   * @retval BSP status
   */
-int32_t BSP_XSPI_RAM_Write_DMA(uint32_t Instance, uint8_t *pData, uint32_t WriteAddr, uint32_t Size)
+static int32_t XSPI_NOR_ResumeEraseAfterRead(uint32_t Instance, uint32_t StartTick)
 {
   int32_t ret = BSP_ERROR_NONE;
+  XSPI_NOR_ItCtx_t *ctx = &XSPINor_ItCtx[Instance];
+  uint32_t latency;
 
-  /* Check if the instance is supported */
-  if (Instance >= XSPI_RAM_INSTANCES_NUMBER)
-  {
-    ret = BSP_ERROR_WRONG_PARAM;
-  }
-  else
+  if (ctx->State == XSPI_NOR_IT_SUSPEND)
   {
-    if (APS256XX_Write_DMA(&hxspi_ram[Instance], pData, WriteAddr, Size,
-                           (uint32_t)APS256XX_WRITE_LATENCY((uint32_t)(XSPI_Ram_Ctx[Instance].WriteLatencyCode)),
-                           (uint32_t)(XSPI_Ram_Ctx[Instance].IOMode), 0U) != APS256XX_OK)
+    if (MX66UW1G45G_Resume(&hxspi_nor[Instance], XSPI_Nor_Ctx[Instance].InterfaceMode,
+                           XSPI_Nor_Ctx[Instance].TransferRate) != MX66UW1G45G_OK)
     {
       ret = BSP_ERROR_COMPONENT_FAILURE;
     }
+    else
+    {
+      ctx->ResumeTick = HAL_GetTick();
+      ctx->State      = XSPI_NOR_IT_ERASE;
+      ret = XSPI_NOR_AutoPolling_IT(Instance, 0U, MX66UW1G45G_SR_WIP);
+    }
+
+    if (ret != BSP_ERROR_NONE)
+    {
+      ctx->State = XSPI_NOR_IT_IDLE;
+      BSP_XSPI_NOR_ErrorCallback(Instance);
+    }
+  }
+
+  latency = HAL_GetTick() - StartTick;
+  if (latency > XSPINor_SuspendStats[Instance].MaxReadLatency)
+  {
+    XSPINor_SuspendStats[Instance].MaxReadLatency = latency;
   }
 
-  /* Return BSP status */
   return ret;
 }
 
 /**
-  * @brief  Configure the XSPI in memory-mapped mode
+  * @brief  Reads an amount of data from the memory with a single read command.
   * @param  Instance  XSPI instance
+  * @param  pData     Pointer to data to be read
+  * @param  ReadAddr  Read start address
+  * @param  Size      Size of data to read
   * @retval BSP status
   */
-int32_t BSP_XSPI_RAM_EnableMemoryMappedMode(uint32_t Instance)
+static int32_t XSPI_NOR_ReadMemory(uint32_t Instance, uint8_t *pData, uint32_t ReadAddr, uint32_t Size)
 {
   int32_t ret = BSP_ERROR_NONE;
 
-  /* Check if the instance is supported */
-  if (Instance >= XSPI_RAM_INSTANCES_NUMBER)
+  if (XSPI_Nor_Ctx[Instance].TransferRate == BSP_XSPI_NOR_STR_TRANSFER)
   {
-    ret = BSP_ERROR_WRONG_PARAM;
+    if (MX66UW1G45G_ReadSTR(&hxspi_nor[Instance], XSPI_Nor_Ctx[Instance].InterfaceMode,
+                            MX66UW1G45G_4BYTES_SIZE, pData, ReadAddr, Size) != MX66UW1G45G_OK)
+    {
+      ret = BSP_ERROR_COMPONENT_FAILURE;
+    }
   }
   else
   {
-    if (APS256XX_EnableMemoryMappedMode(&hxspi_ram[Instance],
-                                        (uint32_t)APS256XX_READ_LATENCY(\
-                                                                        (uint32_t)(XSPI_Ram_Ctx[Instance].ReadLatencyCode),
-                                                                        (uint32_t)(XSPI_Ram_Ctx[Instance].LatencyType)),
-                                        (uint32_t)APS256XX_WRITE_LATENCY(\
-                                                                        (uint32_t)(XSPI_Ram_Ctx[Instance].WriteLatencyCode)),
-                                        (uint32_t)(XSPI_Ram_Ctx[Instance].IOMode), 0U) != APS256XX_OK)
+    if (MX66UW1G45G_ReadDTR(&hxspi_nor[Instance], pData, ReadAddr, Size) != MX66UW1G45G_OK)
     {
-      ret = BSP_ERROR_PERIPH_FAILURE;
+      ret = BSP_ERROR_COMPONENT_FAILURE;
     }
   }
 
-  /* Return BSP status */
   return ret;
 }
 
+#if (USE_BSP_XSPI_NOR_READ_CACHE == 1)
 /**
-  * @brief  Exit the memory-mapped mode
+  * @brief  Reads an amount of data through the read cache. A missed line is filled
+  *         alone, unless the read follows the previous one: all the lines are then
+  *         filled from the missed line onwards with a single read command.
   * @param  Instance  XSPI instance
+  * @param  pData     Pointer to data to be read
+  * @param  ReadAddr  Read start address
+  * @param  Size      Size of data to read
   * @retval BSP status
   */
-int32_t BSP_XSPI_RAM_DisableMemoryMappedMode(uint32_t Instance)
+static int32_t XSPI_NOR_CacheRead(uint32_t Instance, uint8_t *pData, uint32_t ReadAddr, uint32_t Size)
 {
   int32_t ret = BSP_ERROR_NONE;
-
-  /* Check if the instance is supported */
-  if (Instance >= XSPI_RAM_INSTANCES_NUMBER)
-  {
-    ret = BSP_ERROR_WRONG_PARAM;
-  }
-  else
+  XSPI_NOR_Cache_t *cache = &XSPINor_Cache[Instance];
+  BSP_XSPI_NOR_CacheStats_t *stats = &XSPINor_CacheStats[Instance];
+  uint32_t stream = (ReadAddr == cache->StreamEnd) ? 1U : 0U;
+  uint32_t hit = 1U;
+  uint32_t offset = 0U;
+  uint32_t address;
+  uint32_t base;
+  uint32_t line;
+  uint32_t lines;
+  uint32_t size;
+  uint32_t i;
+
+  while ((offset < Size) && (ret == BSP_ERROR_NONE))
   {
-    if (XSPI_Ram_Ctx[Instance].IsInitialized != XSPI_ACCESS_MMP)
+    address = ReadAddr + offset;
+    base    = address & ~(BSP_XSPI_NOR_READ_CACHE_LINE_SIZE - 1U);
+    size    = BSP_XSPI_NOR_READ_CACHE_LINE_SIZE - (address - base);
+    if (size > (Size - offset))
     {
-      ret = BSP_ERROR_XSPI_MMP_UNLOCK_FAILURE;
+      size = Size - offset;
     }
-    /* Abort MMP back to indirect mode */
-    else if (HAL_XSPI_Abort(&hxspi_ram[Instance]) != HAL_OK)
+
+    for (line = 0U; (line < BSP_XSPI_NOR_READ_CACHE_LINES) && (cache->Tag[line] != base); line++)
     {
-      ret = BSP_ERROR_PERIPH_FAILURE;
     }
-    /* Update XSPI HyperRAM context if all operations are well done */
+
+    if (line < BSP_XSPI_NOR_READ_CACHE_LINES)
+    {
+      stats->BytesSaved += size;
+    }
+    else if (stream == 1U)
+    {
+      /* Sequential stream: read ahead in all the lines, up to the end of the memory */
+      lines = (MX66UW1G45G_FLASH_SIZE - base) / BSP_XSPI_NOR_READ_CACHE_LINE_SIZE;
+      if (lines > BSP_XSPI_NOR_READ_CACHE_LINES)
+      {
+        lines = BSP_XSPI_NOR_READ_CACHE_LINES;
+      }
+
+      ret = XSPI_NOR_ReadMemory(Instance, XSPINor_CacheLines[Instance][0], base,
+                                lines * BSP_XSPI_NOR_READ_CACHE_LINE_SIZE);
+      for (i = 0U; i < BSP_XSPI_NOR_READ_CACHE_LINES; i++)
+      {
+        cache->Tag[i] = ((ret == BSP_ERROR_NONE) && (i < lines)) ? (base + (i * BSP_XSPI_NOR_READ_CACHE_LINE_SIZE))
+                        : XSPI_NOR_CACHE_INVALID;
+      }
+      cache->Next = 0U;
+      line        = 0U;
+      hit         = 0U;
+      stats->StreamFills++;
+    }
     else
     {
-      XSPI_Ram_Ctx[Instance].IsInitialized = XSPI_ACCESS_INDIRECT;
+      line        = cache->Next;
+      cache->Next = (cache->Next + 1U) % BSP_XSPI_NOR_READ_CACHE_LINES;
+
+      ret = XSPI_NOR_ReadMemory(Instance, XSPINor_CacheLines[Instance][line], base, BSP_XSPI_NOR_READ_CACHE_LINE_SIZE);
+      cache->Tag[line] = (ret == BSP_ERROR_NONE) ? base : XSPI_NOR_CACHE_INVALID;
+      hit = 0U;
+      stats->LineFills++;
+    }
+
+    for (i = 0U; (i < size) && (ret == BSP_ERROR_NONE); i++)
+    {
+      pData[offset + i] = XSPINor_CacheLines[Instance][line][(address - base) + i];
     }
+    offset += size;
   }
 
-  /* Return BSP status */
+  stats->Reads++;
+  if (hit == 1U)
+  {
+    stats->Hits++;
+  }
+  cache->StreamEnd = ReadAddr + Size;
+
   return ret;
 }
 
 /**
-  * @brief  Get RAM ID 3 Bytes:
-  *         Vendor ID, Device ID, Device Density
+  * @brief  Invalidates the read cache lines overlapping a memory range.
   * @param  Instance  XSPI instance
-  * @param  Id Pointer to RAM ID bytes
-  * @retval BSP status
+  * @param  Address   Range start address
+  * @param  Size      Range size
+  * @retval None
   */
-int32_t BSP_XSPI_RAM_ReadID(uint32_t Instance, uint8_t *Id)
+static void XSPI_NOR_CacheInvalidate(uint32_t Instance, uint32_t Address, uint32_t Size)
 {
-  int32_t ret;
+  XSPI_NOR_Cache_t *cache = &XSPINor_Cache[Instance];
+  uint32_t line;
 
-  /* Check if the instance is supported */
-  if (Instance >= XSPI_RAM_INSTANCES_NUMBER)
-  {
-    ret = BSP_ERROR_WRONG_PARAM;
-  }
-  else if (APS256XX_ReadID(&hxspi_ram[0], Id, (uint32_t)APS256XX_READ_REG_LATENCY(\
-                                                                                  (uint32_t)(XSPI_Ram_Ctx[Instance].ReadLatencyCode))) != APS256XX_OK)
-  {
-    ret = BSP_ERROR_COMPONENT_FAILURE;
-  }
-  else
+  for (line = 0U; line < BSP_XSPI_NOR_READ_CACHE_LINES; line++)
   {
-    ret = BSP_ERROR_NONE;
+    if ((cache->Tag[line] != XSPI_NOR_CACHE_INVALID) &&
+        ((cache->Tag[line] + BSP_XSPI_NOR_READ_CACHE_LINE_SIZE) > Address) && (cache->Tag[line] < (Address + Size)))
+    {
+      cache->Tag[line] = XSPI_NOR_CACHE_INVALID;
+    }
   }
-
-  /* Return BSP status */
-  return ret;
+  cache->StreamEnd = XSPI_NOR_CACHE_INVALID;
 }
+#endif /* USE_BSP_XSPI_NOR_READ_CACHE */
 
 /**
-  * @brief  Set 16-bits Octal RAM to desired configuration. And this instance becomes current instance.
-  *         If current instance running at MMP mode then this function doesn't work.
-  *         Indirect -> Indirect
-  * @param  Instance    XSPI instance
-  * @param  Cfg         pointer to the RAM config
+  * @brief  Updates a part of a 4KB sector, see BSP_XSPI_NOR_Update().
+  * @param  Instance  XSPI instance
+  * @param  pData     Pointer to data to be written
+  * @param  Address   Write start address
+  * @param  Size      Size of data to write, not crossing the end of the sector
+  * @param  pReport   Pointer to the update report
   * @retval BSP status
   */
-int32_t BSP_XSPI_RAM_Config16BitsOctalRAM(uint32_t Instance, BSP_XSPI_RAM_Cfg_t *Cfg)
+static int32_t XSPI_NOR_UpdateSector(uint32_t Instance, const uint8_t *pData, uint32_t Address, uint32_t Size,
+                                     BSP_XSPI_NOR_UpdateReport_t *pReport)
 {
   int32_t ret = BSP_ERROR_NONE;
-  uint8_t reg[2] = {0};
-
-  /* Check if the instance is supported */
-  if (Instance >= XSPI_RAM_INSTANCES_NUMBER)
-  {
-    ret = BSP_ERROR_WRONG_PARAM;
-  }
-  else
+  uint32_t sector = Address - (Address % MX66UW1G45G_SUBSECTOR_4K);
+  uint32_t end_addr = Address + Size;
+  uint32_t addr;
+  uint32_t size;
+  uint32_t page;
+  uint32_t diff = 0U;    /* Bit n set when the page n of the sector differs */
+  uint32_t erase = 0U;   /* Set when bits must go from 0 to 1               */
+  uint32_t blank;
+  uint32_t i;
+
+  /* Compare the sector with the data page by page */
+  for (addr = Address; (addr < end_addr) && (ret == BSP_ERROR_NONE); addr += size)
   {
-    /* Check if MMP mode locked ***********************************************/
-    if (XSPI_Ram_Ctx[Instance].IsInitialized == XSPI_ACCESS_MMP)
+    size = MX66UW1G45G_PAGE_SIZE - (addr % MX66UW1G45G_PAGE_SIZE);
+    size = ((end_addr - addr) < size) ? (end_addr - addr) : size;
+    page = (addr - sector) / MX66UW1G45G_PAGE_SIZE;
+
+    ret = BSP_XSPI_NOR_Read(Instance, &XSPINor_UpdateSector[addr - sector], addr, size);
+    for (i = 0U; (i < size) && (ret == BSP_ERROR_NONE); i++)
     {
-      ret = BSP_ERROR_XSPI_MMP_LOCK_FAILURE;
+      if (XSPINor_UpdateSector[(addr - sector) + i] != pData[(addr - Address) + i])
+      {
+        diff |= (1UL << page);
+        erase |= ((XSPINor_UpdateSector[(addr - sector) + i] & pData[(addr - Address) + i]) !=
+                  pData[(addr - Address) + i]) ? 1U : 0U;
+      }
     }
-    else
+  }
+
+  if ((ret == BSP_ERROR_NONE) && (erase == 0U))
+  {
+    /* Program the differing pages, programming only clears bits */
+    for (addr = Address; (addr < end_addr) && (ret == BSP_ERROR_NONE); addr += size)
     {
-      if ((XSPI_Ram_Ctx[Instance].IsInitialized   == XSPI_ACCESS_NONE) ||
-          (XSPI_Ram_Ctx[Instance].LatencyType     != Cfg->LatencyType) ||
-          (XSPI_Ram_Ctx[Instance].ReadLatencyCode != Cfg->ReadLatencyCode))
+      size = MX66UW1G45G_PAGE_SIZE - (addr % MX66UW1G45G_PAGE_SIZE);
+      size = ((end_addr - addr) < size) ? (end_addr - addr) : size;
+      page = (addr - sector) / MX66UW1G45G_PAGE_SIZE;
+
+      if ((diff & (1UL << page)) == 0U)
       {
-        /* Reading the configuration of Mode Register 0 ***********************/
-        if (APS256XX_ReadReg(&hxspi_ram[Instance], APS256XX_MR0_ADDRESS, reg,
-                             (uint32_t)APS256XX_READ_REG_LATENCY((uint32_t) \
-                               (XSPI_Ram_Ctx[Instance].ReadLatencyCode))) != APS256XX_OK)
-        {
-          ret = BSP_ERROR_COMPONENT_FAILURE;
-        }
-        else
+        pReport->SkippedPages++;
+      }
+      else
+      {
+        ret = XSPI_NOR_ProgramPage(Instance, &pData[addr - Address], addr, size);
+        if (ret == BSP_ERROR_NONE)
         {
-          /* Configure the 16-bits Octal RAM memory ***************************/
-          MODIFY_REG(reg[0], ((uint8_t)APS256XX_MR0_LATENCY_TYPE |
-                              (uint8_t)APS256XX_MR0_READ_LATENCY_CODE |
-                              (uint8_t)APS256XX_MR0_DRIVE_STRENGTH),
-                     ((uint8_t)(Cfg->LatencyType) |
-                     (uint8_t)(Cfg->ReadLatencyCode) |
-                     (uint8_t)CONF_HSPI_DS));
-
-          if (APS256XX_WriteReg(&hxspi_ram[Instance], APS256XX_MR0_ADDRESS, reg[0]) != APS256XX_OK)
-          {
-            ret = BSP_ERROR_COMPONENT_FAILURE;
-          }
+          ret = XSPI_NOR_WaitMemReady(Instance);
         }
+        pReport->ProgrammedPages++;
+      }
+    }
+  }
+  else if (ret == BSP_ERROR_NONE)
+  {
+    /* Read-modify-write of the whole sector */
+    ret = BSP_XSPI_NOR_Read(Instance, XSPINor_UpdateSector, sector, MX66UW1G45G_SUBSECTOR_4K);
+    if (ret == BSP_ERROR_NONE)
+    {
+      for (i = 0U; i < Size; i++)
+      {
+        XSPINor_UpdateSector[(Address - sector) + i] = pData[i];
       }
 
+      ret = BSP_XSPI_NOR_Erase_Block(Instance, sector, BSP_XSPI_NOR_ERASE_4K);
       if (ret == BSP_ERROR_NONE)
       {
-        if ((XSPI_Ram_Ctx[Instance].IsInitialized    == XSPI_ACCESS_NONE) ||
-            (XSPI_Ram_Ctx[Instance].WriteLatencyCode != Cfg->WriteLatencyCode))
-        {
-          /* Reading the configuration of Mode Register 4 ***********************/
-          if (APS256XX_ReadReg(&hxspi_ram[Instance], APS256XX_MR4_ADDRESS, reg,
-                               (uint32_t)APS256XX_READ_REG_LATENCY((uint32_t) \
-                                                                   (XSPI_Ram_Ctx[Instance].ReadLatencyCode))) != APS256XX_OK)
-          {
-            ret = BSP_ERROR_COMPONENT_FAILURE;
-          }
-          else
-          {
-            /* Configure the 16-bits Octal RAM memory ***************************/
-            WRITE_REG(reg[0], ((uint8_t)Cfg->WriteLatencyCode |
-                               (uint8_t)CONF_HSPI_RF |
-                               (uint8_t)CONF_HSPI_PASR));
+        ret = XSPI_NOR_WaitMemReady(Instance);
+      }
+      pReport->ErasedSectors++;
+    }
 
-            if (APS256XX_WriteReg(&hxspi_ram[Instance], APS256XX_MR4_ADDRESS, reg[0]) != APS256XX_OK)
-            {
-              ret = BSP_ERROR_COMPONENT_FAILURE;
-            }
-          }
-        }
+    /* Program the pages which are not blank */
+    for (page = 0U; (page < (MX66UW1G45G_SUBSECTOR_4K / MX66UW1G45G_PAGE_SIZE)) && (ret == BSP_ERROR_NONE); page++)
+    {
+      blank = 1U;
+      for (i = 0U; (i < MX66UW1G45G_PAGE_SIZE) && (blank == 1U); i++)
+      {
+        blank = (XSPINor_UpdateSector[(page * MX66UW1G45G_PAGE_SIZE) + i] == 0xFFU) ? 1U : 0U;
       }
 
-      if (ret == BSP_ERROR_NONE)
+      if (blank == 0U)
       {
-        if ((XSPI_Ram_Ctx[Instance].IsInitialized == XSPI_ACCESS_NONE) ||
-            (XSPI_Ram_Ctx[Instance].IOMode        != Cfg->IOMode))
+        ret = XSPI_NOR_ProgramPage(Instance, &XSPINor_UpdateSector[page * MX66UW1G45G_PAGE_SIZE],
+                                   sector + (page * MX66UW1G45G_PAGE_SIZE), MX66UW1G45G_PAGE_SIZE);
+        if (ret == BSP_ERROR_NONE)
         {
-          /* Reading the configuration of Mode Register 8 ***********************/
-          if (APS256XX_ReadReg(&hxspi_ram[Instance], APS256XX_MR8_ADDRESS, reg,
-                               (uint32_t)APS256XX_READ_REG_LATENCY((uint32_t) \
-                                                                   (XSPI_Ram_Ctx[Instance].ReadLatencyCode))) != APS256XX_OK)
-          {
-            ret = BSP_ERROR_COMPONENT_FAILURE;
-          }
-          else
-          {
-            /* Configure the 16-bits Octal RAM memory ***************************/
-            MODIFY_REG(reg[0], (uint8_t)APS256XX_MR8_X8_X16, (uint8_t)(Cfg->IOMode));
-
-            if (APS256XX_WriteReg(&hxspi_ram[Instance], APS256XX_MR8_ADDRESS, reg[0]) != APS256XX_OK)
-            {
-              ret = BSP_ERROR_COMPONENT_FAILURE;
-            }
-          }
+          ret = XSPI_NOR_WaitMemReady(Instance);
         }
+        pReport->ProgrammedPages++;
       }
+    }
+  }
+  else
+  {
+    /* Read failure */
+  }
 
-      /* Update XSPI context if all operations are well done */
-      if (ret == BSP_ERROR_NONE)
+  return ret;
+}
+
+/**
+  * @brief  Status match callback of the NOR instances: the write enable latch is
+  *         set and the page is sent, or the memory is ready and the next page is
+  *         started or the operation is completed.
+  * @param  hxspi XSPI handle
+  * @retval None
+  */
+static void XSPI_NOR_StatusMatchCallback(XSPI_HandleTypeDef *hxspi)
+{
+  uint32_t instance;
+  XSPI_NOR_ItCtx_t *ctx;
+
+  for (instance = 0U; instance < XSPI_NOR_INSTANCES_NUMBER; instance++)
+  {
+    ctx = &XSPINor_ItCtx[instance];
+
+    if ((hxspi == &hxspi_nor[instance]) &&
+        ((ctx->State == XSPI_NOR_IT_PROGRAM) || (ctx->State == XSPI_NOR_IT_PROGRAM_DMA)))
+    {
+      if (ctx->Step == XSPI_NOR_STEP_WEL)
       {
-        /* Update current status parameter *****************************************/
-        XSPI_Ram_Ctx[Instance].IsInitialized    = XSPI_ACCESS_INDIRECT;
-        XSPI_Ram_Ctx[Instance].LatencyType      = Cfg->LatencyType;
-        XSPI_Ram_Ctx[Instance].ReadLatencyCode  = Cfg->ReadLatencyCode;
-        XSPI_Ram_Ctx[Instance].WriteLatencyCode = Cfg->WriteLatencyCode;
-        XSPI_Ram_Ctx[Instance].IOMode           = Cfg->IOMode;
+        ctx->Step = XSPI_NOR_STEP_DATA;
+      }
+      else
+      {
+        /* Move to the next page */
+        ctx->Address     += ctx->Size;
+        ctx->DataAddress += ctx->Size;
+        ctx->Size         = ((ctx->Address + MX66UW1G45G_PAGE_SIZE) > ctx->EndAddress)
+                            ? (ctx->EndAddress - ctx->Address)
+                            : MX66UW1G45G_PAGE_SIZE;
+        ctx->Step         = XSPI_NOR_STEP_WRITE_ENABLE;
+      }
+
+      if (ctx->Address >= ctx->EndAddress)
+      {
+        ctx->State = XSPI_NOR_IT_IDLE;
+        BSP_XSPI_NOR_WriteCpltCallback(instance);
+      }
+      else if (XSPI_NOR_ProgramStep_IT(instance) != BSP_ERROR_NONE)
+      {
+        ctx->State = XSPI_NOR_IT_IDLE;
+        BSP_XSPI_NOR_ErrorCallback(instance);
+      }
+      else
+      {
+        /* Page program in progress */
       }
     }
+    else if ((hxspi == &hxspi_nor[instance]) && (ctx->State == XSPI_NOR_IT_ERASE))
+    {
+      ctx->State = XSPI_NOR_IT_IDLE;
+      BSP_XSPI_NOR_EraseCpltCallback(instance);
+    }
+    else
+    {
+      /* Not an interrupt driven NOR operation */
+    }
   }
-
-  /* Return BSP status */
-  return ret;
 }
 
 /**
-  * @brief  Handles XSPI 16-bits Octal RAM DMA transfer interrupt request.
-  * @param  Instance XSPI instance
+  * @brief  Command complete callback of the NOR instances: the write enable
+  *         command is sent, the write enable latch is polled.
+  * @param  hxspi XSPI handle
   * @retval None
   */
-void BSP_XSPI_RAM_DMA_RX_IRQHandler(uint32_t Instance)
+static void XSPI_NOR_CmdCpltCallback(XSPI_HandleTypeDef *hxspi)
 {
-  HAL_DMA_IRQHandler(hxspi_ram[Instance].hdmarx);
+  uint32_t instance;
+  XSPI_NOR_ItCtx_t *ctx;
+
+  for (instance = 0U; instance < XSPI_NOR_INSTANCES_NUMBER; instance++)
+  {
+    ctx = &XSPINor_ItCtx[instance];
+
+    if ((hxspi == &hxspi_nor[instance]) && (ctx->Step == XSPI_NOR_STEP_WRITE_ENABLE) &&
+        ((ctx->State == XSPI_NOR_IT_PROGRAM) || (ctx->State == XSPI_NOR_IT_PROGRAM_DMA)))
+    {
+      ctx->Step = XSPI_NOR_STEP_WEL;
+      if (XSPI_NOR_ProgramStep_IT(instance) != BSP_ERROR_NONE)
+      {
+        ctx->State = XSPI_NOR_IT_IDLE;
+        BSP_XSPI_NOR_ErrorCallback(instance);
+      }
+    }
+  }
 }
 
 /**
-  * @brief  Handles XSPI 16-bits Octal RAM DMA transfer interrupt request.
-  * @param  Instance XSPI instance
+  * @brief  Tx transfer complete callback of the NOR instances: the page is sent,
+  *         the end of its program is detected by the status match interrupt.
+  * @param  hxspi XSPI handle
   * @retval None
   */
-void BSP_XSPI_RAM_DMA_TX_IRQHandler(uint32_t Instance)
+static void XSPI_NOR_TxCpltCallback(XSPI_HandleTypeDef *hxspi)
 {
-  HAL_DMA_IRQHandler(hxspi_ram[Instance].hdmatx);
+  uint32_t instance;
+  XSPI_NOR_ItCtx_t *ctx;
+
+  for (instance = 0U; instance < XSPI_NOR_INSTANCES_NUMBER; instance++)
+  {
+    ctx = &XSPINor_ItCtx[instance];
+
+    if ((hxspi == &hxspi_nor[instance]) && (ctx->Step == XSPI_NOR_STEP_DATA) &&
+        ((ctx->State == XSPI_NOR_IT_PROGRAM) || (ctx->State == XSPI_NOR_IT_PROGRAM_DMA)))
+    {
+      ctx->Step = XSPI_NOR_STEP_WIP;
+      if (XSPI_NOR_ProgramStep_IT(instance) != BSP_ERROR_NONE)
+      {
+        ctx->State = XSPI_NOR_IT_IDLE;
+        BSP_XSPI_NOR_ErrorCallback(instance);
+      }
+    }
+  }
 }
 
 /**
-  * @brief  Handles XSPI 16-bits Octal RAM interrupt request.
-  * @param  Instance XSPI instance
+  * @brief  Error callback of the NOR instances.
+  * @param  hxspi XSPI handle
   * @retval None
   */
-void BSP_XSPI_RAM_IRQHandler(uint32_t Instance)
+static void XSPI_NOR_ErrorCallback(XSPI_HandleTypeDef *hxspi)
 {
-  HAL_XSPI_IRQHandler(&hxspi_ram[Instance]);
-}
-/**
-  * @}
-  */
-#endif /* USE_RAM_MEMORY_APS256XX */
+  uint32_t instance;
 
-#if (USE_NOR_MEMORY_MX66UW1G45G == 1)
-/** @addtogroup STM32H7S78_DK_XSPI_NOR_Private_Functions
-  * @{
-  */
+  for (instance = 0U; instance < XSPI_NOR_INSTANCES_NUMBER; instance++)
+  {
+    if ((hxspi == &hxspi_nor[instance]) && (XSPINor_ItCtx[instance].State != XSPI_NOR_IT_IDLE))
+    {
+      XSPINor_ItCtx[instance].State = XSPI_NOR_IT_IDLE;
+      BSP_XSPI_NOR_ErrorCallback(instance);
+    }
+  }
+}
 
+#if (USE_BSP_XSPI_NOR_DMA == 1)
 /**
-  * @brief  Initializes the XSPI MSP.
-  * @param  hxspi XSPI handle
-  * @retval None
+  * @brief  Issues a read or a page program command and starts its DMA transfer,
+  *         the write operations must be enabled before a page program.
+  * @param  Instance  XSPI instance
+  * @param  pData     Pointer to data
+  * @param  Address   Memory address
+  * @param  Size      Size of data, up to the end of the page for a program
+  * @param  Write     1 for a page program, 0 for a read
+  * @retval BSP status
   */
-static void XSPI_NOR_MspInit(XSPI_HandleTypeDef *hxspi)
+static int32_t XSPI_NOR_Transfer_DMA(uint32_t Instance, uint8_t *pData, uint32_t Address, uint32_t Size,
+                                     uint32_t Write)
 {
-  GPIO_InitTypeDef GPIO_InitStruct;
-
-  /* hxspi unused argument(s) compilation warning */
-  UNUSED(hxspi);
-
-  /* Enable the SBS Clock */
-  __HAL_RCC_SBS_CLK_ENABLE();
-
-  /* Enable the power of XSPI */
-  XSPI_NOR_PWR_ENABLE();
-
-  /* Enable the XSPI memory interface clock */
-  XSPI_NOR_CLK_ENABLE();
-
-  /* Reset the XSPI memory interface */
-  XSPI_NOR_FORCE_RESET();
-  XSPI_NOR_RELEASE_RESET();
-
-  /* Enable GPIO clocks */
-  XSPI_NOR_CLK_GPIO_CLK_ENABLE();
-  XSPI_NOR_DQS_GPIO_CLK_ENABLE();
-  XSPI_NOR_CS_GPIO_CLK_ENABLE();
-  XSPI_NOR_D0_GPIO_CLK_ENABLE();
-  XSPI_NOR_D1_GPIO_CLK_ENABLE();
-  XSPI_NOR_D2_GPIO_CLK_ENABLE();
-  XSPI_NOR_D3_GPIO_CLK_ENABLE();
-  XSPI_NOR_D4_GPIO_CLK_ENABLE();
-  XSPI_NOR_D5_GPIO_CLK_ENABLE();
-  XSPI_NOR_D6_GPIO_CLK_ENABLE();
-  XSPI_NOR_D7_GPIO_CLK_ENABLE();
-
-  /* SBS: Enable HSLV on XSPI2 */
-  HAL_SBS_EnableIOSpeedOptimize(SBS_IO_XSPI2_HSLV);
-
-  /* XSPI CS GPIO pin configuration  */
-  GPIO_InitStruct.Pin       = XSPI_NOR_CS_PIN;
-  GPIO_InitStruct.Mode      = GPIO_MODE_AF_PP;
-  GPIO_InitStruct.Pull      = GPIO_PULLUP;
-  GPIO_InitStruct.Speed     = GPIO_SPEED_FREQ_VERY_HIGH;
-  GPIO_InitStruct.Alternate = XSPI_NOR_CS_PIN_AF;
-  HAL_GPIO_Init(XSPI_NOR_CS_GPIO_PORT, &GPIO_InitStruct);
-
-  /* XSPI DQS GPIO pin configuration  */
-  GPIO_InitStruct.Pin       = XSPI_NOR_DQS_PIN;
-  GPIO_InitStruct.Alternate = XSPI_NOR_DQS_PIN_AF;
-  HAL_GPIO_Init(XSPI_NOR_DQS_GPIO_PORT, &GPIO_InitStruct);
-
-  /* XSPI CLK GPIO pin configuration  */
-  GPIO_InitStruct.Pin       = XSPI_NOR_CLK_PIN;
-  GPIO_InitStruct.Pull      = GPIO_NOPULL;
-  GPIO_InitStruct.Alternate = XSPI_NOR_CLK_PIN_AF;
-  HAL_GPIO_Init(XSPI_NOR_CLK_GPIO_PORT, &GPIO_InitStruct);
-
-  /* XSPI D0 GPIO pin configuration  */
-  GPIO_InitStruct.Pin       = XSPI_NOR_D0_PIN;
-  GPIO_InitStruct.Alternate = XSPI_NOR_D0_PIN_AF;
-  HAL_GPIO_Init(XSPI_NOR_D0_GPIO_PORT, &GPIO_InitStruct);
-
-  /* XSPI D1 GPIO pin configuration  */
-  GPIO_InitStruct.Pin       = XSPI_NOR_D1_PIN;
-  GPIO_InitStruct.Alternate = XSPI_NOR_D1_PIN_AF;
-  HAL_GPIO_Init(XSPI_NOR_D1_GPIO_PORT, &GPIO_InitStruct);
+  int32_t ret = BSP_ERROR_NONE;
+  XSPI_RegularCmdTypeDef s_command = {0};
 
-  /* XSPI D2 GPIO pin configuration  */
-  GPIO_InitStruct.Pin       = XSPI_NOR_D2_PIN;
-  GPIO_InitStruct.Alternate = XSPI_NOR_D2_PIN_AF;
-  HAL_GPIO_Init(XSPI_NOR_D2_GPIO_PORT, &GPIO_InitStruct);
+  XSPI_NOR_SetTransferCommand(Instance, &s_command, Address, Size, Write);
 
-  /* XSPI D3 GPIO pin configuration  */
-  GPIO_InitStruct.Pin       = XSPI_NOR_D3_PIN;
-  GPIO_InitStruct.Alternate = XSPI_NOR_D3_PIN_AF;
-  HAL_GPIO_Init(XSPI_NOR_D3_GPIO_PORT, &GPIO_InitStruct);
+  if (HAL_XSPI_Command(&hxspi_nor[Instance], &s_command, HAL_XSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+  {
+    ret = BSP_ERROR_PERIPH_FAILURE;
+  }
+  else if (Write == 1U)
+  {
+    if (HAL_XSPI_Transmit_DMA(&hxspi_nor[Instance], pData) != HAL_OK)
+    {
+      ret = BSP_ERROR_PERIPH_FAILURE;
+    }
+  }
+  else
+  {
+    if (HAL_XSPI_Receive_DMA(&hxspi_nor[Instance], pData) != HAL_OK)
+    {
+      ret = BSP_ERROR_PERIPH_FAILURE;
+    }
+  }
 
-  /* XSPI D4 GPIO pin configuration  */
-  GPIO_InitStruct.Pin       = XSPI_NOR_D4_PIN;
-  GPIO_InitStruct.Alternate = XSPI_NOR_D4_PIN_AF;
-  HAL_GPIO_Init(XSPI_NOR_D4_GPIO_PORT, &GPIO_InitStruct);
+  return ret;
+}
 
-  /* XSPI D5 GPIO pin configuration  */
-  GPIO_InitStruct.Pin       = XSPI_NOR_D5_PIN;
-  GPIO_InitStruct.Alternate = XSPI_NOR_D5_PIN_AF;
-  HAL_GPIO_Init(XSPI_NOR_D5_GPIO_PORT, &GPIO_InitStruct);
+/**
+  * @brief  Starts the DMA read of the next part of the region in progress.
+  * @param  Instance  XSPI instance
+  * @retval BSP status
+  */
+static int32_t XSPI_NOR_ReadNext_DMA(uint32_t Instance)
+{
+  XSPI_NOR_ItCtx_t *ctx = &XSPINor_ItCtx[Instance];
 
-  /* XSPI D6 GPIO pin configuration  */
-  GPIO_InitStruct.Pin       = XSPI_NOR_D6_PIN;
-  GPIO_InitStruct.Alternate = XSPI_NOR_D6_PIN_AF;
-  HAL_GPIO_Init(XSPI_NOR_D6_GPIO_PORT, &GPIO_InitStruct);
+  ctx->Size = ctx->EndAddress - ctx->Address;
+  if (ctx->Size > XSPI_NOR_DMA_MAX_SIZE)
+  {
+    ctx->Size = XSPI_NOR_DMA_MAX_SIZE;
+  }
 
-  /* XSPI D7 GPIO pin configuration  */
-  GPIO_InitStruct.Pin       = XSPI_NOR_D7_PIN;
-  GPIO_InitStruct.Alternate = XSPI_NOR_D7_PIN_AF;
-  HAL_GPIO_Init(XSPI_NOR_D7_GPIO_PORT, &GPIO_InitStruct);
+  return XSPI_NOR_Transfer_DMA(Instance, (uint8_t *)ctx->DataAddress, ctx->Address, ctx->Size, 0U);
 }
 
 /**
-  * @brief  De-Initializes the XSPI MSP.
+  * @brief  Rx transfer complete callback of the NOR instances: the next part of
+  *         the region or the next region is read, or the read is completed.
   * @param  hxspi XSPI handle
   * @retval None
   */
-static void XSPI_NOR_MspDeInit(XSPI_HandleTypeDef *hxspi)
+static void XSPI_NOR_RxCpltCallback(XSPI_HandleTypeDef *hxspi)
 {
-  /* hxspi unused argument(s) compilation warning */
-  UNUSED(hxspi);
+  uint32_t instance;
+  XSPI_NOR_ItCtx_t *ctx;
 
-  /* XSPI GPIO pins de-configuration  */
-  HAL_GPIO_DeInit(XSPI_NOR_CLK_GPIO_PORT, XSPI_NOR_CLK_PIN);
-  HAL_GPIO_DeInit(XSPI_NOR_DQS_GPIO_PORT, XSPI_NOR_DQS_PIN);
-  HAL_GPIO_DeInit(XSPI_NOR_CS_GPIO_PORT, XSPI_NOR_CS_PIN);
-  HAL_GPIO_DeInit(XSPI_NOR_D0_GPIO_PORT, XSPI_NOR_D0_PIN);
-  HAL_GPIO_DeInit(XSPI_NOR_D1_GPIO_PORT, XSPI_NOR_D1_PIN);
-  HAL_GPIO_DeInit(XSPI_NOR_D2_GPIO_PORT, XSPI_NOR_D2_PIN);
-  HAL_GPIO_DeInit(XSPI_NOR_D3_GPIO_PORT, XSPI_NOR_D3_PIN);
-  HAL_GPIO_DeInit(XSPI_NOR_D4_GPIO_PORT, XSPI_NOR_D4_PIN);
-  HAL_GPIO_DeInit(XSPI_NOR_D5_GPIO_PORT, XSPI_NOR_D5_PIN);
-  HAL_GPIO_DeInit(XSPI_NOR_D6_GPIO_PORT, XSPI_NOR_D6_PIN);
-  HAL_GPIO_DeInit(XSPI_NOR_D7_GPIO_PORT, XSPI_NOR_D7_PIN);
+  for (instance = 0U; instance < XSPI_NOR_INSTANCES_NUMBER; instance++)
+  {
+    ctx = &XSPINor_ItCtx[instance];
 
-  /* Reset the XSPI memory interface */
-  XSPI_NOR_FORCE_RESET();
-  XSPI_NOR_RELEASE_RESET();
+    if ((hxspi == &hxspi_nor[instance]) && (ctx->State == XSPI_NOR_IT_READ_DMA))
+    {
+      ctx->Address     += ctx->Size;
+      ctx->DataAddress += ctx->Size;
 
-  /* Disable the XSPI memory interface clock */
-  XSPI_NOR_CLK_DISABLE();
+      /* Move to the next region */
+      if (ctx->Address >= ctx->EndAddress)
+      {
+        ctx->Item++;
+        if (ctx->Item < ctx->NbItems)
+        {
+          ctx->Address     = ctx->pItems[ctx->Item].Address;
+          ctx->EndAddress  = ctx->pItems[ctx->Item].Address + ctx->pItems[ctx->Item].Size;
+          ctx->DataAddress = (uint32_t)ctx->pItems[ctx->Item].pData;
+        }
+      }
+
+      if (ctx->Item >= ctx->NbItems)
+      {
+        ctx->State = XSPI_NOR_IT_IDLE;
+        BSP_XSPI_NOR_ReadCpltCallback(instance);
+      }
+      else if (XSPI_NOR_ReadNext_DMA(instance) != BSP_ERROR_NONE)
+      {
+        ctx->State = XSPI_NOR_IT_IDLE;
+        BSP_XSPI_NOR_ErrorCallback(instance);
+      }
+      else
+      {
+        /* DMA read in progress */
+      }
+    }
+  }
 }
+#endif /* USE_BSP_XSPI_NOR_DMA */
 
 /**
   * @brief  This function reset the XSPI memory.
@@ -1983,6 +4050,103 @@ static int32_t XSPI_NOR_ResetMemory(uint32_t Instance)
   return ret;
 }
 
+/**
+  * @brief  Detects the protocol the memory is configured for. The memory keeps it over
+  *         an MCU reset, so a warm boot needs neither a reset nor a reconfiguration.
+  *         SPI, STR OPI then DTR OPI are probed with the read ID command, the octal
+  *         modes are confirmed by the configuration registers.
+  * @param  Instance  XSPI instance
+  * @retval BSP status, BSP_ERROR_COMPONENT_FAILURE when the memory must be reset
+  */
+static int32_t XSPI_NOR_DetectMode(uint32_t Instance)
+{
+  int32_t ret = BSP_ERROR_COMPONENT_FAILURE;
+  int32_t status;
+  static const BSP_XSPI_NOR_Interface_t modes[3] = {BSP_XSPI_NOR_SPI_MODE, BSP_XSPI_NOR_OPI_MODE,
+                                                     BSP_XSPI_NOR_OPI_MODE
+                                                    };
+  static const BSP_XSPI_NOR_Transfer_t rates[3] = {BSP_XSPI_NOR_STR_TRANSFER, BSP_XSPI_NOR_STR_TRANSFER,
+                                                    BSP_XSPI_NOR_DTR_TRANSFER
+                                                   };
+  static const uint8_t protocols[3] = {0U, MX66UW1G45G_CR2_SOPI, MX66UW1G45G_CR2_DOPI};
+  uint8_t dummy_cycles = XSPINor_DummyCyclesArray[((DUMMY_CYCLES_READ_OCTAL / 2U) - 3U)];
+  uint32_t memory_type = hxspi_nor[Instance].Init.MemoryType;
+  uint32_t dhqc = hxspi_nor[Instance].Init.DelayHoldQuarterCycle;
+  uint8_t id[6] = {0};
+  uint8_t reg[2] = {0};
+  uint32_t i;
+
+  for (i = 0U; (i < 3U) && (ret == BSP_ERROR_COMPONENT_FAILURE); i++)
+  {
+    /* The peripheral settings follow the transfer rate */
+    hxspi_nor[Instance].Init.MemoryType            = HAL_XSPI_MEMTYPE_MACRONIX;
+    hxspi_nor[Instance].Init.DelayHoldQuarterCycle = (rates[i] == BSP_XSPI_NOR_DTR_TRANSFER) ? HAL_XSPI_DHQC_ENABLE
+                                                     : HAL_XSPI_DHQC_DISABLE;
+    if (HAL_XSPI_Init(&hxspi_nor[Instance]) != HAL_OK)
+    {
+      ret = BSP_ERROR_PERIPH_FAILURE;
+    }
+    else if ((MX66UW1G45G_ReadID(&hxspi_nor[Instance], modes[i], rates[i], id) != MX66UW1G45G_OK) ||
+             (id[0] != XSPI_NOR_MANUFACTURER_ID))
+    {
+      /* Nothing to do, the memory does not answer with this protocol */
+    }
+    else if (modes[i] == BSP_XSPI_NOR_SPI_MODE)
+    {
+      /* Same peripheral settings as after XSPI_NOR_ExitOPIMode() */
+      hxspi_nor[Instance].Init.MemoryType            = HAL_XSPI_MEMTYPE_MICRON;
+      hxspi_nor[Instance].Init.DelayHoldQuarterCycle = HAL_XSPI_DHQC_DISABLE;
+      ret = (HAL_XSPI_Init(&hxspi_nor[Instance]) != HAL_OK) ? BSP_ERROR_PERIPH_FAILURE : BSP_ERROR_NONE;
+    }/* Check the octal protocol and the dummy cycles */
+    else if ((MX66UW1G45G_ReadCfg2Register(&hxspi_nor[Instance], modes[i], rates[i], MX66UW1G45G_CR2_REG1_ADDR,
+                                           reg) != MX66UW1G45G_OK) || (reg[0] != protocols[i]))
+    {
+      /* Nothing to do */
+    }
+    else if ((MX66UW1G45G_ReadCfg2Register(&hxspi_nor[Instance], modes[i], rates[i], MX66UW1G45G_CR2_REG3_ADDR,
+                                           reg) != MX66UW1G45G_OK) || (reg[0] != dummy_cycles))
+    {
+      /* Nothing to do */
+    }
+    else
+    {
+      ret = BSP_ERROR_NONE;
+    }
+
+    if (ret == BSP_ERROR_NONE)
+    {
+      XSPI_Nor_Ctx[Instance].IsInitialized = XSPI_ACCESS_INDIRECT;
+      XSPI_Nor_Ctx[Instance].InterfaceMode = modes[i];
+      XSPI_Nor_Ctx[Instance].TransferRate  = rates[i];
+    }
+  }
+
+  /* An ongoing, suspended or failed operation left by the previous run requires a reset */
+  if (ret == BSP_ERROR_NONE)
+  {
+    status = BSP_XSPI_NOR_GetStatus(Instance);
+    if (status != BSP_ERROR_NONE)
+    {
+      ret = BSP_ERROR_COMPONENT_FAILURE;
+    }
+  }
+
+  /* Restore the peripheral settings for the reset */
+  if ((ret != BSP_ERROR_NONE) && ((hxspi_nor[Instance].Init.MemoryType != memory_type) ||
+                                  (hxspi_nor[Instance].Init.DelayHoldQuarterCycle != dhqc)))
+  {
+    hxspi_nor[Instance].Init.MemoryType            = memory_type;
+    hxspi_nor[Instance].Init.DelayHoldQuarterCycle = dhqc;
+    if (HAL_XSPI_Init(&hxspi_nor[Instance]) != HAL_OK)
+    {
+      ret = BSP_ERROR_PERIPH_FAILURE;
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
 /**
   * @brief  This function enables the octal DTR mode of the memory.
   * @param  Instance  XSPI instance
@@ -41,6 +41,44 @@ extern "C" {
 #include "../Components/mx66uw1g45g/mx66uw1g45g.h"
 #endif /* USE_NOR_MEMORY_MX66UW1G45G */
 
+#ifndef BSP_XSPI_NOR_IT_PRIORITY
+#define BSP_XSPI_NOR_IT_PRIORITY             15U
+#endif /* BSP_XSPI_NOR_IT_PRIORITY */
+
+/* Suspends of an interrupt driven erase allowed to serve reads */
+#ifndef BSP_XSPI_NOR_ERASE_SUSPEND_MAX
+#define BSP_XSPI_NOR_ERASE_SUSPEND_MAX       8U
+#endif /* BSP_XSPI_NOR_ERASE_SUSPEND_MAX */
+
+/* Minimum time (ms) an erase runs after a resume before being suspended again */
+#ifndef BSP_XSPI_NOR_ERASE_RESUME_TIME
+#define BSP_XSPI_NOR_ERASE_RESUME_TIME       1U
+#endif /* BSP_XSPI_NOR_ERASE_RESUME_TIME */
+
+/* Read cache of the indirect mode: small reads are served from SRAM lines and a
+   sequential stream fills all the lines with a single read-ahead command */
+#ifndef USE_BSP_XSPI_NOR_READ_CACHE
+#define USE_BSP_XSPI_NOR_READ_CACHE          0U
+#endif /* USE_BSP_XSPI_NOR_READ_CACHE */
+
+/* Cache line size in bytes, power of 2 */
+#ifndef BSP_XSPI_NOR_READ_CACHE_LINE_SIZE
+#define BSP_XSPI_NOR_READ_CACHE_LINE_SIZE    256U
+#endif /* BSP_XSPI_NOR_READ_CACHE_LINE_SIZE */
+
+#ifndef BSP_XSPI_NOR_READ_CACHE_LINES
+#define BSP_XSPI_NOR_READ_CACHE_LINES        4U
+#endif /* BSP_XSPI_NOR_READ_CACHE_LINES */
+
+/* DMA transfers of the indirect mode, HPDMA1 channels 13 and 14 */
+#ifndef USE_BSP_XSPI_NOR_DMA
+#define USE_BSP_XSPI_NOR_DMA                 0U
+#endif /* USE_BSP_XSPI_NOR_DMA */
+
+#ifndef BSP_XSPI_NOR_DMA_IT_PRIORITY
+#define BSP_XSPI_NOR_DMA_IT_PRIORITY         15U
+#endif /* BSP_XSPI_NOR_DMA_IT_PRIORITY */
+
 #if (USE_RAM_MEMORY_APS256XX == 1)
 #include "../Components/aps256xx/aps256xx.h"
 #endif /* USE_RAM_MEMORY_APS256XX */
@@ -108,6 +146,47 @@ typedef struct
   BSP_XSPI_NOR_Interface_t   InterfaceMode;      /*!<  Current Flash Interface mode */
   BSP_XSPI_NOR_Transfer_t    TransferRate;       /*!<  Current Flash Transfer rate  */
 } BSP_XSPI_NOR_Init_t;
+
+typedef struct
+{
+  uint32_t Erase64KNbr;        /*!<  64KB block erases issued                         */
+  uint32_t Erase4KNbr;         /*!<  4KB sector erases issued                         */
+  uint32_t SkippedSectors;     /*!<  4KB sectors left as they were already blank      */
+  uint32_t EraseTime;          /*!<  Typical time of the issued erases (ms)           */
+  uint32_t SavedTime;          /*!<  Typical time saved by the blank sector skip (ms) */
+} BSP_XSPI_NOR_EraseReport_t;
+
+typedef struct
+{
+  uint32_t SkippedPages;       /*!<  Pages already holding the data                   */
+  uint32_t ProgrammedPages;    /*!<  Pages programmed                                 */
+  uint32_t ErasedSectors;      /*!<  4KB sectors erased to set bits from 0 to 1       */
+} BSP_XSPI_NOR_UpdateReport_t;
+
+typedef struct
+{
+  uint32_t SuspendedReads;     /*!<  Reads served by suspending an erase              */
+  uint32_t DeferredReads;      /*!<  Reads served after waiting for the erase end     */
+  uint32_t MaxEraseSuspends;   /*!<  Highest number of suspends of a single erase     */
+  uint32_t MaxReadLatency;     /*!<  Longest read issued during an erase (ms)         */
+} BSP_XSPI_NOR_SuspendStats_t;
+
+typedef struct
+{
+  uint32_t Reads;              /*!<  Reads handled by the cache                       */
+  uint32_t Hits;               /*!<  Reads served without memory access               */
+  uint32_t HitRatio;           /*!<  Hits per 100 reads                               */
+  uint32_t LineFills;          /*!<  Read commands issued to fill a line              */
+  uint32_t StreamFills;        /*!<  Read commands issued to fill the read-ahead lines */
+  uint32_t BytesSaved;         /*!<  Bytes served from already cached lines           */
+} BSP_XSPI_NOR_CacheStats_t;
+
+typedef struct
+{
+  uint32_t Address;            /*!<  Memory address of the region                     */
+  uint8_t *pData;              /*!<  Destination buffer, 4 bytes aligned              */
+  uint32_t Size;               /*!<  Size of the region, multiple of 4 bytes          */
+} BSP_XSPI_NOR_DmaItem_t;
 /**
   * @}
   */
@@ -368,6 +447,19 @@ typedef struct
 /* XSPI block sizes */
 #define BSP_XSPI_NOR_BLOCK_4K             MX66UW1G45G_SUBSECTOR_4K
 #define BSP_XSPI_NOR_BLOCK_64K            MX66UW1G45G_SECTOR_64K
+
+#if (USE_BSP_XSPI_NOR_DMA == 1)
+/* DMA definitions for XSPI NOR DMA transfer */
+#define XSPI_NOR_DMAx_CLK_ENABLE          __HAL_RCC_HPDMA1_CLK_ENABLE
+#define XSPI_NOR_DMAx_CLK_DISABLE         __HAL_RCC_HPDMA1_CLK_DISABLE
+#define XSPI_NOR_DMAx_RX_CHANNEL          HPDMA1_Channel14
+#define XSPI_NOR_DMAx_RX_IRQn             HPDMA1_Channel14_IRQn
+#define XSPI_NOR_DMAx_RX_IRQHandler       HPDMA1_Channel14_IRQHandler
+#define XSPI_NOR_DMAx_TX_CHANNEL          HPDMA1_Channel13
+#define XSPI_NOR_DMAx_TX_IRQn             HPDMA1_Channel13_IRQn
+#define XSPI_NOR_DMAx_TX_IRQHandler       HPDMA1_Channel13_IRQHandler
+#define XSPI_NOR_DMAx_Request             HPDMA1_REQUEST_XSPI2
+#endif /* USE_BSP_XSPI_NOR_DMA */
 /**
   * @}
   */
@@ -446,8 +538,12 @@ int32_t BSP_XSPI_NOR_RegisterDefaultMspCallbacks(uint32_t Instance);
 #endif /* (USE_HAL_XSPI_REGISTER_CALLBACKS == 1) */
 int32_t BSP_XSPI_NOR_Read(uint32_t Instance, uint8_t *pData, uint32_t ReadAddr, uint32_t Size);
 int32_t BSP_XSPI_NOR_Write(uint32_t Instance, const uint8_t *pData, uint32_t WriteAddr, uint32_t Size);
+int32_t BSP_XSPI_NOR_Update(uint32_t Instance, const uint8_t *pData, uint32_t WriteAddr, uint32_t Size,
+                            BSP_XSPI_NOR_UpdateReport_t *pReport);
 int32_t BSP_XSPI_NOR_Erase_Block(uint32_t Instance, uint32_t BlockAddress, BSP_XSPI_NOR_Erase_t BlockSize);
 int32_t BSP_XSPI_NOR_Erase_Chip(uint32_t Instance);
+int32_t BSP_XSPI_NOR_EraseRange(uint32_t Instance, uint32_t Address, uint32_t Size, uint32_t SkipBlank,
+                                BSP_XSPI_NOR_EraseReport_t *pReport);
 int32_t BSP_XSPI_NOR_GetStatus(uint32_t Instance);
 int32_t BSP_XSPI_NOR_GetInfo(uint32_t Instance, BSP_XSPI_NOR_Info_t *pInfo);
 int32_t BSP_XSPI_NOR_EnableMemoryMappedMode(uint32_t Instance);
@@ -458,6 +554,38 @@ int32_t BSP_XSPI_NOR_SuspendErase(uint32_t Instance);
 int32_t BSP_XSPI_NOR_ResumeErase(uint32_t Instance);
 int32_t BSP_XSPI_NOR_EnterDeepPowerDown(uint32_t Instance);
 int32_t BSP_XSPI_NOR_LeaveDeepPowerDown(uint32_t Instance);
+int32_t BSP_XSPI_NOR_Write_IT(uint32_t Instance, const uint8_t *pData, uint32_t WriteAddr, uint32_t Size);
+int32_t BSP_XSPI_NOR_Erase_Block_IT(uint32_t Instance, uint32_t BlockAddress, BSP_XSPI_NOR_Erase_t BlockSize);
+void    BSP_XSPI_NOR_IRQHandler(uint32_t Instance);
+int32_t BSP_XSPI_NOR_GetSuspendStats(uint32_t Instance, BSP_XSPI_NOR_SuspendStats_t *pStats);
+#if (USE_BSP_XSPI_NOR_READ_CACHE == 1)
+int32_t BSP_XSPI_NOR_GetCacheStats(uint32_t Instance, BSP_XSPI_NOR_CacheStats_t *pStats);
+#endif /* USE_BSP_XSPI_NOR_READ_CACHE */
+#if (USE_BSP_XSPI_NOR_DMA == 1)
+int32_t BSP_XSPI_NOR_Read_DMA(uint32_t Instance, uint8_t *pData, uint32_t ReadAddr, uint32_t Size);
+int32_t BSP_XSPI_NOR_ReadList_DMA(uint32_t Instance, const BSP_XSPI_NOR_DmaItem_t *pItems, uint32_t NbItems);
+int32_t BSP_XSPI_NOR_Write_DMA(uint32_t Instance, const uint8_t *pData, uint32_t WriteAddr, uint32_t Size);
+void    BSP_XSPI_NOR_DMA_RX_IRQHandler(uint32_t Instance);
+void    BSP_XSPI_NOR_DMA_TX_IRQHandler(uint32_t Instance);
+#endif /* USE_BSP_XSPI_NOR_DMA */
+
+/* Callbacks of the interrupt driven operations */
+#if (USE_BSP_XSPI_NOR_DMA == 1)
+void    BSP_XSPI_NOR_ReadCpltCallback(uint32_t Instance);
+#endif /* USE_BSP_XSPI_NOR_DMA */
+void    BSP_XSPI_NOR_WriteCpltCallback(uint32_t Instance);
+void    BSP_XSPI_NOR_EraseCpltCallback(uint32_t Instance);
+void    BSP_XSPI_NOR_ErrorCallback(uint32_t Instance);
+#if (USE_HAL_XSPI_REGISTER_CALLBACKS == 0)
+/* To be called from the HAL XSPI callbacks of the application */
+void    BSP_XSPI_NOR_StatusMatchCallback(XSPI_HandleTypeDef *hxspi);
+void    BSP_XSPI_NOR_TransferErrorCallback(XSPI_HandleTypeDef *hxspi);
+void    BSP_XSPI_NOR_CmdCpltCallback(XSPI_HandleTypeDef *hxspi);
+void    BSP_XSPI_NOR_TxCpltCallback(XSPI_HandleTypeDef *hxspi);
+#if (USE_BSP_XSPI_NOR_DMA == 1)
+void    BSP_XSPI_NOR_RxCpltCallback(XSPI_HandleTypeDef *hxspi);
+#endif /* USE_BSP_XSPI_NOR_DMA */
+#endif /* (USE_HAL_XSPI_REGISTER_CALLBACKS == 0) */
 
 /**
   * @}
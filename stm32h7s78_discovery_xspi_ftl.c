@@ -0,0 +1,1190 @@
+/**
+  ******************************************************************************
+  * @file    stm32h7s78_discovery_xspi_ftl.c
+  * @author  MCD Application Team
+  * @brief   This file includes a log-structured key-value store on top of the
+  *          MX66UW1G45G XSPI NOR memory mounted on the STM32H7S78-DK board.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  @verbatim
+  ==============================================================================
+                     ##### How to use this driver #####
+  ==============================================================================
+  [..]
+   (#) This driver stores small values identified by a 32-bit key in an area of the
+       MX66UW1G45G NOR memory (BSP_XSPI_FTL_ADDRESS, BSP_XSPI_FTL_SIZE). The NOR memory
+       must be initialized with BSP_XSPI_NOR_Init() in indirect mode before use.
+
+   (#) Storage layout:
+       (++) The area is split in 4KB sectors used as a circular log. Each sector starts
+            with a 16-byte header holding its erase count and the sequence number given
+            when the sector was opened.
+       (++) A value is appended as a record: a 16-byte header (key, length, type, CRC-32)
+            followed by the value padded to 16 bytes. A delete appends a header only.
+            A record is never rewritten in place.
+       (++) The oldest sector (tail) is reclaimed by copying its live records to the
+            newest sector (head) and erasing it, so all sectors are erased in turn and
+            the static data moves around the area: the wear is levelled without any
+            per-sector bookkeeping.
+
+   (#) Operations:
+       (++) BSP_XSPI_FTL_Init() mounts the area: the sector headers are scanned to find
+            the tail and the head, then the record headers are replayed in log order to
+            rebuild the RAM index (a hash table of BSP_XSPI_FTL_MAX_KEYS entries). Only
+            the records of the head sector are CRC checked, a record torn by a reset is
+            marked as discarded in its header. An empty area is formatted on the fly. An optional
+            BSP_XSPI_FTL_Io_t table replaces the NOR accesses, for example by a file
+            backed memory model when running on a host.
+       (++) BSP_XSPI_FTL_Put(), BSP_XSPI_FTL_Get() and BSP_XSPI_FTL_Delete() access a
+            value with a single index lookup. BSP_XSPI_FTL_Get() checks the CRC-32 of
+            the value when it is read entirely. BSP_XSPI_FTL_Delete() frees the index
+            entry of the key.
+       (++) BSP_XSPI_FTL_Process() should be called from the application idle loop: it
+            reclaims one sector per call while less than BSP_XSPI_FTL_GC_FREE_SECTORS
+            sectors are free. BSP_XSPI_FTL_Put() reclaims sectors itself only when the
+            log is full.
+       (++) BSP_XSPI_FTL_GetStats() returns the number of keys, the live bytes, the free
+            sectors and the erase count spread of the area.
+
+  @endverbatim
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32h7s78_discovery_xspi_ftl.h"
+
+/** @addtogroup BSP
+  * @{
+  */
+
+/** @addtogroup STM32H7S78_DK
+  * @{
+  */
+
+/** @defgroup STM32H7S78_DK_XSPI_FTL XSPI_FTL
+  * @{
+  */
+
+/** @defgroup STM32H7S78_DK_XSPI_FTL_Private_Constants XSPI_FTL Private Constants
+  * @{
+  */
+#define XSPI_FTL_SECTOR_MAGIC          0x4C544653U
+#define XSPI_FTL_ERASED_WORD           0xFFFFFFFFU
+#define XSPI_FTL_HEADER_SIZE           16U
+#define XSPI_FTL_SECTOR_PAYLOAD        (BSP_XSPI_FTL_SECTOR_SIZE - XSPI_FTL_HEADER_SIZE)
+#define XSPI_FTL_CHUNK_SIZE            256U
+#define XSPI_FTL_ERASE_MAX_TIME        400U    /* 4KB sector erase max time (ms) */
+
+#define XSPI_FTL_RECORD_VALUE          0x5641U
+#define XSPI_FTL_RECORD_DELETE         0x4445U
+#define XSPI_FTL_RECORD_FREE           0xFFFFU
+#define XSPI_FTL_RECORD_VALID          0xFFFFFFFFU
+#define XSPI_FTL_RECORD_DISCARDED      0x00000000U
+
+#define XSPI_FTL_RECORD_SIZE(__LENGTH__) \
+  (((__LENGTH__) + (2U * XSPI_FTL_HEADER_SIZE) - 1U) & ~(XSPI_FTL_HEADER_SIZE - 1U))
+#define XSPI_FTL_SECTOR_ADDRESS(__SECTOR__) \
+  (BSP_XSPI_FTL_ADDRESS + ((__SECTOR__) * BSP_XSPI_FTL_SECTOR_SIZE))
+#define XSPI_FTL_INDEX_SLOT(__KEY__) \
+  ((((__KEY__) * 2654435761U) >> 16) & (BSP_XSPI_FTL_MAX_KEYS - 1U))
+
+#if ((BSP_XSPI_FTL_MAX_KEYS & (BSP_XSPI_FTL_MAX_KEYS - 1U)) != 0U)
+#error "BSP_XSPI_FTL_MAX_KEYS must be a power of 2"
+#endif /* BSP_XSPI_FTL_MAX_KEYS */
+
+#if (BSP_XSPI_FTL_SECTOR_NBR < 3U)
+#error "BSP_XSPI_FTL_SIZE must hold at least 3 sectors"
+#endif /* BSP_XSPI_FTL_SECTOR_NBR */
+/**
+  * @}
+  */
+
+/** @defgroup STM32H7S78_DK_XSPI_FTL_Private_Types XSPI_FTL Private Types
+  * @{
+  */
+typedef struct
+{
+  uint32_t EraseCount;          /* Programmed after the sector erase  */
+  uint32_t Magic;               /* Programmed when the sector is opened */
+  uint32_t Sequence;
+  uint32_t Reserved;
+} XSPI_FTL_SectorHdr_t;
+
+typedef struct
+{
+  uint32_t Key;
+  uint16_t Length;              /* Value length in bytes              */
+  uint16_t Type;                /* XSPI_FTL_RECORD_VALUE or _DELETE   */
+  uint32_t Crc;                 /* CRC-32 of Key, Length, Type, value */
+  uint32_t State;               /* Programmed when found torn at mount */
+} XSPI_FTL_RecordHdr_t;
+
+typedef struct
+{
+  uint32_t Key;
+  uint32_t Address;             /* Live record address                 */
+  uint32_t Size;                /* Live record size in flash           */
+} XSPI_FTL_Entry_t;
+
+typedef struct
+{
+  const BSP_XSPI_FTL_Io_t *pIo;
+  uint32_t IsInitialized;
+  uint32_t Tail;                /* Oldest sector of the log           */
+  uint32_t Head;                /* Sector receiving the records       */
+  uint32_t HeadOffset;          /* Next record offset in the head     */
+  uint32_t UsedSectors;         /* Sectors from the tail to the head  */
+  uint32_t Sequence;            /* Sequence number of the head        */
+  uint32_t LiveBytes;
+  uint32_t Keys;
+  XSPI_FTL_Entry_t Index[BSP_XSPI_FTL_MAX_KEYS];
+} XSPI_FTL_Ctx_t;
+/**
+  * @}
+  */
+
+/** @defgroup STM32H7S78_DK_XSPI_FTL_Private_Variables XSPI_FTL Private Variables
+  * @{
+  */
+static XSPI_FTL_Ctx_t Ftl_Ctx[XSPI_NOR_INSTANCES_NUMBER];
+static uint8_t Ftl_Buffer[XSPI_FTL_CHUNK_SIZE] __ALIGNED(4);
+
+/* CRC-32 (IEEE 802.3, reflected) half-byte table */
+static const uint32_t Ftl_Crc32Table[16] =
+{
+  0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU, 0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+  0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU, 0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU
+};
+/**
+  * @}
+  */
+
+/** @defgroup STM32H7S78_DK_XSPI_FTL_Private_FunctionPrototypes XSPI_FTL Private Functions Prototypes
+  * @{
+  */
+static int32_t XSPI_FTL_NorEraseSector(uint32_t Instance, uint32_t SectorAddress);
+static uint32_t XSPI_FTL_Crc32(uint32_t Crc, const uint8_t *pData, uint32_t Size);
+static int32_t XSPI_FTL_CheckRecord(uint32_t Instance, uint32_t Address, const XSPI_FTL_RecordHdr_t *pHdr);
+static XSPI_FTL_Entry_t *XSPI_FTL_IndexFind(XSPI_FTL_Ctx_t *pCtx, uint32_t Key);
+static void XSPI_FTL_IndexRemove(XSPI_FTL_Ctx_t *pCtx, XSPI_FTL_Entry_t *pEntry);
+static int32_t XSPI_FTL_IndexUpdate(XSPI_FTL_Ctx_t *pCtx, uint32_t Key, uint32_t Address, uint32_t Size);
+static int32_t XSPI_FTL_ScanSector(uint32_t Instance, uint32_t Sector, uint32_t CheckCrc);
+static int32_t XSPI_FTL_EraseSector(uint32_t Instance, uint32_t Sector);
+static int32_t XSPI_FTL_OpenSector(uint32_t Instance);
+static int32_t XSPI_FTL_Reserve(uint32_t Instance, uint32_t Size);
+static int32_t XSPI_FTL_MakeRoom(uint32_t Instance, uint32_t Size);
+static int32_t XSPI_FTL_Append(uint32_t Instance, const XSPI_FTL_RecordHdr_t *pHdr, const uint8_t *pData,
+                               uint32_t *pAddress);
+static int32_t XSPI_FTL_Copy(uint32_t Instance, uint32_t Address, uint32_t Size, uint32_t *pAddress);
+static int32_t XSPI_FTL_Reclaim(uint32_t Instance);
+/**
+  * @}
+  */
+
+/** @addtogroup STM32H7S78_DK_XSPI_FTL_Private_Variables
+  * @{
+  */
+static const BSP_XSPI_FTL_Io_t Ftl_NorIo =
+{
+  BSP_XSPI_NOR_Read,
+  BSP_XSPI_NOR_Write,
+  XSPI_FTL_NorEraseSector
+};
+/**
+  * @}
+  */
+
+/** @addtogroup STM32H7S78_DK_XSPI_FTL_Exported_Functions
+  * @{
+  */
+
+/**
+  * @brief  Mounts the FTL area and rebuilds the key index.
+  * @param  Instance  XSPI NOR instance
+  * @param  pIo       Memory access functions, NULL to use the XSPI NOR driver
+  * @retval BSP status
+  */
+int32_t BSP_XSPI_FTL_Init(uint32_t Instance, const BSP_XSPI_FTL_Io_t *pIo)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  XSPI_FTL_Ctx_t *ctx;
+  XSPI_FTL_SectorHdr_t header;
+  uint32_t min_sequence = XSPI_FTL_ERASED_WORD;
+  uint32_t max_sequence = 0U;
+  uint32_t sector;
+  uint32_t i;
+
+  /* Check if the instance is supported */
+  if (Instance >= XSPI_NOR_INSTANCES_NUMBER)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    ctx = &Ftl_Ctx[Instance];
+    ctx->pIo           = (pIo != NULL) ? pIo : &Ftl_NorIo;
+    ctx->IsInitialized = 0U;
+    ctx->Tail          = 0U;
+    ctx->Head          = 0U;
+    ctx->HeadOffset    = BSP_XSPI_FTL_SECTOR_SIZE;
+    ctx->UsedSectors   = 0U;
+    ctx->Sequence      = 0U;
+    ctx->LiveBytes     = 0U;
+    ctx->Keys          = 0U;
+    for (i = 0U; i < BSP_XSPI_FTL_MAX_KEYS; i++)
+    {
+      ctx->Index[i].Key     = BSP_XSPI_FTL_KEY_NONE;
+      ctx->Index[i].Address = 0U;
+      ctx->Index[i].Size    = 0U;
+    }
+
+    /* Find the oldest and the newest sectors of the log */
+    for (sector = 0U; (sector < BSP_XSPI_FTL_SECTOR_NBR) && (ret == BSP_ERROR_NONE); sector++)
+    {
+      ret = ctx->pIo->pRead(Instance, (uint8_t *)&header, XSPI_FTL_SECTOR_ADDRESS(sector), sizeof(header));
+      if ((ret == BSP_ERROR_NONE) && (header.Magic == XSPI_FTL_SECTOR_MAGIC) &&
+          (header.Sequence != XSPI_FTL_ERASED_WORD))
+      {
+        if (header.Sequence < min_sequence)
+        {
+          min_sequence = header.Sequence;
+          ctx->Tail    = sector;
+        }
+        if (header.Sequence >= max_sequence)
+        {
+          max_sequence = header.Sequence;
+          ctx->Head    = sector;
+        }
+      }
+    }
+
+    if (ret != BSP_ERROR_NONE)
+    {
+      /* Nothing to do, the access failed */
+    }/* Empty area, the first sector is opened by the first write */
+    else if (min_sequence == XSPI_FTL_ERASED_WORD)
+    {
+      ctx->IsInitialized = 1U;
+    }
+    else
+    {
+      ctx->Sequence    = max_sequence;
+      ctx->UsedSectors = ((ctx->Head + BSP_XSPI_FTL_SECTOR_NBR - ctx->Tail) % BSP_XSPI_FTL_SECTOR_NBR) + 1U;
+
+      /* Replay the records from the tail to the head */
+      for (i = 0U; (i < ctx->UsedSectors) && (ret == BSP_ERROR_NONE); i++)
+      {
+        sector = (ctx->Tail + i) % BSP_XSPI_FTL_SECTOR_NBR;
+        ret = XSPI_FTL_ScanSector(Instance, sector, (sector == ctx->Head) ? 1U : 0U);
+      }
+
+      if (ret == BSP_ERROR_NONE)
+      {
+        ctx->IsInitialized = 1U;
+      }
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  De-Initializes the FTL, the stored data is kept in the memory.
+  * @param  Instance  XSPI NOR instance
+  * @retval BSP status
+  */
+int32_t BSP_XSPI_FTL_DeInit(uint32_t Instance)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  /* Check if the instance is supported */
+  if (Instance >= XSPI_NOR_INSTANCES_NUMBER)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    Ftl_Ctx[Instance].IsInitialized = 0U;
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  Stores the value of a key, replacing the previous one.
+  * @param  Instance  XSPI NOR instance
+  * @param  Key       Value key, BSP_XSPI_FTL_KEY_NONE is reserved
+  * @param  pData     Pointer to the value
+  * @param  Size      Size of the value, up to BSP_XSPI_FTL_MAX_VALUE_SIZE
+  * @retval BSP status, BSP_ERROR_XSPI_FTL_FULL when the value does not fit
+  */
+int32_t BSP_XSPI_FTL_Put(uint32_t Instance, uint32_t Key, const uint8_t *pData, uint32_t Size)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  XSPI_FTL_Ctx_t *ctx;
+  XSPI_FTL_Entry_t *entry;
+  XSPI_FTL_RecordHdr_t header;
+  uint32_t size = XSPI_FTL_RECORD_SIZE(Size);
+  uint32_t live_bytes;
+  uint32_t address;
+
+  /* Check if the instance is supported */
+  if ((Instance >= XSPI_NOR_INSTANCES_NUMBER) || (Key == BSP_XSPI_FTL_KEY_NONE) ||
+      ((pData == NULL) && (Size != 0U)) || (Size > BSP_XSPI_FTL_MAX_VALUE_SIZE))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if (Ftl_Ctx[Instance].IsInitialized == 0U)
+  {
+    ret = BSP_ERROR_NO_INIT;
+  }
+  else
+  {
+    ctx   = &Ftl_Ctx[Instance];
+    entry = XSPI_FTL_IndexFind(ctx, Key);
+
+    if (entry == NULL)
+    {
+      ret = BSP_ERROR_XSPI_FTL_FULL;
+    }
+    else
+    {
+      /* The live data must fit with one sector in reserve for the reclaim */
+      live_bytes = ctx->LiveBytes + size;
+      if ((entry->Key == Key) && (entry->Address != 0U))
+      {
+        live_bytes -= entry->Size;
+      }
+
+      if (live_bytes > ((BSP_XSPI_FTL_SECTOR_NBR - 2U) * XSPI_FTL_SECTOR_PAYLOAD))
+      {
+        ret = BSP_ERROR_XSPI_FTL_FULL;
+      }
+      else
+      {
+        ret = XSPI_FTL_MakeRoom(Instance, size);
+      }
+
+      if (ret == BSP_ERROR_NONE)
+      {
+        header.Key      = Key;
+        header.Length   = (uint16_t)Size;
+        header.Type     = XSPI_FTL_RECORD_VALUE;
+        header.Crc      = ~XSPI_FTL_Crc32(XSPI_FTL_Crc32(XSPI_FTL_ERASED_WORD, (const uint8_t *)&header, 8U),
+                                          pData, Size);
+        header.State    = XSPI_FTL_RECORD_VALID;
+
+        ret = XSPI_FTL_Append(Instance, &header, pData, &address);
+        if (ret == BSP_ERROR_NONE)
+        {
+          ret = XSPI_FTL_IndexUpdate(ctx, Key, address, size);
+        }
+      }
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  Reads the value of a key.
+  * @param  Instance  XSPI NOR instance
+  * @param  Key       Value key
+  * @param  pData     Pointer to the value buffer
+  * @param  Size      Size of the buffer, the value is truncated when larger
+  * @param  pLength   Pointer to the value length, can be NULL
+  * @retval BSP status, BSP_ERROR_XSPI_FTL_NOT_FOUND when the key has no value
+  */
+int32_t BSP_XSPI_FTL_Get(uint32_t Instance, uint32_t Key, uint8_t *pData, uint32_t Size, uint32_t *pLength)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  XSPI_FTL_Entry_t *entry;
+  XSPI_FTL_RecordHdr_t header;
+  uint32_t size;
+
+  /* Check if the instance is supported */
+  if ((Instance >= XSPI_NOR_INSTANCES_NUMBER) || ((pData == NULL) && (Size != 0U)))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if (Ftl_Ctx[Instance].IsInitialized == 0U)
+  {
+    ret = BSP_ERROR_NO_INIT;
+  }
+  else
+  {
+    entry = XSPI_FTL_IndexFind(&Ftl_Ctx[Instance], Key);
+
+    if ((entry == NULL) || (entry->Key != Key) || (entry->Address == 0U))
+    {
+      ret = BSP_ERROR_XSPI_FTL_NOT_FOUND;
+    }
+    else if (Ftl_Ctx[Instance].pIo->pRead(Instance, (uint8_t *)&header, entry->Address,
+                                          sizeof(header)) != BSP_ERROR_NONE)
+    {
+      ret = BSP_ERROR_COMPONENT_FAILURE;
+    }
+    else
+    {
+      size = (Size < header.Length) ? Size : header.Length;
+      if (pLength != NULL)
+      {
+        *pLength = header.Length;
+      }
+
+      if ((size != 0U) && (Ftl_Ctx[Instance].pIo->pRead(Instance, pData, entry->Address + XSPI_FTL_HEADER_SIZE,
+                                                         size) != BSP_ERROR_NONE))
+      {
+        ret = BSP_ERROR_COMPONENT_FAILURE;
+      }/* The value is checked when it is read entirely */
+      else if ((size == header.Length) &&
+               (~XSPI_FTL_Crc32(XSPI_FTL_Crc32(XSPI_FTL_ERASED_WORD, (const uint8_t *)&header, 8U),
+                                pData, size) != header.Crc))
+      {
+        ret = BSP_ERROR_COMPONENT_FAILURE;
+      }
+      else
+      {
+        /* Nothing to do */
+      }
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  Deletes the value of a key.
+  * @param  Instance  XSPI NOR instance
+  * @param  Key       Value key
+  * @retval BSP status, BSP_ERROR_XSPI_FTL_NOT_FOUND when the key has no value
+  */
+int32_t BSP_XSPI_FTL_Delete(uint32_t Instance, uint32_t Key)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  XSPI_FTL_Ctx_t *ctx;
+  XSPI_FTL_Entry_t *entry;
+  XSPI_FTL_RecordHdr_t header;
+  uint32_t address;
+
+  /* Check if the instance is supported */
+  if (Instance >= XSPI_NOR_INSTANCES_NUMBER)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if (Ftl_Ctx[Instance].IsInitialized == 0U)
+  {
+    ret = BSP_ERROR_NO_INIT;
+  }
+  else
+  {
+    ctx   = &Ftl_Ctx[Instance];
+    entry = XSPI_FTL_IndexFind(ctx, Key);
+
+    if ((entry == NULL) || (entry->Key != Key) || (entry->Address == 0U))
+    {
+      ret = BSP_ERROR_XSPI_FTL_NOT_FOUND;
+    }
+    else
+    {
+      ret = XSPI_FTL_MakeRoom(Instance, XSPI_FTL_HEADER_SIZE);
+
+      if (ret == BSP_ERROR_NONE)
+      {
+        header.Key      = Key;
+        header.Length   = 0U;
+        header.Type     = XSPI_FTL_RECORD_DELETE;
+        header.Crc      = ~XSPI_FTL_Crc32(XSPI_FTL_ERASED_WORD, (const uint8_t *)&header, 8U);
+        header.State    = XSPI_FTL_RECORD_VALID;
+
+        ret = XSPI_FTL_Append(Instance, &header, NULL, &address);
+        if (ret == BSP_ERROR_NONE)
+        {
+          ret = XSPI_FTL_IndexUpdate(ctx, Key, 0U, 0U);
+        }
+      }
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  Background garbage collection, reclaims one sector per call while
+  *         less than BSP_XSPI_FTL_GC_FREE_SECTORS sectors are free.
+  * @param  Instance  XSPI NOR instance
+  * @retval BSP status
+  */
+int32_t BSP_XSPI_FTL_Process(uint32_t Instance)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  XSPI_FTL_Ctx_t *ctx;
+  uint32_t used_bytes;
+
+  /* Check if the instance is supported */
+  if (Instance >= XSPI_NOR_INSTANCES_NUMBER)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if (Ftl_Ctx[Instance].IsInitialized == 0U)
+  {
+    ret = BSP_ERROR_NO_INIT;
+  }
+  else
+  {
+    ctx = &Ftl_Ctx[Instance];
+
+    if ((ctx->UsedSectors > 1U) && ((BSP_XSPI_FTL_SECTOR_NBR - ctx->UsedSectors) < BSP_XSPI_FTL_GC_FREE_SECTORS))
+    {
+      /* Only reclaim when the log holds at least one sector of stale records,
+         otherwise the live data would just be moved around */
+      used_bytes = ((ctx->UsedSectors - 1U) * XSPI_FTL_SECTOR_PAYLOAD) + ctx->HeadOffset - XSPI_FTL_HEADER_SIZE;
+      if ((used_bytes - ctx->LiveBytes) >= XSPI_FTL_SECTOR_PAYLOAD)
+      {
+        ret = XSPI_FTL_Reclaim(Instance);
+      }
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  Gets the FTL usage and wear statistics.
+  * @param  Instance  XSPI NOR instance
+  * @param  pStats    Pointer to the statistics
+  * @retval BSP status
+  */
+int32_t BSP_XSPI_FTL_GetStats(uint32_t Instance, BSP_XSPI_FTL_Stats_t *pStats)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  XSPI_FTL_Ctx_t *ctx;
+  uint32_t erase_count;
+  uint32_t sector;
+
+  /* Check if the instance is supported */
+  if ((Instance >= XSPI_NOR_INSTANCES_NUMBER) || (pStats == NULL))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if (Ftl_Ctx[Instance].IsInitialized == 0U)
+  {
+    ret = BSP_ERROR_NO_INIT;
+  }
+  else
+  {
+    ctx = &Ftl_Ctx[Instance];
+    pStats->Keys          = ctx->Keys;
+    pStats->LiveBytes     = ctx->LiveBytes;
+    pStats->FreeSectors   = BSP_XSPI_FTL_SECTOR_NBR - ctx->UsedSectors;
+    pStats->MinEraseCount = XSPI_FTL_ERASED_WORD;
+    pStats->MaxEraseCount = 0U;
+
+    for (sector = 0U; (sector < BSP_XSPI_FTL_SECTOR_NBR) && (ret == BSP_ERROR_NONE); sector++)
+    {
+      ret = ctx->pIo->pRead(Instance, (uint8_t *)&erase_count, XSPI_FTL_SECTOR_ADDRESS(sector), 4U);
+      if (ret == BSP_ERROR_NONE)
+      {
+        /* Never erased by the FTL */
+        if (erase_count == XSPI_FTL_ERASED_WORD)
+        {
+          erase_count = 0U;
+        }
+        if (erase_count < pStats->MinEraseCount)
+        {
+          pStats->MinEraseCount = erase_count;
+        }
+        if (erase_count > pStats->MaxEraseCount)
+        {
+          pStats->MaxEraseCount = erase_count;
+        }
+      }
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @}
+  */
+
+/** @defgroup STM32H7S78_DK_XSPI_FTL_Private_Functions XSPI_FTL Private Functions
+  * @{
+  */
+
+/**
+  * @brief  Erases a 4KB sector of the XSPI NOR memory and waits for the end of the erase.
+  * @param  Instance       XSPI NOR instance
+  * @param  SectorAddress  Sector address
+  * @retval BSP status
+  */
+static int32_t XSPI_FTL_NorEraseSector(uint32_t Instance, uint32_t SectorAddress)
+{
+  int32_t ret;
+  uint32_t tickstart;
+
+  ret = BSP_XSPI_NOR_Erase_Block(Instance, SectorAddress, BSP_XSPI_NOR_ERASE_4K);
+  if (ret == BSP_ERROR_NONE)
+  {
+    /* BSP_ERROR_BUSY is returned when the erase does not end in time */
+    tickstart = HAL_GetTick();
+    do
+    {
+      ret = BSP_XSPI_NOR_GetStatus(Instance);
+    } while ((ret == BSP_ERROR_BUSY) && ((HAL_GetTick() - tickstart) <= XSPI_FTL_ERASE_MAX_TIME));
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  Updates a CRC-32 with a buffer.
+  * @param  Crc    Current CRC value
+  * @param  pData  Pointer to the data
+  * @param  Size   Size of the data
+  * @retval Updated CRC value
+  */
+static uint32_t XSPI_FTL_Crc32(uint32_t Crc, const uint8_t *pData, uint32_t Size)
+{
+  uint32_t crc = Crc;
+  uint32_t i;
+
+  for (i = 0U; i < Size; i++)
+  {
+    crc = Ftl_Crc32Table[(crc ^ pData[i]) & 0x0FU] ^ (crc >> 4);
+    crc = Ftl_Crc32Table[(crc ^ ((uint32_t)pData[i] >> 4)) & 0x0FU] ^ (crc >> 4);
+  }
+
+  return crc;
+}
+
+/**
+  * @brief  Checks the CRC-32 of a record stored in the memory.
+  * @param  Instance  XSPI NOR instance
+  * @param  Address   Record address
+  * @param  pHdr      Pointer to the record header
+  * @retval BSP status, BSP_ERROR_COMPONENT_FAILURE on mismatch
+  */
+static int32_t XSPI_FTL_CheckRecord(uint32_t Instance, uint32_t Address, const XSPI_FTL_RecordHdr_t *pHdr)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  uint32_t crc = XSPI_FTL_Crc32(XSPI_FTL_ERASED_WORD, (const uint8_t *)pHdr, 8U);
+  uint32_t offset;
+  uint32_t size;
+
+  for (offset = 0U; (offset < pHdr->Length) && (ret == BSP_ERROR_NONE); offset += size)
+  {
+    size = ((pHdr->Length - offset) < XSPI_FTL_CHUNK_SIZE) ? (pHdr->Length - offset) : XSPI_FTL_CHUNK_SIZE;
+    ret = Ftl_Ctx[Instance].pIo->pRead(Instance, Ftl_Buffer, Address + XSPI_FTL_HEADER_SIZE + offset, size);
+    if (ret == BSP_ERROR_NONE)
+    {
+      crc = XSPI_FTL_Crc32(crc, Ftl_Buffer, size);
+    }
+  }
+
+  if ((ret == BSP_ERROR_NONE) && (~crc != pHdr->Crc))
+  {
+    ret = BSP_ERROR_COMPONENT_FAILURE;
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  Finds the index entry of a key, or the free entry to insert it.
+  * @param  pCtx  Pointer to the FTL context
+  * @param  Key   Value key
+  * @retval Pointer to the entry, NULL when the index is full
+  */
+static XSPI_FTL_Entry_t *XSPI_FTL_IndexFind(XSPI_FTL_Ctx_t *pCtx, uint32_t Key)
+{
+  XSPI_FTL_Entry_t *entry = NULL;
+  uint32_t slot = XSPI_FTL_INDEX_SLOT(Key);
+  uint32_t i;
+
+  /* Open addressing with linear probing, the deleted keys are removed */
+  for (i = 0U; (i < BSP_XSPI_FTL_MAX_KEYS) && (entry == NULL); i++)
+  {
+    if ((pCtx->Index[slot].Key == Key) || (pCtx->Index[slot].Key == BSP_XSPI_FTL_KEY_NONE))
+    {
+      entry = &pCtx->Index[slot];
+    }
+    else
+    {
+      slot = (slot + 1U) & (BSP_XSPI_FTL_MAX_KEYS - 1U);
+    }
+  }
+
+  return entry;
+}
+
+/**
+  * @brief  Removes an entry from the index. The following entries of the probe
+  *         sequence are shifted back so that no deleted key holds an entry.
+  * @param  pCtx    Pointer to the FTL context
+  * @param  pEntry  Pointer to the entry
+  * @retval None
+  */
+static void XSPI_FTL_IndexRemove(XSPI_FTL_Ctx_t *pCtx, XSPI_FTL_Entry_t *pEntry)
+{
+  uint32_t hole = (uint32_t)(pEntry - pCtx->Index);
+  uint32_t slot = (hole + 1U) & (BSP_XSPI_FTL_MAX_KEYS - 1U);
+  uint32_t home;
+  uint32_t i;
+
+  for (i = 1U; (i < BSP_XSPI_FTL_MAX_KEYS) && (pCtx->Index[slot].Key != BSP_XSPI_FTL_KEY_NONE); i++)
+  {
+    /* An entry moves to the hole unless its home slot is between the hole and it */
+    home = XSPI_FTL_INDEX_SLOT(pCtx->Index[slot].Key);
+    if (((slot - home) & (BSP_XSPI_FTL_MAX_KEYS - 1U)) >= ((slot - hole) & (BSP_XSPI_FTL_MAX_KEYS - 1U)))
+    {
+      pCtx->Index[hole] = pCtx->Index[slot];
+      hole = slot;
+    }
+    slot = (slot + 1U) & (BSP_XSPI_FTL_MAX_KEYS - 1U);
+  }
+
+  pCtx->Index[hole].Key     = BSP_XSPI_FTL_KEY_NONE;
+  pCtx->Index[hole].Address = 0U;
+  pCtx->Index[hole].Size    = 0U;
+}
+
+/**
+  * @brief  Points the index entry of a key to its newest record.
+  * @param  pCtx     Pointer to the FTL context
+  * @param  Key      Value key
+  * @param  Address  Record address, 0 for a delete
+  * @param  Size     Record size in the memory
+  * @retval BSP status
+  */
+static int32_t XSPI_FTL_IndexUpdate(XSPI_FTL_Ctx_t *pCtx, uint32_t Key, uint32_t Address, uint32_t Size)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  XSPI_FTL_Entry_t *entry = XSPI_FTL_IndexFind(pCtx, Key);
+
+  if (entry == NULL)
+  {
+    ret = (Address != 0U) ? BSP_ERROR_XSPI_FTL_FULL : BSP_ERROR_NONE;
+  }/* A delete of an unknown key does not take an entry */
+  else if ((entry->Key != Key) && (Address == 0U))
+  {
+    /* Nothing to do */
+  }
+  else
+  {
+    if (entry->Key == Key)
+    {
+      pCtx->LiveBytes -= entry->Size;
+      pCtx->Keys--;
+    }
+
+    if (Address == 0U)
+    {
+      XSPI_FTL_IndexRemove(pCtx, entry);
+    }
+    else
+    {
+      entry->Key     = Key;
+      entry->Address = Address;
+      entry->Size    = Size;
+      pCtx->LiveBytes += Size;
+      pCtx->Keys++;
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  Replays the records of a sector in the index.
+  * @param  Instance  XSPI NOR instance
+  * @param  Sector    Sector index
+  * @param  CheckCrc  1 to skip the records with a wrong CRC-32 (head sector)
+  * @retval BSP status
+  */
+static int32_t XSPI_FTL_ScanSector(uint32_t Instance, uint32_t Sector, uint32_t CheckCrc)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  XSPI_FTL_Ctx_t *ctx = &Ftl_Ctx[Instance];
+  XSPI_FTL_RecordHdr_t header;
+  uint32_t offset = XSPI_FTL_HEADER_SIZE;
+  uint32_t free_offset = BSP_XSPI_FTL_SECTOR_SIZE;
+  uint32_t address;
+  uint32_t size;
+
+  while ((offset < BSP_XSPI_FTL_SECTOR_SIZE) && (ret == BSP_ERROR_NONE))
+  {
+    address = XSPI_FTL_SECTOR_ADDRESS(Sector) + offset;
+    ret = ctx->pIo->pRead(Instance, (uint8_t *)&header, address, sizeof(header));
+    size = XSPI_FTL_RECORD_SIZE((uint32_t)header.Length);
+
+    if (ret != BSP_ERROR_NONE)
+    {
+      /* Nothing to do, the access failed */
+    }/* End of the records */
+    else if ((header.Key == BSP_XSPI_FTL_KEY_NONE) && (header.Type == XSPI_FTL_RECORD_FREE))
+    {
+      free_offset = offset;
+      offset      = BSP_XSPI_FTL_SECTOR_SIZE;
+    }/* Torn header, the rest of the sector can not be used anymore */
+    else if (((header.Type != XSPI_FTL_RECORD_VALUE) && (header.Type != XSPI_FTL_RECORD_DELETE)) ||
+             ((offset + size) > BSP_XSPI_FTL_SECTOR_SIZE))
+    {
+      offset = BSP_XSPI_FTL_SECTOR_SIZE;
+    }
+    else
+    {
+      if (header.State != XSPI_FTL_RECORD_VALID)
+      {
+        /* Nothing to do, the record was discarded */
+      }
+      else if ((CheckCrc == 0U) || (XSPI_FTL_CheckRecord(Instance, address, &header) == BSP_ERROR_NONE))
+      {
+        ret = XSPI_FTL_IndexUpdate(ctx, header.Key, (header.Type == XSPI_FTL_RECORD_VALUE) ? address : 0U,
+                                   (header.Type == XSPI_FTL_RECORD_VALUE) ? size : 0U);
+      }
+      else
+      {
+        /* Torn record, discarded so that it is not replayed once the head moves on */
+        header.State = XSPI_FTL_RECORD_DISCARDED;
+        ret = ctx->pIo->pWrite(Instance, (const uint8_t *)&header.State, address + 12U, 4U);
+      }
+      offset += size;
+    }
+  }
+
+  if (Sector == ctx->Head)
+  {
+    ctx->HeadOffset = free_offset;
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  Erases a sector and programs its new erase count.
+  * @param  Instance  XSPI NOR instance
+  * @param  Sector    Sector index
+  * @retval BSP status
+  */
+static int32_t XSPI_FTL_EraseSector(uint32_t Instance, uint32_t Sector)
+{
+  int32_t ret;
+  const BSP_XSPI_FTL_Io_t *io = Ftl_Ctx[Instance].pIo;
+  uint32_t erase_count;
+
+  ret = io->pRead(Instance, (uint8_t *)&erase_count, XSPI_FTL_SECTOR_ADDRESS(Sector), 4U);
+  if (ret == BSP_ERROR_NONE)
+  {
+    erase_count = (erase_count == XSPI_FTL_ERASED_WORD) ? 1U : (erase_count + 1U);
+    ret = io->pEraseSector(Instance, XSPI_FTL_SECTOR_ADDRESS(Sector));
+  }
+
+  if (ret == BSP_ERROR_NONE)
+  {
+    ret = io->pWrite(Instance, (const uint8_t *)&erase_count, XSPI_FTL_SECTOR_ADDRESS(Sector), 4U);
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  Opens the sector following the head to receive the records.
+  * @param  Instance  XSPI NOR instance
+  * @retval BSP status
+  */
+static int32_t XSPI_FTL_OpenSector(uint32_t Instance)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  XSPI_FTL_Ctx_t *ctx = &Ftl_Ctx[Instance];
+  XSPI_FTL_SectorHdr_t header;
+  uint32_t sector = (ctx->UsedSectors == 0U) ? ctx->Head : ((ctx->Head + 1U) % BSP_XSPI_FTL_SECTOR_NBR);
+
+  if (ctx->UsedSectors >= BSP_XSPI_FTL_SECTOR_NBR)
+  {
+    ret = BSP_ERROR_XSPI_FTL_FULL;
+  }
+  else
+  {
+    ret = ctx->pIo->pRead(Instance, (uint8_t *)&header, XSPI_FTL_SECTOR_ADDRESS(sector), sizeof(header));
+
+    /* Only a sector erased by the FTL is known to be blank */
+    if ((ret == BSP_ERROR_NONE) && ((header.EraseCount == XSPI_FTL_ERASED_WORD) ||
+                                    (header.Magic != XSPI_FTL_ERASED_WORD) ||
+                                    (header.Sequence != XSPI_FTL_ERASED_WORD) ||
+                                    (header.Reserved != XSPI_FTL_ERASED_WORD)))
+    {
+      ret = XSPI_FTL_EraseSector(Instance, sector);
+    }
+
+    if (ret == BSP_ERROR_NONE)
+    {
+      header.Magic    = XSPI_FTL_SECTOR_MAGIC;
+      header.Sequence = ctx->Sequence + 1U;
+      ret = ctx->pIo->pWrite(Instance, (const uint8_t *)&header.Magic, XSPI_FTL_SECTOR_ADDRESS(sector) + 4U, 8U);
+    }
+
+    if (ret == BSP_ERROR_NONE)
+    {
+      if (ctx->UsedSectors == 0U)
+      {
+        ctx->Tail = sector;
+      }
+      ctx->Head       = sector;
+      ctx->HeadOffset = XSPI_FTL_HEADER_SIZE;
+      ctx->Sequence++;
+      ctx->UsedSectors++;
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  Makes room for a record in the head sector, without reclaiming.
+  * @param  Instance  XSPI NOR instance
+  * @param  Size      Record size in the memory
+  * @retval BSP status
+  */
+static int32_t XSPI_FTL_Reserve(uint32_t Instance, uint32_t Size)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  if ((Ftl_Ctx[Instance].HeadOffset + Size) > BSP_XSPI_FTL_SECTOR_SIZE)
+  {
+    ret = XSPI_FTL_OpenSector(Instance);
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  Makes room for a new record in the head sector. The tail is reclaimed
+  *         while opening a sector would use the one kept for the reclaim.
+  * @param  Instance  XSPI NOR instance
+  * @param  Size      Record size in the memory
+  * @retval BSP status, BSP_ERROR_XSPI_FTL_FULL when no sector can be freed
+  */
+static int32_t XSPI_FTL_MakeRoom(uint32_t Instance, uint32_t Size)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  XSPI_FTL_Ctx_t *ctx = &Ftl_Ctx[Instance];
+  uint32_t count;
+
+  if ((ctx->HeadOffset + Size) > BSP_XSPI_FTL_SECTOR_SIZE)
+  {
+    for (count = 0U; (count < BSP_XSPI_FTL_SECTOR_NBR) && (ret == BSP_ERROR_NONE) &&
+         ((BSP_XSPI_FTL_SECTOR_NBR - ctx->UsedSectors) < 2U); count++)
+    {
+      ret = XSPI_FTL_Reclaim(Instance);
+    }
+
+    if ((ret == BSP_ERROR_NONE) && ((BSP_XSPI_FTL_SECTOR_NBR - ctx->UsedSectors) < 2U))
+    {
+      ret = BSP_ERROR_XSPI_FTL_FULL;
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  Appends a record to the head sector.
+  * @param  Instance  XSPI NOR instance
+  * @param  pHdr      Pointer to the record header
+  * @param  pData     Pointer to the value
+  * @param  pAddress  Pointer to the record address
+  * @retval BSP status
+  */
+static int32_t XSPI_FTL_Append(uint32_t Instance, const XSPI_FTL_RecordHdr_t *pHdr, const uint8_t *pData,
+                               uint32_t *pAddress)
+{
+  int32_t ret;
+  XSPI_FTL_Ctx_t *ctx = &Ftl_Ctx[Instance];
+  uint32_t aligned = (uint32_t)pHdr->Length & ~(XSPI_FTL_HEADER_SIZE - 1U);
+  uint32_t address;
+  uint32_t i;
+
+  ret = XSPI_FTL_Reserve(Instance, XSPI_FTL_RECORD_SIZE((uint32_t)pHdr->Length));
+
+  if (ret == BSP_ERROR_NONE)
+  {
+    /* The space is consumed even if the programming fails */
+    address          = XSPI_FTL_SECTOR_ADDRESS(ctx->Head) + ctx->HeadOffset;
+    ctx->HeadOffset += XSPI_FTL_RECORD_SIZE((uint32_t)pHdr->Length);
+    *pAddress        = address;
+
+    /* The header first, a record torn after it fails its CRC check */
+    ret = ctx->pIo->pWrite(Instance, (const uint8_t *)pHdr, address, sizeof(XSPI_FTL_RecordHdr_t));
+    address += XSPI_FTL_HEADER_SIZE;
+
+    if ((ret == BSP_ERROR_NONE) && (aligned != 0U))
+    {
+      ret = ctx->pIo->pWrite(Instance, pData, address, aligned);
+      address += aligned;
+    }
+
+    /* Last bytes padded with the erased value */
+    if ((ret == BSP_ERROR_NONE) && (aligned != pHdr->Length))
+    {
+      for (i = 0U; i < XSPI_FTL_HEADER_SIZE; i++)
+      {
+        Ftl_Buffer[i] = ((aligned + i) < pHdr->Length) ? pData[aligned + i] : 0xFFU;
+      }
+      ret = ctx->pIo->pWrite(Instance, Ftl_Buffer, address, XSPI_FTL_HEADER_SIZE);
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  Copies a record to the head sector.
+  * @param  Instance  XSPI NOR instance
+  * @param  Address   Record address
+  * @param  Size      Record size in the memory
+  * @param  pAddress  Pointer to the new record address
+  * @retval BSP status
+  */
+static int32_t XSPI_FTL_Copy(uint32_t Instance, uint32_t Address, uint32_t Size, uint32_t *pAddress)
+{
+  int32_t ret;
+  XSPI_FTL_Ctx_t *ctx = &Ftl_Ctx[Instance];
+  uint32_t address;
+  uint32_t offset;
+  uint32_t size;
+
+  ret = XSPI_FTL_Reserve(Instance, Size);
+
+  if (ret == BSP_ERROR_NONE)
+  {
+    address          = XSPI_FTL_SECTOR_ADDRESS(ctx->Head) + ctx->HeadOffset;
+    ctx->HeadOffset += Size;
+    *pAddress        = address;
+
+    for (offset = 0U; (offset < Size) && (ret == BSP_ERROR_NONE); offset += size)
+    {
+      size = ((Size - offset) < XSPI_FTL_CHUNK_SIZE) ? (Size - offset) : XSPI_FTL_CHUNK_SIZE;
+      ret = ctx->pIo->pRead(Instance, Ftl_Buffer, Address + offset, size);
+      if (ret == BSP_ERROR_NONE)
+      {
+        ret = ctx->pIo->pWrite(Instance, Ftl_Buffer, address + offset, size);
+      }
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  Reclaims the tail sector: its live records are copied to the head
+  *         and the sector is erased.
+  * @param  Instance  XSPI NOR instance
+  * @retval BSP status
+  */
+static int32_t XSPI_FTL_Reclaim(uint32_t Instance)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  XSPI_FTL_Ctx_t *ctx = &Ftl_Ctx[Instance];
+  XSPI_FTL_RecordHdr_t header;
+  XSPI_FTL_Entry_t *entry;
+  uint32_t offset = XSPI_FTL_HEADER_SIZE;
+  uint32_t address;
+  uint32_t new_address;
+  uint32_t size;
+
+  /* The head sector is never reclaimed */
+  if (ctx->UsedSectors < 2U)
+  {
+    offset = BSP_XSPI_FTL_SECTOR_SIZE;
+  }
+
+  while ((offset < BSP_XSPI_FTL_SECTOR_SIZE) && (ret == BSP_ERROR_NONE))
+  {
+    address = XSPI_FTL_SECTOR_ADDRESS(ctx->Tail) + offset;
+    ret = ctx->pIo->pRead(Instance, (uint8_t *)&header, address, sizeof(header));
+    size = XSPI_FTL_RECORD_SIZE((uint32_t)header.Length);
+
+    if (ret != BSP_ERROR_NONE)
+    {
+      /* Nothing to do, the access failed */
+    }/* End of the records or torn header */
+    else if (((header.Type != XSPI_FTL_RECORD_VALUE) && (header.Type != XSPI_FTL_RECORD_DELETE)) ||
+             ((offset + size) > BSP_XSPI_FTL_SECTOR_SIZE))
+    {
+      offset = BSP_XSPI_FTL_SECTOR_SIZE;
+    }
+    else
+    {
+      /* Only the records the index points to are live */
+      entry = XSPI_FTL_IndexFind(ctx, header.Key);
+      if ((entry != NULL) && (entry->Key == header.Key) && (entry->Address == address))
+      {
+        ret = XSPI_FTL_Copy(Instance, address, size, &new_address);
+
+        /* The index keeps the old record until the copy is complete */
+        if (ret == BSP_ERROR_NONE)
+        {
+          entry->Address = new_address;
+        }
+      }
+      offset += size;
+    }
+  }
+
+  if ((ret == BSP_ERROR_NONE) && (ctx->UsedSectors >= 2U))
+  {
+    ret = XSPI_FTL_EraseSector(Instance, ctx->Tail);
+    if (ret == BSP_ERROR_NONE)
+    {
+      ctx->Tail = (ctx->Tail + 1U) % BSP_XSPI_FTL_SECTOR_NBR;
+      ctx->UsedSectors--;
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,130 @@
+/**
+  ******************************************************************************
+  * @file    stm32h7s78_discovery_xspi_ftl.h
+  * @author  MCD Application Team
+  * @brief   This file contains the common defines and functions prototypes for
+  *          the stm32h7s78_discovery_xspi_ftl.c driver.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STM32H7S78_DISCOVERY_XSPI_FTL_H
+#define STM32H7S78_DISCOVERY_XSPI_FTL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32h7s78_discovery_xspi.h"
+
+/** @addtogroup BSP
+  * @{
+  */
+
+/** @addtogroup STM32H7S78_DK
+  * @{
+  */
+
+/** @addtogroup STM32H7S78_DK_XSPI_FTL
+  * @{
+  */
+
+/** @defgroup STM32H7S78_DK_XSPI_FTL_Exported_Constants XSPI_FTL Exported Constants
+  * @{
+  */
+/* Area of the NOR memory used by the FTL, 4KB sector aligned */
+#ifndef BSP_XSPI_FTL_ADDRESS
+#define BSP_XSPI_FTL_ADDRESS              0x07F00000U
+#endif /* BSP_XSPI_FTL_ADDRESS */
+
+#ifndef BSP_XSPI_FTL_SIZE
+#define BSP_XSPI_FTL_SIZE                 0x00100000U
+#endif /* BSP_XSPI_FTL_SIZE */
+
+/* Keys held by the RAM index, power of 2 */
+#ifndef BSP_XSPI_FTL_MAX_KEYS
+#define BSP_XSPI_FTL_MAX_KEYS             256U
+#endif /* BSP_XSPI_FTL_MAX_KEYS */
+
+/* BSP_XSPI_FTL_Process() reclaims a sector while less sectors are free */
+#ifndef BSP_XSPI_FTL_GC_FREE_SECTORS
+#define BSP_XSPI_FTL_GC_FREE_SECTORS      4U
+#endif /* BSP_XSPI_FTL_GC_FREE_SECTORS */
+
+#define BSP_XSPI_FTL_SECTOR_SIZE          0x1000U
+#define BSP_XSPI_FTL_SECTOR_NBR           (BSP_XSPI_FTL_SIZE / BSP_XSPI_FTL_SECTOR_SIZE)
+
+/* Largest value, a record and the sector header must fit in a sector */
+#define BSP_XSPI_FTL_MAX_VALUE_SIZE       (BSP_XSPI_FTL_SECTOR_SIZE - 32U)
+
+/* Reserved key value */
+#define BSP_XSPI_FTL_KEY_NONE             0xFFFFFFFFU
+/**
+  * @}
+  */
+
+/** @defgroup STM32H7S78_DK_XSPI_FTL_Exported_Types XSPI_FTL Exported Types
+  * @{
+  */
+/* Memory access functions, the erase must be completed on return */
+typedef struct
+{
+  int32_t (*pRead)(uint32_t Instance, uint8_t *pData, uint32_t ReadAddr, uint32_t Size);
+  int32_t (*pWrite)(uint32_t Instance, const uint8_t *pData, uint32_t WriteAddr, uint32_t Size);
+  int32_t (*pEraseSector)(uint32_t Instance, uint32_t SectorAddress);
+} BSP_XSPI_FTL_Io_t;
+
+typedef struct
+{
+  uint32_t Keys;                /*!<  Keys holding a value                  */
+  uint32_t LiveBytes;           /*!<  Flash bytes of the live records       */
+  uint32_t FreeSectors;         /*!<  Erased sectors ready for the log      */
+  uint32_t MinEraseCount;       /*!<  Least erased sector                   */
+  uint32_t MaxEraseCount;       /*!<  Most erased sector                    */
+} BSP_XSPI_FTL_Stats_t;
+/**
+  * @}
+  */
+
+/** @defgroup STM32H7S78_DK_XSPI_FTL_Exported_Functions XSPI_FTL Exported Functions
+  * @{
+  */
+int32_t BSP_XSPI_FTL_Init(uint32_t Instance, const BSP_XSPI_FTL_Io_t *pIo);
+int32_t BSP_XSPI_FTL_DeInit(uint32_t Instance);
+int32_t BSP_XSPI_FTL_Put(uint32_t Instance, uint32_t Key, const uint8_t *pData, uint32_t Size);
+int32_t BSP_XSPI_FTL_Get(uint32_t Instance, uint32_t Key, uint8_t *pData, uint32_t Size, uint32_t *pLength);
+int32_t BSP_XSPI_FTL_Delete(uint32_t Instance, uint32_t Key);
+int32_t BSP_XSPI_FTL_Process(uint32_t Instance);
+int32_t BSP_XSPI_FTL_GetStats(uint32_t Instance, BSP_XSPI_FTL_Stats_t *pStats);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32H7S78_DISCOVERY_XSPI_FTL_H */